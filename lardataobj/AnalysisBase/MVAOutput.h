@@ -69,9 +69,9 @@ public:
 
     float operator[] (size_t index) const { return fData[index]; }
 
-    /// Access the contained array.
-    /// *** WOULD LIKE TO CHANGE TYPE OF DATA MEMBER TO std::array AND THEN ENABLE THIS FUNCTION ***
-    //const std::array<float, N> & data() const { return fData; }
+    /// Pointer to the N contiguous values (see MVAOutputBatch.h for kernels on collections).
+    const float * data() const { return fData; }
+    float * data() { return fData; }
 
 private:
 
@@ -161,6 +161,23 @@ public:
         return -1; // not found
     }
 
+    /// Index of the named output, to be resolved once and then used in loops; throws if the name is not found.
+    size_t requireIndex(const std::string & name) const
+    {
+        int const index = getIndex(name);
+        if (index >= 0) { return index; }
+        else { throw cet::exception("MVADescription") << "Output name not found: " << name << std::endl; }
+    }
+
+    /// Indices of the named outputs, in the same order; throws if any of the names is not found.
+    std::vector<size_t> requireIndices(std::vector< std::string > const & names) const
+    {
+        std::vector<size_t> indices;
+        indices.reserve(names.size());
+        for (auto const & name : names) { indices.push_back(requireIndex(name)); }
+        return indices;
+    }
+
 }; // class MVADescription
 
 template <size_t N>
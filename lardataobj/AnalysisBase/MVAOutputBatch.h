@@ -0,0 +1,187 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// \version
+//
+// \brief Batch operations on collections of feature vectors: construction from tensors, argmax, softmax,
+//        weighted sums and selection.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+#ifndef ANAB_MVAOUTPUTBATCH_H
+#define ANAB_MVAOUTPUTBATCH_H
+
+#include "lardataobj/AnalysisBase/MVAOutput.h"
+
+#include "cetlib_except/exception.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+namespace anab {
+
+/// The functions below work on std::vector< FeatureVector<N> >, reading the N contiguous values of each object
+/// through FeatureVector::data(). The inner loops have the fixed length N, so that the compiler can unroll and
+/// vectorize them. Output columns are referred to by index: resolve names once with
+/// MVADescription::requireIndex().
+
+/// Index of the largest value of each vector (the first one in case of ties).
+template <size_t N>
+std::vector<size_t> argmax(std::vector< FeatureVector<N> > const & vectors)
+{
+    std::vector<size_t> result(vectors.size());
+    for (size_t i = 0; i < vectors.size(); ++i)
+    {
+        float const * v = vectors[i].data();
+        size_t best = 0;
+        for (size_t j = 1; j < N; ++j) { if (v[j] > v[best]) { best = j; } }
+        result[i] = best;
+    }
+    return result;
+}
+
+/// Softmax of each vector: exp(v[j]) / sum_k exp(v[k]), computed after subtracting the largest value.
+template <size_t N>
+std::vector< FeatureVector<N> > softmax(std::vector< FeatureVector<N> > const & vectors)
+{
+    std::vector< FeatureVector<N> > result;
+    result.reserve(vectors.size());
+    float out[N];
+    for (auto const & vector : vectors)
+    {
+        float const * v = vector.data();
+        float vmax = v[0];
+        for (size_t j = 1; j < N; ++j) { vmax = std::max(vmax, v[j]); }
+        float sum = 0;
+        for (size_t j = 0; j < N; ++j) { out[j] = std::exp(v[j] - vmax); sum += out[j]; }
+        float const norm = 1.0f / sum;
+        for (size_t j = 0; j < N; ++j) { out[j] *= norm; }
+        result.emplace_back(out);
+    }
+    return result;
+}
+
+/// Each vector divided by the sum of its values; vectors with null sum are left unchanged.
+template <size_t N>
+std::vector< FeatureVector<N> > normalize(std::vector< FeatureVector<N> > const & vectors)
+{
+    std::vector< FeatureVector<N> > result;
+    result.reserve(vectors.size());
+    float out[N];
+    for (auto const & vector : vectors)
+    {
+        float const * v = vector.data();
+        float sum = 0;
+        for (size_t j = 0; j < N; ++j) { sum += v[j]; }
+        float const norm = (sum != 0) ? 1.0f / sum : 1.0f;
+        for (size_t j = 0; j < N; ++j) { out[j] = v[j] * norm; }
+        result.emplace_back(out);
+    }
+    return result;
+}
+
+/// Weighted sum of the vectors at the given positions (e.g. the hits of a cluster, weighted by their charge).
+template <size_t N>
+std::array<float, N> weightedSum(std::vector< FeatureVector<N> > const & vectors,
+    std::vector<size_t> const & indices, std::vector<float> const & weights)
+{
+    if (indices.size() != weights.size())
+    {
+        throw cet::exception("FeatureVector") << "Indices and weights differ in size: "
+            << indices.size() << " vs. " << weights.size() << std::endl;
+    }
+    std::array<float, N> sum;
+    sum.fill(0);
+    for (size_t i = 0; i < indices.size(); ++i)
+    {
+        float const * v = vectors[indices[i]].data();
+        float const w = weights[i];
+        for (size_t j = 0; j < N; ++j) { sum[j] += w * v[j]; }
+    }
+    return sum;
+}
+
+/// Weighted sums of many groups of vectors. Group g is made of the positions indices[k] with k in
+/// [offsets[g], offsets[g+1]), each with weight weights[k] (offsets has one more entry than the groups).
+template <size_t N>
+std::vector< std::array<float, N> > weightedSums(std::vector< FeatureVector<N> > const & vectors,
+    std::vector<size_t> const & offsets, std::vector<size_t> const & indices, std::vector<float> const & weights)
+{
+    if ((indices.size() != weights.size()) || offsets.empty() || (offsets.back() != indices.size()))
+    {
+        throw cet::exception("FeatureVector") << "Inconsistent groups: " << offsets.size() << " offsets, "
+            << indices.size() << " indices, " << weights.size() << " weights" << std::endl;
+    }
+    std::vector< std::array<float, N> > sums(offsets.size() - 1);
+    for (size_t g = 0; g < sums.size(); ++g)
+    {
+        std::array<float, N> & sum = sums[g];
+        sum.fill(0);
+        for (size_t k = offsets[g]; k < offsets[g + 1]; ++k)
+        {
+            float const * v = vectors[indices[k]].data();
+            float const w = weights[k];
+            for (size_t j = 0; j < N; ++j) { sum[j] += w * v[j]; }
+        }
+    }
+    return sums;
+}
+
+/// Positions of the vectors with value at the given index not smaller than the threshold.
+template <size_t N>
+std::vector<size_t> selectAbove(std::vector< FeatureVector<N> > const & vectors, size_t index, float threshold)
+{
+    if (index >= N) { throw cet::exception("FeatureVector") << "Index out of range: " << index << std::endl; }
+    std::vector<size_t> selected;
+    for (size_t i = 0; i < vectors.size(); ++i)
+    {
+        if (vectors[i].data()[index] >= threshold) { selected.push_back(i); }
+    }
+    return selected;
+}
+
+/// Appends `count` feature vectors read from a buffer (e.g. the output tensor of a model for a batch of inputs):
+/// the N values of vector i start at data[i * stride]. With float values and stride N (a packed tensor) the whole
+/// buffer is copied with a single memcpy; other types (e.g. double) are converted in a loop over contiguous values.
+template <size_t N, typename T>
+void appendFeatureVectors(std::vector< FeatureVector<N> > & vectors, T const * data, size_t count, size_t stride = N)
+{
+    static_assert(std::is_arithmetic<T>::value, "Feature vectors can be built only from numbers");
+    static_assert(std::is_trivially_copyable< FeatureVector<N> >::value && (sizeof(FeatureVector<N>) == N * sizeof(float)),
+        "FeatureVector<N> is expected to be N packed floats");
+    if (stride < N) { throw cet::exception("FeatureVector") << "Stride " << stride << " smaller than size " << N << std::endl; }
+
+    size_t const first = vectors.size();
+    vectors.resize(first + count); // default constructor leaves the values uninitialized
+    if (count == 0) { return; }
+    FeatureVector<N> * dest = vectors.data() + first;
+
+    if constexpr (std::is_same<T, float>::value)
+    {
+        if (stride == N) { std::memcpy(static_cast<void *>(dest), data, count * N * sizeof(float)); }
+        else { for (size_t i = 0; i < count; ++i) { std::memcpy(dest[i].data(), data + i * stride, N * sizeof(float)); } }
+    }
+    else
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            float * out = dest[i].data();
+            T const * in = data + i * stride;
+            for (size_t j = 0; j < N; ++j) { out[j] = static_cast<float>(in[j]); }
+        }
+    }
+}
+
+/// Creates `count` feature vectors from a buffer, as in appendFeatureVectors().
+template <size_t N, typename T>
+std::vector< FeatureVector<N> > makeFeatureVectors(T const * data, size_t count, size_t stride = N)
+{
+    std::vector< FeatureVector<N> > vectors;
+    appendFeatureVectors(vectors, data, count, stride);
+    return vectors;
+}
+
+} // namespace anab
+
+#endif //ANAB_MVAOUTPUTBATCH_H
@@ -4,6 +4,9 @@
 
 // C++ includes
 #include <vector>
+#include <algorithm>
+#include <utility>
+#include <cassert>
 #include "lardataobj/MCBase/MCHit.h"
 
 namespace sim {
@@ -39,16 +42,49 @@ namespace sim {
     /// For sorting
     inline bool operator< ( const MCHitCollection& rhs ) const { return fChannel < rhs.fChannel; }
 
-    /// wrapper for push_back
+    /// wrapper for push_back: keeps the hits sorted by time
     inline void push_back(const MCHit& hit)
     {
 
-      bool sort = (!empty() && hit < (*rbegin()));
+      if(empty() || !(hit < (*rbegin()))) {
+	std::vector<sim::MCHit>::push_back(hit);
+	return;
+      }
 
-      std::vector<sim::MCHit>::push_back(hit);
+      // insert after all the hits not later than this one
+      insert(std::upper_bound(begin(),end(),hit),hit);
 
-      if(sort) std::sort(begin(),end());
+    }
 
+    /**
+     * @brief Appends a hit without sorting (bulk filling).
+     *
+     * After all hits are added with this method, `finalize()` must be called
+     * to sort them, before any other method which needs sorted hits.
+     */
+    inline void append(const MCHit& hit)
+    { std::vector<sim::MCHit>::push_back(hit); }
+
+    /// Sorts the hits by time, after bulk filling with `append()`.
+    inline void finalize()
+    {
+      if(!std::is_sorted(begin(),end())) std::stable_sort(begin(),end());
+    }
+
+    /**
+     * @brief Returns the hits with peak time in the specified interval.
+     * @param start start of the interval (included) [ticks]
+     * @param end end of the interval (excluded) [ticks]
+     * @return iterators to the first and after the last hit in the interval
+     *
+     * The hits must be sorted (see `finalize()`).
+     */
+    inline std::pair<const_iterator, const_iterator> TimeRange
+      (const float start, const float end) const
+    {
+      assert(std::is_sorted(begin(),this->end())); // forgot finalize()?
+      auto const first = std::lower_bound(begin(),this->end(),start);
+      return { first, std::lower_bound(first,this->end(),end) };
     }
   };
 }
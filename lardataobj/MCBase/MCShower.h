@@ -106,6 +106,7 @@ namespace sim {
     void DetProfile ( const MCStep& s) { fDetProfile = s; }
 
     void DaughterTrackID ( const std::vector<unsigned int>& id_v ) { fDaughterTrackID = id_v; }
+    void DaughterTrackID ( std::vector<unsigned int>&& id_v ) { fDaughterTrackID = std::move(id_v); }
 
     /// Copies the specified charge vector (one entry per plane) into this object
     void Charge (const std::vector<double>& q) { fPlaneCharge = q; }
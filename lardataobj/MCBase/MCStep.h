@@ -58,6 +58,59 @@ namespace sim{
     TLorentzVector _momentum; // Momentum 4-vector (px,py,pz,E) in [MeV/c,MeV/c,Mev/c,MeV]
 
   };
+
+  /**
+     \class MCStepLite
+     Compact form of sim::MCStep: the position and momentum are stored in
+     single precision, the time in double precision, without the ROOT object
+     overhead of TLorentzVector.
+  */
+  class MCStepLite {
+
+  public:
+
+    MCStepLite()
+      : _x(kINVALID_FLOAT), _y(kINVALID_FLOAT), _z(kINVALID_FLOAT),
+	_t(kINVALID_DOUBLE),
+	_px(kINVALID_FLOAT), _py(kINVALID_FLOAT), _pz(kINVALID_FLOAT),
+	_e(kINVALID_FLOAT)
+    {}
+
+    /// Constructor: copies the step (kINVALID_DOUBLE becomes kINVALID_FLOAT)
+    explicit MCStepLite(const MCStep& step)
+      : _x(ToFloat(step.X())), _y(ToFloat(step.Y())), _z(ToFloat(step.Z())),
+	_t(step.T()),
+	_px(ToFloat(step.Px())), _py(ToFloat(step.Py())), _pz(ToFloat(step.Pz())),
+	_e(ToFloat(step.E()))
+    {}
+
+    double X()  const {return ToDouble(_x);  }
+    double Y()  const {return ToDouble(_y);  }
+    double Z()  const {return ToDouble(_z);  }
+    double T()  const {return _t;            }
+    double Px() const {return ToDouble(_px); }
+    double Py() const {return ToDouble(_py); }
+    double Pz() const {return ToDouble(_pz); }
+    double E()  const {return ToDouble(_e);  }
+
+    /// Returns the sim::MCStep with the same content
+    MCStep ToMCStep() const
+    { return { TLorentzVector(X(), Y(), Z(), T()), TLorentzVector(Px(), Py(), Pz(), E()) }; }
+
+  protected:
+
+    float  _x, _y, _z;       // Position in [cm]
+    double _t;               // Time in [ns]
+    float  _px, _py, _pz, _e; // Momentum 4-vector (px,py,pz,E) in [MeV/c,MeV/c,Mev/c,MeV]
+
+  private:
+
+    static float ToFloat(double v)
+    { return (v == kINVALID_DOUBLE)? kINVALID_FLOAT: static_cast<float>(v); }
+    static double ToDouble(float v)
+    { return (v == kINVALID_FLOAT)? kINVALID_DOUBLE: v; }
+
+  };
 }
 
 #endif
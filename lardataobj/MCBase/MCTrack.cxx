@@ -1,4 +1,8 @@
 #include "lardataobj/MCBase/MCTrack.h"
+#include "lardataobj/MCBase/MCBaseException.h"
+
+#include <algorithm>
+#include <string>
 
 namespace sim {
 
@@ -31,6 +35,7 @@ namespace sim {
 
     fdEdx.clear();
     fdQdx.clear();
+    fdQdxColumns = 0;
 
     fMotherStart = invalid_step;
     fMotherEnd   = invalid_step;
@@ -39,4 +44,35 @@ namespace sim {
     fAncestorEnd   = invalid_step;
 
   }
+
+  void MCTrack::dQdx(const std::vector<std::vector<double> >& s)
+  {
+    unsigned int columns = 0;
+    for(auto const& row : s) columns = std::max(columns, static_cast<unsigned int>(row.size()));
+
+    fdQdx.assign(s.size() * columns, 0.);
+    auto it = fdQdx.begin();
+    for(auto const& row : s) {
+      std::copy(row.begin(), row.end(), it);
+      it += columns;
+    }
+    fdQdxColumns = columns;
+  }
+
+  void MCTrack::dQdx(std::vector<float>&& values, unsigned int columns)
+  {
+    if(columns ? (values.size() % columns != 0) : !values.empty())
+      throw MCBaseException("MCTrack::dQdx(): " + std::to_string(values.size())
+			    + " values do not fill rows of " + std::to_string(columns));
+    fdQdx = std::move(values);
+    fdQdxColumns = columns;
+  }
+
+  MCTrack::dQdxView_t::operator std::vector<std::vector<double> >() const
+  {
+    std::vector<std::vector<double> > nested;
+    nested.reserve(size());
+    for(auto const& row : *this) nested.emplace_back(row.begin(), row.end());
+    return nested;
+  }
 }
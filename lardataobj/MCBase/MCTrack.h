@@ -16,7 +16,11 @@
 #define MCTRACK_H
 
 #include <vector>
+#include <cstddef>
+#include <iterator>
+#include <utility>
 #include "lardataobj/MCBase/MCStep.h"
+#include "lardataobj/Utilities/IteratorRange.h"
 #include "nusimdata/SimulationBase/MCTruth.h"
 
 namespace sim{
@@ -28,6 +32,61 @@ namespace sim{
 
   public:
 
+    /**
+       \class dQdxView_t
+       Read-only view of the dQdx matrix with the nested indexing of
+       std::vector<std::vector<double>>: view[i][j] is the element j of row i.
+       The rows are not copied; a nested vector is created only on conversion.
+    */
+    class dQdxView_t {
+
+    public:
+
+      /// One row of the matrix
+      class Row_t : public util::IteratorRange<const float*> {
+      public:
+	using util::IteratorRange<const float*>::IteratorRange;
+	operator std::vector<double>() const { return { begin(), end() }; }
+      };
+
+      /// Iterator on the rows of the matrix
+      class const_iterator {
+      public:
+	using iterator_category = std::forward_iterator_tag;
+	using value_type = Row_t;
+	using difference_type = std::ptrdiff_t;
+	using pointer = void;
+	using reference = Row_t;
+
+	const_iterator(const float* row, size_t columns): fRow(row), fColumns(columns) {}
+	Row_t operator* () const { return { fRow, fRow + fColumns }; }
+	const_iterator& operator++ () { fRow += fColumns; return *this; }
+	const_iterator operator++ (int) { auto old = *this; fRow += fColumns; return old; }
+	bool operator== (const const_iterator& rhs) const { return fRow == rhs.fRow; }
+	bool operator!= (const const_iterator& rhs) const { return fRow != rhs.fRow; }
+      private:
+	const float* fRow;
+	size_t fColumns;
+      };
+
+      dQdxView_t(const std::vector<float>& values, size_t columns)
+	: fValues(&values), fColumns(columns) {}
+
+      size_t size() const { return fColumns? fValues->size() / fColumns: 0; }
+      bool empty() const { return size() == 0; }
+      Row_t operator[] (size_t i) const
+      { return { fValues->data() + i * fColumns, fValues->data() + (i + 1) * fColumns }; }
+      const_iterator begin() const { return { fValues->data(), fColumns }; }
+      const_iterator end() const { return { fValues->data() + size() * fColumns, fColumns }; }
+
+      /// Creates a nested vector with the content of the matrix
+      operator std::vector<std::vector<double> >() const;
+
+    private:
+      const std::vector<float>* fValues;
+      size_t fColumns;
+    };
+
     /// Default constructor
     MCTrack() : std::vector<sim::MCStep>() {Clear();}
 
@@ -43,9 +102,17 @@ namespace sim{
     const std::string&  Process  () const { return fProcess;  }
     const MCStep&       Start    () const { return fStart;    }
     const MCStep&       End      () const { return fEnd;      }
-    const std::vector< std::vector<double> >& dQdx() const{ return fdQdx;}  // dQdx[# of MCSteps][# of plane]
+    /// Returns a copy of the dQdx matrix as nested vector; see also dQdxView()
+    std::vector<std::vector<double> > dQdx() const { return dQdxView(); }  // dQdx[# of MCSteps][# of plane]
+    /// Returns a view of the dQdx matrix with the same indexing as dQdx(), without copy
+    dQdxView_t dQdxView() const { return { fdQdx, fdQdxColumns }; }
     const std::vector<double>& dEdx() const {return fdEdx;} // dEdx[# of MCSteps]
 
+    /// dQdx matrix values, row after row (see dQdxColumns())
+    const std::vector<float>& dQdxValues() const { return fdQdx; }
+    /// Number of elements in each row of the dQdx matrix
+    unsigned int dQdxColumns() const { return fdQdxColumns; }
+
     int                MotherPdgCode () const { return fMotherPDGCode; }
     unsigned int       MotherTrackID () const { return fMotherTrackID; }
     const std::string& MotherProcess () const { return fMotherProcess; }
@@ -62,10 +129,18 @@ namespace sim{
     void PdgCode       ( int id           ) { fPDGCode = id;   }
     void TrackID       ( unsigned int id  ) { fTrackID = id;   }
     void Process       ( std::string name ) { fProcess = name; }
-    void Start         ( const MCStep s   ) { fStart   = s;    }
-    void End           ( const MCStep s   ) { fEnd     = s;    }
-    void dEdx          ( const std::vector<double> s) { fdEdx = s;}
-    void dQdx          ( const std::vector<std::vector<double> > s) { fdQdx = s;}
+    void Start         ( const MCStep& s  ) { fStart   = s;    }
+    void End           ( const MCStep& s  ) { fEnd     = s;    }
+
+    /// Copies the specified dE/dx vector (one entry per step) into this object
+    void dEdx          ( const std::vector<double>& s) { fdEdx = s;}
+    /// Moves the specified dE/dx vector (one entry per step) into this object
+    void dEdx          ( std::vector<double>&& s) { fdEdx = std::move(s);}
+
+    /// Copies the nested dQdx vector into the matrix (shorter rows are padded with 0)
+    void dQdx          ( const std::vector<std::vector<double> >& s);
+    /// Moves the dQdx matrix values (row after row, `columns` per row) into this object
+    void dQdx          ( std::vector<float>&& values, unsigned int columns);
 
 
     void MotherPdgCode ( int id               ) { fMotherPDGCode = id; }
@@ -89,7 +164,8 @@ namespace sim{
     std::string    fProcess; ///< G4 creation process of this track particle
     MCStep         fStart;   ///< G4 start position/momentum of this track particle
     MCStep         fEnd;     ///< G4 end position/momentum of this track particle
-    std::vector<std::vector<double> > fdQdx; //< the G4 electron yeild per plane between each step // [N Plane][MCSteps - 1]
+    std::vector<float> fdQdx; ///< the G4 electron yeild per plane between each step, as matrix rows // [N Plane][MCSteps - 1]
+    unsigned int fdQdxColumns; ///< number of elements in each row of fdQdx
     std::vector<double> fdEdx;//< the G4 "ionization" energy loss between each step // [MCSteps - 1]
 
     int            fMotherPDGCode; ///< This particle's mother's PDG code
@@ -4,6 +4,7 @@
 // C++ includes
 #include <vector>
 #include <functional> // std::less
+#include <utility> // std::move
 #include "lardataobj/MCBase/MCLimits.h"
 
 namespace sim {
@@ -38,6 +39,14 @@ namespace sim {
       SetWaveform(wf);
     }
 
+    /// Constructor: moves the waveform in
+    MCWire(const unsigned int start,
+	   std::vector<double> &&wf)
+    {
+      SetStartTDC(start);
+      SetWaveform(std::move(wf));
+    }
+
     /// Setter function for time
     void SetStartTDC(const unsigned int start)
     {
@@ -47,9 +56,13 @@ namespace sim {
     /// Setter function for waveform
     void SetWaveform(const std::vector<double>& wf)
     {
-      this->resize(wf.size(),0);
-      for(std::size_t i=0; i<wf.size(); ++i)
-	this->at(i) = wf.at(i);
+      this->assign(wf.begin(),wf.end());
+    }
+
+    /// Setter function for waveform, moving it in
+    void SetWaveform(std::vector<double>&& wf)
+    {
+      std::vector<double>::operator=(std::move(wf));
     }
 
     /// Getter for start time
@@ -3,6 +3,9 @@
 #define MCWIRECOLLECTION_H
 
 // C++ includes
+#include <algorithm>
+#include <utility>
+#include <cassert>
 #include "lardataobj/MCBase/MCWire.h"
 
 namespace sim {
@@ -37,16 +40,55 @@ namespace sim {
     /// For sorting
     inline bool operator< ( const MCWireCollection& rhs ) const { return fChannel < rhs.fChannel; }
 
-    /// wrapper for push_back
+    /// wrapper for push_back: keeps the wires sorted by start TDC
     inline void push_back(const MCWire& wire)
     {
 
-      bool sort = (!empty() && wire < (*rbegin()));
+      if(empty() || !(wire < (*rbegin()))) {
+	std::vector<sim::MCWire>::push_back(wire);
+	return;
+      }
 
-      std::vector<sim::MCWire>::push_back(wire);
+      // insert after all the wires starting not later than this one
+      insert(std::upper_bound(begin(),end(),wire),wire);
 
-      if(sort) std::sort(begin(),end());
+    }
 
+    /**
+     * @brief Appends a wire without sorting (bulk filling).
+     *
+     * After all wires are added with this method, `finalize()` must be called
+     * to sort them, before any other method which needs sorted wires.
+     */
+    inline void append(const MCWire& wire)
+    { std::vector<sim::MCWire>::push_back(wire); }
+
+    /// Appends a wire without sorting, moving its waveform (bulk filling).
+    inline void append(MCWire&& wire)
+    { std::vector<sim::MCWire>::push_back(std::move(wire)); }
+
+    /// Sorts the wires by start TDC, after bulk filling with `append()`.
+    inline void finalize()
+    {
+      if(!std::is_sorted(begin(),end())) std::stable_sort(begin(),end());
+    }
+
+    /**
+     * @brief Returns the wires with start TDC in the specified interval.
+     * @param start start of the interval (included)
+     * @param end end of the interval (excluded)
+     * @return iterators to the first and after the last wire in the interval
+     *
+     * The wires must be sorted (see `finalize()`).
+     */
+    inline std::pair<const_iterator, const_iterator> TimeRange
+      (const unsigned int start, const unsigned int end) const
+    {
+      assert(std::is_sorted(begin(),this->end())); // forgot finalize()?
+      auto const startsBefore = [](const MCWire& wire, const unsigned int tdc)
+	{ return wire.StartTDC() < tdc; };
+      auto const first = std::lower_bound(begin(),this->end(),start,startsBefore);
+      return { first, std::lower_bound(first,this->end(),end,startsBefore) };
     }
   };
 }
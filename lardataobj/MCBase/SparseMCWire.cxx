@@ -0,0 +1,15 @@
+#include "lardataobj/MCBase/SparseMCWire.h"
+
+namespace sim {
+
+  MCWire SparseMCWire::MakeMCWire() const
+  {
+    std::vector<double> waveform(fSignal.size(), 0.);
+    for (const auto& range: fSignal.get_ranges()) {
+      std::size_t i = range.begin_index();
+      for (const float value: range) waveform[i++] = value;
+    }
+    return MCWire(fStartTDC, std::move(waveform));
+  }
+
+}
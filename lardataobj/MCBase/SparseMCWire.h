@@ -0,0 +1,108 @@
+#ifndef SPARSEMCWIRE_H
+#define SPARSEMCWIRE_H
+
+// C++ includes
+#include <cstddef>
+#include <iterator>
+#include <utility>
+#include "lardataobj/Utilities/sparse_vector.h"
+#include "lardataobj/MCBase/MCWire.h"
+#include "lardataobj/MCBase/MCLimits.h"
+
+namespace sim {
+
+  /**
+   * @brief Compact form of `sim::MCWire`.
+   *
+   * The waveform is stored in single precision in a `lar::sparse_vector`
+   * (the same type as the signal of `recob::Wire`): only the regions with
+   * signal take space. The sample `i` of the waveform is at TDC
+   * `StartTDC() + i`, as in `sim::MCWire`.
+   *
+   * `Waveform()` presents the waveform as `double` values, like the content
+   * of `sim::MCWire`, without creating a dense copy; `MakeMCWire()` creates
+   * the dense `sim::MCWire`.
+   */
+  class SparseMCWire {
+
+  public:
+
+    /// Type of the stored waveform
+    using Signal_t = lar::sparse_vector<float>;
+
+    /// View of the waveform as `double` values (see `Waveform()`)
+    class WaveformView {
+    public:
+      class const_iterator {
+      public:
+	using iterator_category = std::forward_iterator_tag;
+	using value_type = double;
+	using difference_type = std::ptrdiff_t;
+	using pointer = void;
+	using reference = double;
+
+	const_iterator(Signal_t::const_iterator it): fIt(it) {}
+	double operator* () const { return *fIt; }
+	const_iterator& operator++ () { ++fIt; return *this; }
+	const_iterator operator++ (int) { auto old = *this; ++fIt; return old; }
+	bool operator== (const const_iterator& rhs) const { return fIt == rhs.fIt; }
+	bool operator!= (const const_iterator& rhs) const { return fIt != rhs.fIt; }
+      private:
+	Signal_t::const_iterator fIt;
+      };
+
+      WaveformView(const Signal_t& signal): fSignal(&signal) {}
+
+      std::size_t size() const { return fSignal->size(); }
+      bool empty() const { return fSignal->empty(); }
+      double operator[] (std::size_t i) const { return (*fSignal)[i]; }
+      const_iterator begin() const { return fSignal->begin(); }
+      const_iterator end() const { return fSignal->end(); }
+
+    private:
+      const Signal_t* fSignal;
+    };
+
+    /// Default ctor
+    SparseMCWire(): fStartTDC(sim::kINVALID_UINT) {}
+
+    /// Constructor: moves the sparse waveform in
+    SparseMCWire(const unsigned int start, Signal_t&& signal)
+      : fStartTDC(start), fSignal(std::move(signal)) {}
+
+    /**
+     * @brief Constructor: compacts a `sim::MCWire`.
+     * @param wire the wire to be compacted
+     * @param threshold samples not above this value (in module) are not stored
+     */
+    explicit SparseMCWire(const MCWire& wire, const float threshold = 0.)
+      : fStartTDC(wire.StartTDC())
+      , fSignal(Signal_t::from_dense(wire.begin(), wire.end(), threshold))
+    {}
+
+  private:
+
+    unsigned int fStartTDC; ///< TDC of the first sample of the waveform
+    Signal_t fSignal;       ///< Waveform, starting at `fStartTDC`
+
+  public:
+
+    /// Getter for start time
+    unsigned int StartTDC() const { return fStartTDC; }
+
+    /// Getter for the sparse waveform
+    const Signal_t& Signal() const { return fSignal; }
+
+    /// Returns the waveform as `double` values, without copying it
+    WaveformView Waveform() const { return { fSignal }; }
+
+    /// Creates the dense `sim::MCWire` with this waveform
+    MCWire MakeMCWire() const;
+
+    /// For sorting
+    inline bool operator< ( const SparseMCWire& rhs ) const { return fStartTDC < rhs.fStartTDC; }
+
+  };
+}
+
+#endif
@@ -2,6 +2,7 @@
 
 #include "lardataobj/MCBase/MCHit.h"
 #include "lardataobj/MCBase/MCWire.h"
+#include "lardataobj/MCBase/SparseMCWire.h"
 #include "lardataobj/MCBase/MCWireCollection.h"
 #include "lardataobj/MCBase/MCHitCollection.h"
 #include "lardataobj/MCBase/MCShower.h"
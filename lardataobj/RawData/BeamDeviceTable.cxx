@@ -0,0 +1,78 @@
+/////////////////////////////////////////////////////////////////////
+// \file    BeamDeviceTable class
+// \brief   Beam monitor data, with integer device keys and flat storage.
+////////////////////////////////////////////////////////////////////
+
+#include "lardataobj/RawData/BeamDeviceTable.h"
+#include "lardataobj/RawData/BeamInfo.h"
+
+#include "cetlib_except/exception.h"
+
+#include <algorithm> // std::lower_bound()
+
+namespace raw{
+
+  //-------------------------------------------------------------------------
+  BeamDeviceTable::BeamDeviceTable(BeamInfo const& info)
+  {
+    std::size_t nValues = 0;
+    for (auto const& device: info.GetDataMap()) nValues += device.second.size();
+    Reserve(info.GetDataMap().size(), nValues);
+    for (auto const& device: info.GetDataMap()) Set(device.first, device.second);
+  }
+
+  //-------------------------------------------------------------------------
+  void BeamDeviceTable::Reserve(std::size_t nDevices, std::size_t nValues)
+  {
+    fKeys.reserve(nDevices);
+    fNames.reserve(nDevices);
+    fBegin.reserve(nDevices);
+    fSize.reserve(nDevices);
+    fValues.reserve(nValues);
+  }
+
+  //-------------------------------------------------------------------------
+  double* BeamDeviceTable::Allocate(std::string_view name, std::size_t nValues)
+  {
+    DeviceKey_t const key = DeviceKey(name);
+    auto const itKey = std::lower_bound(fKeys.begin(), fKeys.end(), key);
+    std::size_t const index = itKey - fKeys.begin();
+    if ((itKey != fKeys.end()) && (*itKey == key)) {
+      if (fNames[index] == name) return nullptr; // device already listed
+      throw cet::exception("BeamDeviceTable")
+        << "devices '" << fNames[index] << "' and '" << name
+        << "' have the same key " << key << "\n";
+    }
+
+    std::size_t const begin = fValues.size();
+    fKeys.insert(itKey, key);
+    fNames.emplace(fNames.begin() + index, name);
+    fBegin.insert(fBegin.begin() + index, begin);
+    fSize.insert(fSize.begin() + index, nValues);
+    fValues.resize(begin + nValues, 0.0);
+    return fValues.data() + begin;
+  }
+
+  //-------------------------------------------------------------------------
+  std::size_t BeamDeviceTable::Find(DeviceKey_t key) const
+  {
+    auto const itKey = std::lower_bound(fKeys.begin(), fKeys.end(), key);
+    return ((itKey != fKeys.end()) && (*itKey == key))
+      ? (itKey - fKeys.begin()): NDevices();
+  }
+
+  //-------------------------------------------------------------------------
+  BeamDeviceTable::Values_t BeamDeviceTable::Get(DeviceKey_t key) const
+  {
+    std::size_t const index = Find(key);
+    return (index < NDevices())? ValuesAt(index): Values_t{};
+  }
+
+  //-------------------------------------------------------------------------
+  BeamDeviceTable::Values_t BeamDeviceTable::ValuesAt(std::size_t i) const
+  {
+    double const* begin = fValues.data() + fBegin[i];
+    return { begin, begin + fSize[i] };
+  }
+
+}// namespace
@@ -0,0 +1,157 @@
+/**
+ * @file lardataobj/RawData/BeamDeviceTable.h
+ * @brief Beam monitor data, with integer device keys and flat storage.
+ * @see   lardataobj/RawData/BeamDeviceTable.cxx
+ *
+ */
+
+#ifndef RAWDATA_BEAMDEVICETABLE_H
+#define RAWDATA_BEAMDEVICETABLE_H
+
+// uint64_t is typedef unsigned long long on macOS but unsigned long on Linux
+// We use the root type ULong64_t from RtypesCore.h instead
+#include "RtypesCore.h"
+
+#include "lardataobj/Utilities/IteratorRange.h"
+
+#include <cstddef> // std::size_t
+#include <iterator> // std::distance()
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace raw {
+
+  class BeamInfo;
+
+  /**
+   * @brief Beam monitor data (one series of values per device).
+   *
+   * This holds the same information as the device data of `raw::BeamInfo`.
+   * Each device is identified by an integer key, a hash of its name
+   * (`DeviceKey()`). The key of a device is the same in all events and jobs,
+   * so a beam filter can compute the keys of the devices it needs once, and
+   * then look them up without string comparisons:
+   *
+   *     constexpr auto TOR101 = raw::BeamDeviceTable::DeviceKey("E:TOR101");
+   *     // ...
+   *     for (double v: table.Get(TOR101)) { ... }
+   *
+   * The values of all devices are in one flat array. The devices are sorted
+   * by key, and `Get()` returns a range pointing into that array, with no copy.
+   *
+   * Values can be added with no temporary copy through `Allocate()`, which
+   * returns the storage for the new series, to be filled in place.
+   */
+  class BeamDeviceTable {
+
+  public:
+
+    using DeviceKey_t = ULong64_t; ///< Type of the device key.
+
+    /// Range of the values of one device (pointers into the table storage).
+    class Values_t: public util::IteratorRange<double const*> {
+    public:
+      using util::IteratorRange<double const*>::IteratorRange;
+
+      /// Returns a copy of the values.
+      std::vector<double> vector() const { return { begin(), end() }; }
+    }; // class Values_t
+
+
+    /// Returns the key of the device with the specified name (64-bit FNV-1a).
+    static constexpr DeviceKey_t DeviceKey(std::string_view name)
+      {
+        DeviceKey_t key = 14695981039346656037ULL;
+        for (char const c: name) {
+          key ^= static_cast<unsigned char>(c);
+          key *= 1099511628211ULL;
+        }
+        return key;
+      }
+
+
+    /// Constructor: an empty table.
+    BeamDeviceTable() = default;
+
+    /// Constructor: copies the device data of `info`.
+    explicit BeamDeviceTable(BeamInfo const& info);
+
+
+    /// Prepares the storage for `nDevices` devices with `nValues` in total.
+    void Reserve(std::size_t nDevices, std::size_t nValues);
+
+    /**
+     * @brief Adds a device and returns the storage for its values.
+     * @param name the name of the device
+     * @param nValues the number of values of the device
+     * @return a pointer to `nValues` values, to be filled by the caller
+     *
+     * The values are initialized to `0`. The returned pointer is valid until
+     * the next device is added.
+     * Like for `raw::BeamInfo::Set()`, a device which is already present is
+     * not replaced: in that case, `nullptr` is returned.
+     * An exception is thrown if a different device has the same key.
+     */
+    double* Allocate(std::string_view name, std::size_t nValues);
+
+    /// Adds a device with the values in `[begin, end)` (see `Allocate()`).
+    template <typename Iter>
+    void Set(std::string_view name, Iter begin, Iter end);
+
+    /// Adds a device with the specified values (see `Allocate()`).
+    void Set(std::string_view name, std::vector<double> const& values)
+      { Set(name, values.begin(), values.end()); }
+
+
+    /// Returns the number of devices.
+    std::size_t NDevices() const { return fKeys.size(); }
+
+    /// Returns whether the device with the specified key is present.
+    bool HasDevice(DeviceKey_t key) const { return Find(key) < NDevices(); }
+
+    /// Returns the values of the device with `key` (empty if not present).
+    Values_t Get(DeviceKey_t key) const;
+
+    /// Returns the values of the device with `name` (empty if not present).
+    Values_t Get(std::string_view name) const { return Get(DeviceKey(name)); }
+
+    /// Returns the keys of all the devices, sorted.
+    std::vector<DeviceKey_t> const& DeviceKeys() const { return fKeys; }
+
+    /// Returns the name of the device number `i` (in the order of the keys).
+    std::string const& DeviceName(std::size_t i) const { return fNames[i]; }
+
+    /// Returns the values of the device number `i` (in the order of the keys).
+    Values_t ValuesAt(std::size_t i) const;
+
+    /// Returns all the values (grouped by device, in the order they were added).
+    std::vector<double> const& Values() const { return fValues; }
+
+  private:
+
+    std::vector<DeviceKey_t> fKeys; ///< Key of each device, sorted.
+    std::vector<std::string> fNames; ///< Name of each device.
+    std::vector<unsigned int> fBegin; ///< Position of the first value of each device.
+    std::vector<unsigned int> fSize; ///< Number of values of each device.
+    std::vector<double> fValues; ///< Values of all devices.
+
+    /// Returns the index of the device with `key`, `NDevices()` if not present.
+    std::size_t Find(DeviceKey_t key) const;
+
+  }; // class BeamDeviceTable
+
+} // namespace raw
+
+
+//------------------------------------------------------------------------------
+template <typename Iter>
+void raw::BeamDeviceTable::Set(std::string_view name, Iter begin, Iter end)
+{
+  double* values = Allocate(name, std::distance(begin, end));
+  if (!values) return;
+  while (begin != end) *(values++) = *(begin++);
+} // raw::BeamDeviceTable::Set()
+
+
+#endif // RAWDATA_BEAMDEVICETABLE_H
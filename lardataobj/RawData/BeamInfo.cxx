@@ -7,6 +7,7 @@
 
 #include <ostream>
 #include <string>
+#include <utility>
 
 namespace raw{
 
@@ -108,8 +109,15 @@ namespace raw{
       //device already listed
       return;
     };
-    std::pair<std::string, std::vector<double> > p(device,val);
-    fDataMap.insert(p);
+    fDataMap.emplace(std::move(device), std::move(val));
+  }
+
+  //-------------------------------------------------------------------------
+  const std::vector<double>& BeamInfo::Get(const std::string& device) const
+  {
+    static const std::vector<double> empty;
+    auto const it = fDataMap.find(device);
+    return (it == fDataMap.end())? empty: it->second;
   }
 
   //-------------------------------------------------------------------------
@@ -123,7 +131,7 @@ namespace raw{
                                 << o.GetMilliSeconds()    << std::endl;
     os << "Number of Devices: " << o.GetNumberOfDevices() << std::endl;
 
-    const std::map<std::string, std::vector<double> > dm=o.GetDataMap();
+    const std::map<std::string, std::vector<double> >& dm=o.GetDataMap();
     std::map<std::string, std::vector<double> >::const_iterator it=dm.begin();
     while (it!=dm.end()) {
       os << it->first<<": ";
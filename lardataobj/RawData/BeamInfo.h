@@ -59,8 +59,9 @@ namespace raw {
     uint16_t GetMilliSeconds()    const {return fMilliSeconds;};
     uint16_t GetNumberOfDevices() const {return fNumberOfDevices;};
 
-    std::vector<double> Get(std::string device_name);
-    std::map<std::string, std::vector<double> > GetDataMap() const {return fDataMap;};
+    /// Returns the values of the device (an empty vector if not present)
+    const std::vector<double>& Get(const std::string& device_name) const;
+    const std::map<std::string, std::vector<double> >& GetDataMap() const {return fDataMap;};
 
     friend std::ostream& operator<<(std::ostream& , const BeamInfo& );
 
@@ -15,6 +15,7 @@
 #include "lardataobj/RawData/OpDetPulse.h"
 #include "lardataobj/RawData/AuxDetDigit.h"
 #include "lardataobj/RawData/BeamInfo.h"
+#include "lardataobj/RawData/BeamDeviceTable.h"
 #include "lardataobj/RawData/ExternalTrigger.h"
 #include "lardataobj/RawData/TriggerData.h"
 #include "lardataobj/RawData/OpDetWaveform.h"
@@ -0,0 +1,108 @@
+/** ****************************************************************************
+ * @file CompactWire.cxx
+ * @brief Definition of a reduced precision channel signal object.
+ * @see  CompactWire.h
+ *
+ * ****************************************************************************/
+
+#include "lardataobj/RecoBase/CompactWire.h"
+
+// C/C++ standard libraries
+#include <algorithm> // std::max(), std::min()
+#include <cmath> // std::abs(), std::lround()
+#include <limits>
+
+namespace recob{
+
+  //----------------------------------------------------------------------
+  CompactROI::CompactROI
+    (unsigned int begin, std::vector<float> const& values, float step /* = 0 */)
+    : fBegin(begin)
+    , fScale(step)
+    , fSamples(values.size())
+  {
+    constexpr float MaxSample = std::numeric_limits<Sample_t>::max();
+    constexpr float MinSample = std::numeric_limits<Sample_t>::min();
+
+    if (fScale <= 0.0f) {
+      float maxValue = 0.0f;
+      for (float value: values) maxValue = std::max(maxValue, std::abs(value));
+      fScale = (maxValue > 0.0f)? maxValue / MaxSample: 1.0f;
+    }
+
+    float const factor = 1.0f / fScale;
+    auto iSample = fSamples.begin();
+    for (float value: values) {
+      float const q = std::min(MaxSample, std::max(MinSample, value * factor));
+      *(iSample++) = static_cast<Sample_t>(std::lround(q));
+    } // for
+  } // CompactROI::CompactROI()
+
+
+  //----------------------------------------------------------------------
+  std::vector<float> CompactROI::Values() const {
+    std::vector<float> values;
+    values.reserve(fSamples.size());
+    for (Sample_t sample: fSamples) values.push_back(fScale * sample);
+    return values;
+  } // CompactROI::Values()
+
+
+  //----------------------------------------------------------------------
+  CompactWire::CompactWire()
+    : fChannel(raw::InvalidChannelID)
+    , fView(geo::kUnknown)
+    , fNSignal(0U)
+    , fROIs()
+    {}
+
+  //----------------------------------------------------------------------
+  CompactWire::CompactWire(
+    RegionsOfInterest_t const& sigROIlist,
+    raw::ChannelID_t channel,
+    geo::View_t view,
+    float step /* = 0 */
+    )
+    : fChannel(channel)
+    , fView(view)
+    , fNSignal(sigROIlist.size())
+    , fROIs()
+  {
+    fROIs.reserve(sigROIlist.n_ranges());
+    for (auto const& range: sigROIlist.get_ranges())
+      fROIs.emplace_back(range.begin_index(), range.data(), step);
+  } // CompactWire::CompactWire()
+
+  //----------------------------------------------------------------------
+  CompactWire::CompactWire(recob::Wire const& wire, float step /* = 0 */)
+    : CompactWire(wire.SignalROI(), wire.Channel(), wire.View(), step)
+    {}
+
+
+  //----------------------------------------------------------------------
+  CompactWire::RegionsOfInterest_t CompactWire::SignalROI() const {
+    RegionsOfInterest_t sigROIlist(fNSignal);
+    for (CompactROI const& ROI: fROIs)
+      sigROIlist.add_range(ROI.begin_index(), ROI.Values());
+    return sigROIlist;
+  } // CompactWire::SignalROI()
+
+
+  //----------------------------------------------------------------------
+  std::vector<float> CompactWire::Signal() const {
+    std::vector<float> signal(fNSignal, 0.0f);
+    for (CompactROI const& ROI: fROIs) {
+      auto iSignal = signal.begin() + ROI.begin_index();
+      for (auto sample: ROI.Samples()) *(iSignal++) = ROI.Scale() * sample;
+    }
+    return signal;
+  } // CompactWire::Signal()
+
+
+  //----------------------------------------------------------------------
+  recob::Wire CompactWire::MakeWire() const
+    { return { SignalROI(), fChannel, fView }; }
+
+
+}
+////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,194 @@
+/** ****************************************************************************
+ * @file lardataobj/RecoBase/CompactWire.h
+ * @brief Declaration of a reduced precision channel signal object.
+ * @see  lardataobj/RecoBase/CompactWire.cxx
+ *
+ * ****************************************************************************/
+
+#ifndef LARDATAOBJ_RECOBASE_COMPACTWIRE_H
+#define LARDATAOBJ_RECOBASE_COMPACTWIRE_H
+
+
+// LArSoft libraries
+#include "lardataobj/RecoBase/Wire.h"
+#include "larcoreobj/SimpleTypesAndConstants/RawTypes.h" // raw::ChannelID_t
+#include "larcoreobj/SimpleTypesAndConstants/geo_types.h"
+
+// C/C++ standard libraries
+#include <vector>
+#include <cstddef> // std::size_t
+#include <cstdint> // std::int16_t
+
+
+namespace recob {
+
+  /**
+   * @brief A region of interest with samples stored as 16-bit fixed point.
+   *
+   * Each sample is stored as a signed 16-bit integer `q`, representing the
+   * value `q * Scale()`. The scale is common to all the samples of the region.
+   * Values beyond the representable range are saturated.
+   *
+   * Indexed access is by absolute tick number, like for the ranges of
+   * `recob::Wire::RegionsOfInterest_t`.
+   */
+  class CompactROI {
+    public:
+      using Sample_t = std::int16_t; ///< Type of the stored samples.
+
+      /// Default constructor: an empty region.
+      CompactROI() = default;
+
+      /**
+       * @brief Constructor: quantizes the specified values.
+       * @param begin the tick of the first value
+       * @param values the values of the region, one per tick
+       * @param step the quantization step (`0`: computed from the values)
+       *
+       * If the quantization step is `0`, it is chosen so that the largest
+       * (absolute) value in `values` is represented by the largest sample.
+       */
+      CompactROI(unsigned int begin, std::vector<float> const& values, float step = 0.0f);
+
+      /// Returns the first tick of the region.
+      unsigned int begin_index() const { return fBegin; }
+
+      /// Returns the first tick after the region.
+      unsigned int end_index() const { return fBegin + size(); }
+
+      /// Returns the number of ticks in the region.
+      unsigned int size() const { return fSamples.size(); }
+
+      /// Returns whether the region has no tick.
+      bool empty() const { return fSamples.empty(); }
+
+      /// Returns the quantization step of this region.
+      float Scale() const { return fScale; }
+
+      /// Returns the raw stored samples.
+      std::vector<Sample_t> const& Samples() const { return fSamples; }
+
+      /// Returns the value at the specified (absolute) tick (no check!).
+      float operator[] (std::size_t tick) const
+        { return fScale * fSamples[tick - fBegin]; }
+
+      /// Returns the values of the region, converted to `float`.
+      std::vector<float> Values() const;
+
+    private:
+      unsigned int fBegin = 0U;       ///< First tick of the region.
+      float fScale = 1.0f;            ///< Value of one unit of a sample.
+      std::vector<Sample_t> fSamples; ///< Quantized samples.
+
+  }; // class CompactROI
+
+
+  /**
+   * @brief Reduced-precision version of `recob::Wire`.
+   *
+   * This object holds the same information as `recob::Wire`, but the signal
+   * samples are stored as 16-bit fixed point numbers, with a scale specified
+   * per region of interest (see `recob::CompactROI`).
+   * The price is a relative precision of about 3&times;10<sup>-5</sup> of the
+   * largest sample in each region of interest, or of the chosen fixed
+   * quantization step.
+   *
+   * The data is accessed after conversion into `float`; for example,
+   * `SignalROI()` returns a `recob::Wire::RegionsOfInterest_t` with the same
+   * region structure as the original wire, and `MakeWire()` restores a full
+   * `recob::Wire` object.
+   * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.cpp}
+   * recob::CompactWire const compact { wire };
+   * for (recob::CompactROI const& ROI: compact.ROIs()) {
+   *   for (auto tick = ROI.begin_index(); tick < ROI.end_index(); ++tick)
+   *     std::cout << " " << ROI[tick];
+   * }
+   * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+   */
+  class CompactWire {
+    public:
+      /// Type of the regions of interest in the uncompressed form.
+      using RegionsOfInterest_t = recob::Wire::RegionsOfInterest_t;
+
+      /// Default constructor: a wire with no signal information.
+      CompactWire();
+
+      /**
+       * @brief Constructor: quantizes the specified signal.
+       * @param sigROIlist signal organized in regions of interest
+       * @param channel the ID of the channel
+       * @param view the view the channel belongs to
+       * @param step quantization step (`0`: per region, from its largest value)
+       *
+       * With a zero `step`, each region of interest gets its own scale.
+       */
+      CompactWire(
+        RegionsOfInterest_t const& sigROIlist,
+        raw::ChannelID_t channel,
+        geo::View_t view,
+        float step = 0.0f
+        );
+
+      /// Constructor: quantizes the signal of the specified wire.
+      explicit CompactWire(recob::Wire const& wire, float step = 0.0f);
+
+
+      // --- BEGIN -- Accessors ------------------------------------------------
+      ///@name Accessors
+      ///@{
+
+      /// Return a zero-padded full length vector filled with RoI signal
+      std::vector<float>          Signal()     const;
+
+      /// Returns the list of regions of interest, converted to `float`
+      RegionsOfInterest_t         SignalROI()  const;
+
+      /// Returns the compact regions of interest
+      std::vector<CompactROI> const& ROIs()    const;
+
+      /// Returns the number of time ticks, or samples, in the channel
+      std::size_t                 NSignal()    const;
+
+      /// Returns the view the channel belongs to
+      geo::View_t                 View()       const;
+
+      /// Returns the ID of the channel (or InvalidChannelID)
+      raw::ChannelID_t            Channel()    const;
+
+      /// Returns a `recob::Wire` with this content, converted to `float`
+      recob::Wire                 MakeWire()   const;
+
+      ///@}
+      // --- END -- Accessors --------------------------------------------------
+
+
+      /// Returns whether this channel ID is smaller than the other
+      bool operator< (const CompactWire& than) const;
+
+
+    private:
+      raw::ChannelID_t        fChannel; ///< ID of the associated channel.
+      geo::View_t             fView;    ///< View of the plane of this wire.
+      unsigned int            fNSignal; ///< Number of ticks in the waveform.
+      std::vector<CompactROI> fROIs;    ///< Signal regions of interest.
+
+  }; // class CompactWire
+
+} // namespace recob
+
+
+//------------------------------------------------------------------------------
+//--- inline implementation
+//------------------------------------------------------------------------------
+inline std::vector<recob::CompactROI> const&
+                             recob::CompactWire::ROIs()     const { return fROIs;    }
+inline std::size_t           recob::CompactWire::NSignal()  const { return fNSignal; }
+inline geo::View_t           recob::CompactWire::View()     const { return fView;    }
+inline raw::ChannelID_t      recob::CompactWire::Channel()  const { return fChannel; }
+inline bool                  recob::CompactWire::operator< (const CompactWire& than) const
+  { return Channel() < than.Channel(); }
+
+//------------------------------------------------------------------------------
+
+
+#endif // LARDATAOBJ_RECOBASE_COMPACTWIRE_H
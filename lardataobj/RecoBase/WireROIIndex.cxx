@@ -0,0 +1,163 @@
+/** ****************************************************************************
+ * @file WireROIIndex.cxx
+ * @brief Event-wide index of the regions of interest of `recob::Wire` objects.
+ * @see  WireROIIndex.h
+ *
+ * ****************************************************************************/
+
+#include "lardataobj/RecoBase/WireROIIndex.h"
+
+// C/C++ standard libraries
+#include <algorithm> // std::sort(), std::max(), std::unique()
+#include <cstdint> // std::int64_t
+
+namespace recob{
+
+  //----------------------------------------------------------------------
+  WireROIIndex::WireROIIndex(std::vector<recob::Wire> const& wires)
+    : fWires(&wires)
+  {
+    std::size_t nROIs = 0;
+    for (recob::Wire const& wire: wires) nROIs += wire.SignalROI().n_ranges();
+
+    fNodes.reserve(nROIs);
+    fChannels.reserve(wires.size());
+    for (std::size_t iWire = 0; iWire < wires.size(); ++iWire) {
+      auto const& ranges = wires[iWire].SignalROI().get_ranges();
+      for (std::size_t iRange = 0; iRange < ranges.size(); ++iRange) {
+        Tick_t const end = ranges[iRange].end_index();
+        fNodes.push_back
+          ({ ranges[iRange].begin_index(), end, end, { iWire, iRange } });
+      }
+      fChannels.emplace_back(wires[iWire].Channel(), iWire);
+    } // for wires
+
+    std::sort(fNodes.begin(), fNodes.end(),
+      [](Node_t const& a, Node_t const& b){ return a.begin < b.begin; });
+    std::sort(fChannels.begin(), fChannels.end());
+
+    fRootLevel = BuildTree();
+  } // WireROIIndex::WireROIIndex()
+
+
+  //----------------------------------------------------------------------
+  int WireROIIndex::BuildTree() {
+    //
+    // The nodes sorted by start tick are the in-order visit of a binary tree:
+    // nodes at level k have the k lowest bits of their position set to 1
+    // (leaves are at even positions), and the children of the node at
+    // position x of level k are at x -/+ 2^(k-1). The tree is "complete" in
+    // size, so some right children are beyond the end of the array; for those,
+    // the largest end is the one of the last node (`lastMax`).
+    //
+    std::int64_t const n = fNodes.size();
+    if (n == 0) return -1;
+
+    std::int64_t lastIndex = 0;
+    Tick_t lastMax = 0;
+    for (std::int64_t i = 0; i < n; i += 2) {
+      lastIndex = i;
+      lastMax = fNodes[i].maxEnd = fNodes[i].end;
+    }
+
+    int k = 1;
+    for (; (std::int64_t(1) << k) <= n; ++k) {
+      std::int64_t const x = std::int64_t(1) << (k - 1);
+      std::int64_t const step = x << 2;
+      for (std::int64_t i = (x << 1) - 1; i < n; i += step) {
+        Tick_t const leftMax = fNodes[i - x].maxEnd;
+        Tick_t const rightMax = (i + x < n)? fNodes[i + x].maxEnd: lastMax;
+        fNodes[i].maxEnd = std::max({ fNodes[i].end, leftMax, rightMax });
+      }
+      // move lastIndex to its parent (it is a right child if bit k is set)
+      lastIndex = ((lastIndex >> k) & 1)? lastIndex - x: lastIndex + x;
+      if ((lastIndex < n) && (fNodes[lastIndex].maxEnd > lastMax))
+        lastMax = fNodes[lastIndex].maxEnd;
+    } // for levels
+    return k - 1;
+  } // WireROIIndex::BuildTree()
+
+
+  //----------------------------------------------------------------------
+  auto WireROIIndex::ROIsOverlapping(Tick_t t0, Tick_t t1) const
+    -> std::vector<ROIRef_t>
+  {
+    std::vector<ROIRef_t> result;
+    if ((fRootLevel < 0) || (t1 <= t0)) return result;
+
+    std::int64_t const n = fNodes.size();
+    struct StackItem_t {
+      std::int64_t x;   ///< Node position.
+      int k;            ///< Node level.
+      bool leftDone;    ///< Whether the left subtree was already visited.
+    };
+    StackItem_t stack[64];
+    int top = 0;
+    stack[top++] = { (std::int64_t(1) << fRootLevel) - 1, fRootLevel, false };
+
+    while (top > 0) {
+      StackItem_t const z = stack[--top];
+      if (z.k <= 3) {
+        // small subtree: linear scan of all its nodes
+        std::int64_t const i0 = (z.x >> z.k) << z.k;
+        std::int64_t const i1
+          = std::min(i0 + (std::int64_t(1) << (z.k + 1)) - 1, n);
+        for (std::int64_t i = i0; (i < i1) && (fNodes[i].begin < t1); ++i)
+          if (t0 < fNodes[i].end) result.push_back(fNodes[i].ref);
+      }
+      else if (!z.leftDone) {
+        // come back to this node after the left subtree
+        std::int64_t const y = z.x - (std::int64_t(1) << (z.k - 1));
+        stack[top++] = { z.x, z.k, true };
+        if ((y >= n) || (fNodes[y].maxEnd > t0))
+          stack[top++] = { y, z.k - 1, false };
+      }
+      else if ((z.x < n) && (fNodes[z.x].begin < t1)) {
+        if (t0 < fNodes[z.x].end) result.push_back(fNodes[z.x].ref);
+        stack[top++] = { z.x + (std::int64_t(1) << (z.k - 1)), z.k - 1, false };
+      }
+    } // while
+    return result;
+  } // WireROIIndex::ROIsOverlapping()
+
+
+  //----------------------------------------------------------------------
+  std::vector<raw::ChannelID_t> WireROIIndex::ChannelsOverlapping
+    (Tick_t t0, Tick_t t1) const
+  {
+    std::vector<raw::ChannelID_t> channels;
+    for (ROIRef_t const& ref: ROIsOverlapping(t0, t1))
+      channels.push_back(GetWire(ref).Channel());
+    std::sort(channels.begin(), channels.end());
+    channels.erase(std::unique(channels.begin(), channels.end()), channels.end());
+    return channels;
+  } // WireROIIndex::ChannelsOverlapping()
+
+
+  //----------------------------------------------------------------------
+  auto WireROIIndex::ChannelROIsOverlapping
+    (raw::ChannelID_t channel, Tick_t t0, Tick_t t1) const
+    -> std::vector<ROIRef_t>
+  {
+    std::vector<ROIRef_t> result;
+    if (t1 <= t0) return result;
+
+    auto iChannel = std::lower_bound(fChannels.begin(), fChannels.end(),
+      std::make_pair(channel, std::size_t(0)));
+    for (; (iChannel != fChannels.end()) && (iChannel->first == channel);
+      ++iChannel)
+    {
+      std::size_t const iWire = iChannel->second;
+      auto const& ranges = (*fWires)[iWire].SignalROI().get_ranges();
+      // ranges are sorted and disjoint: their end ticks are sorted too
+      auto iRange = std::upper_bound(ranges.begin(), ranges.end(), t0,
+        [](Tick_t t, ROI_t const& r){ return t < r.end_index(); });
+      for (; (iRange != ranges.end()) && (iRange->begin_index() < t1); ++iRange)
+        result.push_back({ iWire, std::size_t(iRange - ranges.begin()) });
+    } // for wires on the channel
+    return result;
+  } // WireROIIndex::ChannelROIsOverlapping()
+
+
+}
+////////////////////////////////////////////////////////////////////////
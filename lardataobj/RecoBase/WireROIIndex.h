@@ -0,0 +1,164 @@
+/** ****************************************************************************
+ * @file lardataobj/RecoBase/WireROIIndex.h
+ * @brief Event-wide index of the regions of interest of `recob::Wire` objects.
+ * @see  lardataobj/RecoBase/WireROIIndex.cxx
+ *
+ * ****************************************************************************/
+
+#ifndef LARDATAOBJ_RECOBASE_WIREROIINDEX_H
+#define LARDATAOBJ_RECOBASE_WIREROIINDEX_H
+
+
+// LArSoft libraries
+#include "lardataobj/RecoBase/Wire.h"
+#include "larcoreobj/SimpleTypesAndConstants/RawTypes.h" // raw::ChannelID_t
+
+// C/C++ standard libraries
+#include <vector>
+#include <utility> // std::pair
+#include <cstddef> // std::size_t
+
+
+namespace recob {
+
+  /**
+   * @brief Index of the regions of interest of a collection of wires by time.
+   *
+   * The index is built from a `std::vector<recob::Wire>` and answers the
+   * questions:
+   * * which regions of interest (of any channel) overlap a tick window
+   *   [ `t0`, `t1` [ (`ROIsOverlapping()`)
+   * * which channels have signal in that window (`ChannelsOverlapping()`)
+   * * which regions of interest on a given channel overlap that window
+   *   (`ChannelROIsOverlapping()`)
+   *
+   * All the regions of interest of the collection are kept in a single array
+   * sorted by start tick, organized as an implicit, balanced binary tree where
+   * each node also records the largest end tick in its subtree (an "augmented"
+   * interval tree). A query costs O(log N + K), with N the total number of
+   * regions of interest and K the number of those overlapping the window.
+   * Queries on a single channel use the time ordering of its own regions.
+   *
+   * The index refers to the wires by their position in the collection, and it
+   * does not own them: the collection must outlive the index and must not be
+   * changed after the index is built.
+   *
+   * Example:
+   * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.cpp}
+   * recob::WireROIIndex const index { wires };
+   * for (recob::WireROIIndex::ROIRef_t const& ref: index.ROIsOverlapping(t0, t1)) {
+   *   recob::Wire const& wire = index.GetWire(ref);
+   *   auto const& ROI = index.GetROI(ref);
+   *   // ...
+   * }
+   * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+   */
+  class WireROIIndex {
+    public:
+      /// Type of tick number.
+      using Tick_t = recob::Wire::RegionsOfInterest_t::size_type;
+
+      /// Type of region of interest.
+      using ROI_t = recob::Wire::RegionsOfInterest_t::datarange_t;
+
+      /// Reference to a region of interest: wire and ROI numbers.
+      struct ROIRef_t {
+        std::size_t wire;  ///< Position of the wire in the collection.
+        std::size_t range; ///< Position of the ROI in the wire.
+
+        bool operator== (ROIRef_t const& other) const
+          { return (wire == other.wire) && (range == other.range); }
+        bool operator< (ROIRef_t const& other) const
+          {
+            return (wire == other.wire)
+              ? (range < other.range): (wire < other.wire);
+          }
+      }; // ROIRef_t
+
+      /// Constructor: indexes all the regions of interest in `wires`.
+      explicit WireROIIndex(std::vector<recob::Wire> const& wires);
+
+
+      // --- BEGIN -- Queries --------------------------------------------------
+      ///@name Queries
+      ///@{
+
+      /**
+       * @brief Returns all regions of interest overlapping a tick window.
+       * @param t0 first tick of the window
+       * @param t1 first tick after the window
+       * @return references to the overlapping ROI, sorted by start tick
+       */
+      std::vector<ROIRef_t> ROIsOverlapping(Tick_t t0, Tick_t t1) const;
+
+      /**
+       * @brief Returns the channels with signal overlapping a tick window.
+       * @param t0 first tick of the window
+       * @param t1 first tick after the window
+       * @return the channels with some ROI in the window, sorted and unique
+       */
+      std::vector<raw::ChannelID_t> ChannelsOverlapping(Tick_t t0, Tick_t t1) const;
+
+      /**
+       * @brief Returns the regions of interest of a channel overlapping a window.
+       * @param channel the channel to be queried
+       * @param t0 first tick of the window
+       * @param t1 first tick after the window
+       * @return references to the overlapping ROI, sorted by wire, then by
+       *         start tick
+       *
+       * If `channel` is not in the collection, the result is empty.
+       * If the channel appears on more than one wire, the ROI of each wire are
+       * listed one wire after the other, in the order of the collection.
+       */
+      std::vector<ROIRef_t> ChannelROIsOverlapping
+        (raw::ChannelID_t channel, Tick_t t0, Tick_t t1) const;
+
+      ///@}
+      // --- END -- Queries ----------------------------------------------------
+
+
+      // --- BEGIN -- Accessors ------------------------------------------------
+      ///@name Accessors
+      ///@{
+
+      /// Returns the wire pointed by the specified reference.
+      recob::Wire const& GetWire(ROIRef_t const& ref) const
+        { return (*fWires)[ref.wire]; }
+
+      /// Returns the region of interest pointed by the specified reference.
+      ROI_t const& GetROI(ROIRef_t const& ref) const
+        { return GetWire(ref).SignalROI().range(ref.range); }
+
+      /// Returns the total number of indexed regions of interest.
+      std::size_t NROIs() const { return fNodes.size(); }
+
+      ///@}
+      // --- END -- Accessors --------------------------------------------------
+
+
+    private:
+      /// A region of interest in the tree.
+      struct Node_t {
+        Tick_t begin;  ///< First tick of the ROI.
+        Tick_t end;    ///< First tick after the ROI.
+        Tick_t maxEnd; ///< Largest end tick in the subtree of this node.
+        ROIRef_t ref;  ///< The ROI this node describes.
+      }; // Node_t
+
+      std::vector<recob::Wire> const* fWires; ///< Indexed wires.
+      std::vector<Node_t> fNodes; ///< ROI sorted by start tick (implicit tree).
+      int fRootLevel = -1; ///< Level of the root of the tree (`-1` if empty).
+
+      /// Pairs (channel, wire position), sorted by channel.
+      std::vector<std::pair<raw::ChannelID_t, std::size_t>> fChannels;
+
+      /// Computes the largest end ticks of the subtrees; returns root level.
+      int BuildTree();
+
+  }; // class WireROIIndex
+
+} // namespace recob
+
+
+#endif // LARDATAOBJ_RECOBASE_WIREROIINDEX_H
@@ -91,13 +91,14 @@ namespace sim{
   std::pair<int,int> AuxDetSimChannel::MergeAuxDetSimChannel(const AuxDetSimChannel& chan,
 							     int offset)
   {
-    if(this->fAuxDetID != chan.AuxDetID() && this->fAuxDetSensitiveID != chan.AuxDetSensitiveID())
+    if(this->fAuxDetID != chan.AuxDetID() || this->fAuxDetSensitiveID != chan.AuxDetSensitiveID())
       throw std::runtime_error("ERROR AuxDetSimChannel Merge: Trying to merge different channels!");
 
     std::pair<int,int> range_trackID(std::numeric_limits<int>::max(),
 				     std::numeric_limits<int>::min());
 
-    for(auto const& ide : AuxDetIDEs()){
+    this->fAuxDetIDEs.reserve(this->fAuxDetIDEs.size() + chan.AuxDetIDEs().size());
+    for(auto const& ide : chan.AuxDetIDEs()){
       this->fAuxDetIDEs.emplace_back(ide,offset);
 
       if( ide.trackID+offset < range_trackID.first  )
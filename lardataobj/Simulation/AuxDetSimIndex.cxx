@@ -0,0 +1,213 @@
+////////////////////////////////////////////////////////////////////////
+///
+/// \file  Simulation/AuxDetSimIndex.cxx
+///
+/// \brief Indices of the auxiliary detector deposits by sensitive volume,
+///        time and track ID.
+///
+////////////////////////////////////////////////////////////////////////
+
+#include <algorithm> // std::stable_sort(), std::lower_bound()
+#include <utility> // std::pair
+
+#include "lardataobj/Simulation/AuxDetSimIndex.h"
+
+namespace {
+
+  /// An indexed element: its key, its entry time and its reference.
+  template <typename Key, typename Ref>
+  struct IndexEntry_t {
+    Key key;
+    float time;
+    Ref ref;
+  }; // IndexEntry_t
+
+
+  /// Sorts `entries` by key and time, and fills the arrays of the index.
+  template <typename Key, typename Ref>
+  void FillIndex(
+    std::vector<IndexEntry_t<Key, Ref>>& entries,
+    std::vector<Key>& keys, std::vector<std::size_t>& offsets,
+    std::vector<Ref>& refs, std::vector<float>* times
+  ) {
+    std::stable_sort(entries.begin(), entries.end(),
+      [](IndexEntry_t<Key, Ref> const& a, IndexEntry_t<Key, Ref> const& b)
+        { return (a.key != b.key)? (a.key < b.key): (a.time < b.time); }
+      );
+
+    refs.reserve(entries.size());
+    if (times) times->reserve(entries.size());
+    for (IndexEntry_t<Key, Ref> const& entry: entries) {
+      if (keys.empty() || (keys.back() != entry.key)) {
+        keys.push_back(entry.key);
+        offsets.push_back(refs.size());
+      }
+      refs.push_back(entry.ref);
+      if (times) times->push_back(entry.time);
+    } // for
+    offsets.push_back(refs.size());
+  } // FillIndex()
+
+
+  /// Returns the position of `key` in sorted `keys` (`keys.size()` if absent).
+  template <typename Key>
+  std::size_t FindKey(std::vector<Key> const& keys, Key key) {
+    auto const iKey = std::lower_bound(keys.begin(), keys.end(), key);
+    return ((iKey != keys.end()) && (*iKey == key))
+      ? (iKey - keys.begin()): keys.size();
+  } // FindKey()
+
+
+  /// Returns the positions in `[begin, end)` with time in `[start, stop)`.
+  std::pair<std::size_t, std::size_t> FindTimeRange(
+    std::vector<float> const& times, std::size_t begin, std::size_t end,
+    float start, float stop
+  ) {
+    auto const first = std::lower_bound
+      (times.begin() + begin, times.begin() + end, start);
+    auto const last = std::lower_bound(first, times.begin() + end, stop);
+    return { first - times.begin(), last - times.begin() };
+  } // FindTimeRange()
+
+} // local namespace
+
+
+namespace sim{
+
+  //-------------------------------------------------
+  AuxDetSimChannelIndex::AuxDetSimChannelIndex
+    (std::vector<sim::AuxDetSimChannel> const& channels)
+    : fChannels(&channels)
+  {
+    std::size_t nIDEs = 0;
+    for (sim::AuxDetSimChannel const& channel: channels)
+      nIDEs += channel.AuxDetIDEs().size();
+
+    std::vector<IndexEntry_t<std::uint64_t, IDERef_t>> volumeEntries;
+    std::vector<IndexEntry_t<TrackID_t, IDERef_t>> trackEntries;
+    volumeEntries.reserve(nIDEs);
+    trackEntries.reserve(nIDEs);
+    for (unsigned int iChannel = 0; iChannel < channels.size(); ++iChannel) {
+      sim::AuxDetSimChannel const& channel = channels[iChannel];
+      std::uint64_t const key
+        = VolumeKey(channel.AuxDetID(), channel.AuxDetSensitiveID());
+      std::vector<sim::AuxDetIDE> const& IDEs = channel.AuxDetIDEs();
+      for (unsigned int iIDE = 0; iIDE < IDEs.size(); ++iIDE) {
+        IDERef_t const ref { iChannel, iIDE };
+        volumeEntries.push_back({ key, IDEs[iIDE].entryT, ref });
+        trackEntries.push_back({ IDEs[iIDE].trackID, IDEs[iIDE].entryT, ref });
+      } // for IDEs
+    } // for channels
+
+    FillIndex(volumeEntries, fVolumes, fVolumeOffsets, fVolumeRefs, &fVolumeTimes);
+    FillIndex(trackEntries, fTrackIDs, fTrackOffsets, fTrackRefs, nullptr);
+  } // AuxDetSimChannelIndex::AuxDetSimChannelIndex()
+
+
+  //-------------------------------------------------
+  std::size_t AuxDetSimChannelIndex::FindVolume
+    (std::uint32_t auxDetID, std::uint32_t sensitiveID) const
+  {
+    return FindKey(fVolumes, VolumeKey(auxDetID, sensitiveID));
+  } // AuxDetSimChannelIndex::FindVolume()
+
+
+  //-------------------------------------------------
+  bool AuxDetSimChannelIndex::HasSensitiveVolume
+    (std::uint32_t auxDetID, std::uint32_t sensitiveID) const
+  {
+    return FindVolume(auxDetID, sensitiveID) < fVolumes.size();
+  } // AuxDetSimChannelIndex::HasSensitiveVolume()
+
+
+  //-------------------------------------------------
+  AuxDetSimChannelIndex::IDERefs_t AuxDetSimChannelIndex::IDEs
+    (std::uint32_t auxDetID, std::uint32_t sensitiveID) const
+  {
+    std::size_t const iVolume = FindVolume(auxDetID, sensitiveID);
+    if (iVolume >= fVolumes.size()) return { nullptr, nullptr };
+    IDERef_t const* refs = fVolumeRefs.data();
+    return
+      { refs + fVolumeOffsets[iVolume], refs + fVolumeOffsets[iVolume + 1] };
+  } // AuxDetSimChannelIndex::IDEs()
+
+
+  //-------------------------------------------------
+  AuxDetSimChannelIndex::IDERefs_t AuxDetSimChannelIndex::IDEs(
+    std::uint32_t auxDetID, std::uint32_t sensitiveID,
+    float startTime, float endTime
+  ) const {
+    std::size_t const iVolume = FindVolume(auxDetID, sensitiveID);
+    if (iVolume >= fVolumes.size()) return { nullptr, nullptr };
+    auto const [ first, last ] = FindTimeRange(fVolumeTimes,
+      fVolumeOffsets[iVolume], fVolumeOffsets[iVolume + 1], startTime, endTime);
+    IDERef_t const* refs = fVolumeRefs.data();
+    return { refs + first, refs + last };
+  } // AuxDetSimChannelIndex::IDEs()
+
+
+  //-------------------------------------------------
+  AuxDetSimChannelIndex::IDERefs_t AuxDetSimChannelIndex::TrackIDEs
+    (TrackID_t trackID) const
+  {
+    std::size_t const iTrack = FindKey(fTrackIDs, trackID);
+    if (iTrack >= fTrackIDs.size()) return { nullptr, nullptr };
+    IDERef_t const* refs = fTrackRefs.data();
+    return { refs + fTrackOffsets[iTrack], refs + fTrackOffsets[iTrack + 1] };
+  } // AuxDetSimChannelIndex::TrackIDEs()
+
+
+  //-------------------------------------------------
+  AuxDetHitIndex::AuxDetHitIndex(sim::AuxDetHitCollection const& hits)
+    : fHits(&hits)
+  {
+    std::vector<IndexEntry_t<unsigned int, unsigned int>> IDEntries;
+    std::vector<IndexEntry_t<TrackID_t, unsigned int>> trackEntries;
+    IDEntries.reserve(hits.size());
+    trackEntries.reserve(hits.size());
+    for (unsigned int iHit = 0; iHit < hits.size(); ++iHit) {
+      sim::AuxDetHit const& hit = hits[iHit];
+      IDEntries.push_back({ hit.GetID(), hit.GetEntryT(), iHit });
+      trackEntries.push_back({ hit.GetTrackID(), hit.GetEntryT(), iHit });
+    } // for
+
+    FillIndex(IDEntries, fIDs, fIDOffsets, fIDRefs, &fIDTimes);
+    FillIndex(trackEntries, fTrackIDs, fTrackOffsets, fTrackRefs, nullptr);
+  } // AuxDetHitIndex::AuxDetHitIndex()
+
+
+  //-------------------------------------------------
+  AuxDetHitIndex::HitRefs_t AuxDetHitIndex::Hits(unsigned int ID) const
+  {
+    std::size_t const iID = FindKey(fIDs, ID);
+    if (iID >= fIDs.size()) return { nullptr, nullptr };
+    unsigned int const* refs = fIDRefs.data();
+    return { refs + fIDOffsets[iID], refs + fIDOffsets[iID + 1] };
+  } // AuxDetHitIndex::Hits()
+
+
+  //-------------------------------------------------
+  AuxDetHitIndex::HitRefs_t AuxDetHitIndex::Hits
+    (unsigned int ID, float startTime, float endTime) const
+  {
+    std::size_t const iID = FindKey(fIDs, ID);
+    if (iID >= fIDs.size()) return { nullptr, nullptr };
+    auto const [ first, last ] = FindTimeRange
+      (fIDTimes, fIDOffsets[iID], fIDOffsets[iID + 1], startTime, endTime);
+    unsigned int const* refs = fIDRefs.data();
+    return { refs + first, refs + last };
+  } // AuxDetHitIndex::Hits()
+
+
+  //-------------------------------------------------
+  AuxDetHitIndex::HitRefs_t AuxDetHitIndex::TrackHits(TrackID_t trackID) const
+  {
+    std::size_t const iTrack = FindKey(fTrackIDs, trackID);
+    if (iTrack >= fTrackIDs.size()) return { nullptr, nullptr };
+    unsigned int const* refs = fTrackRefs.data();
+    return { refs + fTrackOffsets[iTrack], refs + fTrackOffsets[iTrack + 1] };
+  } // AuxDetHitIndex::TrackHits()
+
+
+}
+////////////////////////////////////////////////////////////////////////
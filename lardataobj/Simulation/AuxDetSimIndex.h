@@ -0,0 +1,237 @@
+/**
+ * @file   lardataobj/Simulation/AuxDetSimIndex.h
+ * @brief  Indices of the auxiliary detector deposits by sensitive volume,
+ *         time and track ID.
+ * @see    lardataobj/Simulation/AuxDetSimIndex.cxx
+ */
+
+#ifndef LARDATAOBJ_SIMULATION_AUXDETSIMINDEX_H
+#define LARDATAOBJ_SIMULATION_AUXDETSIMINDEX_H
+
+// LArSoftObj libraries
+#include "lardataobj/Simulation/AuxDetSimChannel.h"
+#include "lardataobj/Simulation/AuxDetHit.h"
+#include "lardataobj/Utilities/IteratorRange.h"
+
+// C/C++ standard libraries
+#include <vector>
+#include <cstddef> // std::size_t
+#include <cstdint> // std::uint32_t, std::uint64_t
+
+
+namespace sim {
+
+  /**
+   * @brief Index of the deposits of a `sim::AuxDetSimChannel` collection.
+   *
+   * The index is built from a `std::vector<sim::AuxDetSimChannel>`, and it
+   * answers without linear scans:
+   *
+   * * which deposits (`sim::AuxDetIDE`) are in a sensitive volume, identified
+   *   by auxiliary detector ID and sensitive volume ID, sorted by entry time,
+   *   and within a time interval (`IDEs()`);
+   * * which deposits belong to a Geant4 track (`TrackIDEs()`).
+   *
+   * The deposits are returned as references to their position in the
+   * collection, stored in single arrays (compressed sparse row format).
+   * If more than one channel has the same IDs, their deposits are merged.
+   *
+   * The index does not own the channels: the collection must outlive the
+   * index and must not be changed after the index is built.
+   *
+   * Example:
+   * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.cpp}
+   * sim::AuxDetSimChannelIndex const index { auxDetSimChannels };
+   * for (auto const& ref: index.IDEs(auxDetID, sensitiveID, t0, t1)) {
+   *   sim::AuxDetIDE const& ide = index.GetIDE(ref);
+   *   // ...
+   * }
+   * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+   */
+  class AuxDetSimChannelIndex {
+  public:
+    using TrackID_t = int; ///< Type of track ID (as in `sim::AuxDetIDE`).
+
+    /// Reference to a deposit: positions of channel and IDE.
+    struct IDERef_t {
+      unsigned int channel; ///< Position of the channel in the collection.
+      unsigned int ide;     ///< Position of the IDE in the channel.
+    }; // IDERef_t
+
+    /// Sequence of references to deposits.
+    using IDERefs_t = util::IteratorRange<IDERef_t const*>;
+
+
+    /// Constructor: indexes all the deposits in `channels`.
+    explicit AuxDetSimChannelIndex
+      (std::vector<sim::AuxDetSimChannel> const& channels);
+
+
+    // --- BEGIN -- Queries --------------------------------------------------
+    ///@name Queries
+    ///@{
+
+    /// Returns the number of sensitive volumes with deposits.
+    std::size_t NSensitiveVolumes() const { return fVolumes.size(); }
+
+    /// Returns whether the sensitive volume has any deposit.
+    bool HasSensitiveVolume
+      (std::uint32_t auxDetID, std::uint32_t sensitiveID) const;
+
+    /// Returns all the deposits in the sensitive volume, by entry time.
+    IDERefs_t IDEs(std::uint32_t auxDetID, std::uint32_t sensitiveID) const;
+
+    /**
+     * @brief Returns the deposits in the sensitive volume within a time range.
+     * @param auxDetID ID of the auxiliary detector
+     * @param sensitiveID ID of the sensitive volume in the detector
+     * @param startTime the earliest entry time to be included
+     * @param endTime the first entry time not to be included
+     * @return the deposits with entry time in `[startTime, endTime)`, sorted
+     */
+    IDERefs_t IDEs(
+      std::uint32_t auxDetID, std::uint32_t sensitiveID,
+      float startTime, float endTime
+      ) const;
+
+    /// Returns the IDs of all the tracks with deposits, sorted.
+    std::vector<TrackID_t> const& TrackIDs() const { return fTrackIDs; }
+
+    /// Returns all the deposits of the track, by entry time.
+    IDERefs_t TrackIDEs(TrackID_t trackID) const;
+
+    ///@}
+    // --- END -- Queries ----------------------------------------------------
+
+
+    // --- BEGIN -- Accessors ------------------------------------------------
+    ///@name Accessors
+    ///@{
+
+    /// Returns the channel of the referenced deposit.
+    sim::AuxDetSimChannel const& GetChannel(IDERef_t const& ref) const
+      { return (*fChannels)[ref.channel]; }
+
+    /// Returns the referenced deposit.
+    sim::AuxDetIDE const& GetIDE(IDERef_t const& ref) const
+      { return GetChannel(ref).AuxDetIDEs()[ref.ide]; }
+
+    ///@}
+    // --- END -- Accessors --------------------------------------------------
+
+
+  private:
+    /// Indexed channels.
+    std::vector<sim::AuxDetSimChannel> const* fChannels;
+
+    /// Sorted keys of the sensitive volumes (see `VolumeKey()`).
+    std::vector<std::uint64_t> fVolumes;
+
+    /// Deposits of volume `fVolumes[i]` start at `fVolumeRefs[fVolumeOffsets[i]]`.
+    std::vector<std::size_t> fVolumeOffsets;
+
+    std::vector<IDERef_t> fVolumeRefs; ///< Deposits, by volume and time.
+
+    std::vector<float> fVolumeTimes; ///< Entry time of each of `fVolumeRefs`.
+
+    std::vector<TrackID_t> fTrackIDs; ///< Sorted IDs of the tracks.
+
+    /// Deposits of track `fTrackIDs[i]` start at `fTrackRefs[fTrackOffsets[i]]`.
+    std::vector<std::size_t> fTrackOffsets;
+
+    std::vector<IDERef_t> fTrackRefs; ///< Deposits, grouped by track.
+
+    /// Returns the key of a sensitive volume.
+    static std::uint64_t VolumeKey
+      (std::uint32_t auxDetID, std::uint32_t sensitiveID)
+      { return (std::uint64_t(auxDetID) << 32) | sensitiveID; }
+
+    /// Returns the position of the volume in `fVolumes` (or its size).
+    std::size_t FindVolume
+      (std::uint32_t auxDetID, std::uint32_t sensitiveID) const;
+
+  }; // class AuxDetSimChannelIndex
+
+
+  /**
+   * @brief Index of a `sim::AuxDetHitCollection`.
+   *
+   * This is the equivalent of `sim::AuxDetSimChannelIndex` for the hits.
+   * The hits are identified only by the Geant4 copy ID of their volume
+   * (`sim::AuxDetHit::GetID()`), which is the key of the index.
+   * The index answers without linear scans:
+   *
+   * * which hits are in a volume, sorted by entry time, and within a time
+   *   interval (`Hits()`);
+   * * which hits belong to a Geant4 track (`TrackHits()`).
+   *
+   * Hits are returned as their positions in the collection, which must
+   * outlive the index and must not be changed after the index is built.
+   */
+  class AuxDetHitIndex {
+  public:
+    using TrackID_t = unsigned int; ///< Type of track ID (as in `sim::AuxDetHit`).
+
+    /// Sequence of positions of hits in the collection.
+    using HitRefs_t = util::IteratorRange<unsigned int const*>;
+
+
+    /// Constructor: indexes all the hits in `hits`.
+    explicit AuxDetHitIndex(sim::AuxDetHitCollection const& hits);
+
+
+    // --- BEGIN -- Queries --------------------------------------------------
+    ///@name Queries
+    ///@{
+
+    /// Returns the copy IDs of all the volumes with hits, sorted.
+    std::vector<unsigned int> const& IDs() const { return fIDs; }
+
+    /// Returns all the hits in the volume, by entry time.
+    HitRefs_t Hits(unsigned int ID) const;
+
+    /// Returns the hits in the volume with entry time in `[startTime, endTime)`.
+    HitRefs_t Hits(unsigned int ID, float startTime, float endTime) const;
+
+    /// Returns the IDs of all the tracks with hits, sorted.
+    std::vector<TrackID_t> const& TrackIDs() const { return fTrackIDs; }
+
+    /// Returns all the hits of the track, by entry time.
+    HitRefs_t TrackHits(TrackID_t trackID) const;
+
+    ///@}
+    // --- END -- Queries ----------------------------------------------------
+
+
+    /// Returns the hit at the specified position.
+    sim::AuxDetHit const& GetHit(unsigned int ref) const
+      { return (*fHits)[ref]; }
+
+
+  private:
+    sim::AuxDetHitCollection const* fHits; ///< Indexed hits.
+
+    std::vector<unsigned int> fIDs; ///< Sorted copy IDs of the volumes.
+
+    /// Hits of volume `fIDs[i]` start at `fIDRefs[fIDOffsets[i]]`.
+    std::vector<std::size_t> fIDOffsets;
+
+    std::vector<unsigned int> fIDRefs; ///< Hits, by volume and time.
+
+    std::vector<float> fIDTimes; ///< Entry time of each of `fIDRefs`.
+
+    std::vector<TrackID_t> fTrackIDs; ///< Sorted IDs of the tracks.
+
+    /// Hits of track `fTrackIDs[i]` start at `fTrackRefs[fTrackOffsets[i]]`.
+    std::vector<std::size_t> fTrackOffsets;
+
+    std::vector<unsigned int> fTrackRefs; ///< Hits, grouped by track.
+
+  }; // class AuxDetHitIndex
+
+} // namespace sim
+
+
+#endif // LARDATAOBJ_SIMULATION_AUXDETSIMINDEX_H
+
+////////////////////////////////////////////////////////////////////////
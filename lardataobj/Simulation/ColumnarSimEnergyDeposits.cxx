@@ -0,0 +1,109 @@
+///
+/// \file  Simulation/ColumnarSimEnergyDeposits.cxx
+///
+/// \brief Energy deposits stored as one array per quantity, with voxel index.
+///
+////////////////////////////////////////////////////////////////////////
+
+#include <cmath> // std::floor()
+
+#include "lardataobj/Simulation/ColumnarSimEnergyDeposits.h"
+#include "lardataobj/Utilities/ApplyOrder.h"
+
+namespace sim{
+
+  //-------------------------------------------------
+  auto ColumnarSimEnergyDeposits::VoxelGrid_t::VoxelOf
+    (float x, float y, float z) const -> size_type
+  {
+    float const pos[3] = { x, y, z };
+    unsigned int index[3];
+    for (int i = 0; i < 3; ++i) {
+      float const cell = std::floor((pos[i] - lower[i]) / size[i]);
+      // also rejects NaN
+      if (!((cell >= 0.f) && (cell < static_cast<float>(n[i]))))
+        return NVoxels();
+      index[i] = static_cast<unsigned int>(cell);
+    }
+    return VoxelID(index[0], index[1], index[2]);
+  } // ColumnarSimEnergyDeposits::VoxelGrid_t::VoxelOf()
+
+
+  //-------------------------------------------------
+  ColumnarSimEnergyDeposits::ColumnarSimEnergyDeposits
+    (sim::SimEnergyDepositCollection const& deposits)
+  {
+    size_type const n = deposits.size();
+    fX.reserve(n);
+    fY.reserve(n);
+    fZ.reserve(n);
+    fT.reserve(n);
+    fEnergy.reserve(n);
+    fNumElectrons.reserve(n);
+    fNumPhotons.reserve(n);
+    fScintYieldRatio.reserve(n);
+    fTrackID.reserve(n);
+    fPdgCode.reserve(n);
+
+    for (sim::SimEnergyDeposit const& dep: deposits) {
+      fX.push_back(dep.MidPointX());
+      fY.push_back(dep.MidPointY());
+      fZ.push_back(dep.MidPointZ());
+      fT.push_back(dep.Time());
+      fEnergy.push_back(dep.Energy());
+      fNumElectrons.push_back(dep.NumElectrons());
+      fNumPhotons.push_back(dep.NumPhotons());
+      fScintYieldRatio.push_back(dep.ScintYieldRatio());
+      fTrackID.push_back(dep.TrackID());
+      fPdgCode.push_back(dep.PdgCode());
+    } // for
+  } // ColumnarSimEnergyDeposits::ColumnarSimEnergyDeposits()
+
+
+  //-------------------------------------------------
+  void ColumnarSimEnergyDeposits::BuildVoxelIndex(VoxelGrid_t const& grid)
+  {
+    fGrid = grid;
+    size_type const nVoxels = fGrid.NVoxels();
+
+    // counting sort by cell; the last "cell" collects deposits out of the grid
+    std::vector<size_type> voxelIDs;
+    voxelIDs.reserve(size());
+    std::vector<size_type> counts(nVoxels + 1, 0);
+    for (size_type i = 0; i < size(); ++i) {
+      size_type const voxelID = fGrid.VoxelOf(fX[i], fY[i], fZ[i]);
+      voxelIDs.push_back(voxelID);
+      ++counts[voxelID];
+    } // for
+
+    fVoxelOffsets.resize(nVoxels + 2);
+    fVoxelOffsets[0] = 0;
+    for (size_type i = 0; i <= nVoxels; ++i)
+      fVoxelOffsets[i + 1] = fVoxelOffsets[i] + counts[i];
+
+    // deposits are placed in their original order, even if already reordered
+    std::vector<size_type> byOriginal(size());
+    for (size_type i = 0; i < size(); ++i) byOriginal[OriginalIndex(i)] = i;
+
+    std::vector<size_type> order(size());
+    std::vector<size_type> next(fVoxelOffsets.begin(), fVoxelOffsets.end() - 1);
+    for (size_type i: byOriginal) order[next[voxelIDs[i]]++] = i;
+
+    if (fOriginalIndex.empty()) fOriginalIndex = order;
+    else util::applyOrder(fOriginalIndex, order);
+    util::applyOrder(fX, order);
+    util::applyOrder(fY, order);
+    util::applyOrder(fZ, order);
+    util::applyOrder(fT, order);
+    util::applyOrder(fEnergy, order);
+    util::applyOrder(fNumElectrons, order);
+    util::applyOrder(fNumPhotons, order);
+    util::applyOrder(fScintYieldRatio, order);
+    util::applyOrder(fTrackID, order);
+    util::applyOrder(fPdgCode, order);
+
+  } // ColumnarSimEnergyDeposits::BuildVoxelIndex()
+
+
+}
+////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,206 @@
+/**
+ * @file   lardataobj/Simulation/ColumnarSimEnergyDeposits.h
+ * @brief  Energy deposits stored as one array per quantity, with voxel index.
+ * @see    lardataobj/Simulation/ColumnarSimEnergyDeposits.cxx
+ */
+
+#ifndef LARDATAOBJ_SIMULATION_COLUMNARSIMENERGYDEPOSITS_H
+#define LARDATAOBJ_SIMULATION_COLUMNARSIMENERGYDEPOSITS_H
+
+// LArSoftObj libraries
+#include "lardataobj/Simulation/SimEnergyDeposit.h"
+
+// C/C++ standard libraries
+#include <vector>
+#include <utility> // std::pair
+#include <cstddef> // std::size_t
+
+
+namespace sim {
+
+  /**
+   * @brief Energy deposits stored as one array per quantity.
+   *
+   * This container holds the information of a `sim::SimEnergyDepositCollection`
+   * needed by the simulation of the ionization drift and of the scintillation
+   * light, as a "structure of arrays": the middle point of the step (x, y,
+   * z), its time, the deposited energy, the numbers of electrons and photons,
+   * the scintillation yield ratio, the track ID and the PDG code each have
+   * their own array.
+   * A loop on a quantity of all deposits reads contiguous memory, which the
+   * compiler can vectorize.
+   *
+   * The start and end points of the steps are not kept, and the conversion
+   * works only from `sim::SimEnergyDepositCollection`.
+   *
+   * Voxel index
+   * ------------
+   *
+   * `BuildVoxelIndex()` sorts the deposits by the cell of a regular grid
+   * they fall in, so that the deposits of each cell are contiguous in all the
+   * arrays; `VoxelDeposits()` returns the range of their indices.
+   * Deposits out of the grid are placed after all the others
+   * (`OutsideDeposits()`). The order of the deposits within a cell is the
+   * original one, and `OriginalIndex()` returns the position of a deposit in
+   * the original collection.
+   *
+   * A grid with only one cell in _y_ and _z_ divides the detector in slabs
+   * along the drift direction _x_:
+   * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.cpp}
+   * sim::ColumnarSimEnergyDeposits deposits { simEnergyDeposits };
+   * deposits.BuildVoxelIndex({
+   *   { xMin, yMin, zMin },                    // lower corner
+   *   { slabWidth, yMax - yMin, zMax - zMin }, // size of a cell
+   *   { nSlabs, 1, 1 }                         // number of cells
+   * });
+   * for (unsigned int iSlab = 0; iSlab < nSlabs; ++iSlab) {
+   *   auto const [ begin, end ] = deposits.VoxelDeposits(iSlab);
+   *   for (std::size_t i = begin; i < end; ++i) {
+   *     // use deposits.X()[i], deposits.NumElectrons()[i] ...
+   *   }
+   * }
+   * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+   */
+  class ColumnarSimEnergyDeposits {
+  public:
+    using size_type = std::size_t;
+
+    /// Range of deposit indices: `[ first, second [`.
+    using IndexRange_t = std::pair<size_type, size_type>;
+
+    /// Definition of a regular grid of cells (voxels).
+    struct VoxelGrid_t {
+      float lower[3];   ///< Lower corner of the grid [cm]
+      float size[3];    ///< Size of a cell on each direction [cm]
+      unsigned int n[3]; ///< Number of cells on each direction.
+
+      /// Returns the total number of cells.
+      size_type NVoxels() const
+        { return size_type(n[0]) * n[1] * n[2]; }
+
+      /// Returns the ID of the cell with the specified indices.
+      size_type VoxelID(unsigned int ix, unsigned int iy, unsigned int iz) const
+        { return (size_type(iz) * n[1] + iy) * n[0] + ix; }
+
+      /// Returns the ID of the cell containing the point (`NVoxels()` if none).
+      size_type VoxelOf(float x, float y, float z) const;
+    }; // VoxelGrid_t
+
+
+    /// Constructor: an empty container.
+    ColumnarSimEnergyDeposits() = default;
+
+    /// Constructor: copies the content of `deposits`, in the same order.
+    explicit ColumnarSimEnergyDeposits(sim::SimEnergyDepositCollection const& deposits);
+
+
+    // --- BEGIN -- Accessors ------------------------------------------------
+    ///@name Accessors
+    ///@{
+
+    /// Returns the number of deposits.
+    size_type size() const { return fX.size(); }
+
+    /// Returns whether there are no deposits.
+    bool empty() const { return fX.empty(); }
+
+    /// Middle point of the steps, x coordinate [cm]
+    std::vector<float> const& X() const { return fX; }
+    /// Middle point of the steps, y coordinate [cm]
+    std::vector<float> const& Y() const { return fY; }
+    /// Middle point of the steps, z coordinate [cm]
+    std::vector<float> const& Z() const { return fZ; }
+    /// Time of the middle of the steps [ns]
+    std::vector<double> const& T() const { return fT; }
+    /// Energy deposited in each step [MeV]
+    std::vector<float> const& Energy() const { return fEnergy; }
+    /// Number of ionization electrons of each step.
+    std::vector<int> const& NumElectrons() const { return fNumElectrons; }
+    /// Number of scintillation photons of each step.
+    std::vector<int> const& NumPhotons() const { return fNumPhotons; }
+    /// Scintillation yield ratio (fast component) of each step.
+    std::vector<float> const& ScintYieldRatio() const { return fScintYieldRatio; }
+    /// Simulation track ID of each step.
+    std::vector<int> const& TrackID() const { return fTrackID; }
+    /// PDG code of the particle of each step.
+    std::vector<int> const& PdgCode() const { return fPdgCode; }
+
+    /// Returns the position of deposit `i` in the original collection.
+    size_type OriginalIndex(size_type i) const
+      { return fOriginalIndex.empty()? i: fOriginalIndex[i]; }
+
+    ///@}
+    // --- END -- Accessors --------------------------------------------------
+
+
+    // --- BEGIN -- Voxel index ----------------------------------------------
+    ///@name Voxel index
+    ///@{
+
+    /**
+     * @brief Sorts the deposits by cell of `grid`.
+     * @param grid the definition of the cells
+     *
+     * Any previous index is replaced; the deposits in each cell are still in
+     * their order in the original collection.
+     */
+    void BuildVoxelIndex(VoxelGrid_t const& grid);
+
+    /// Returns whether the voxel index is present.
+    bool HasVoxelIndex() const { return !fVoxelOffsets.empty(); }
+
+    /// Returns the grid of the voxel index.
+    VoxelGrid_t const& VoxelGrid() const { return fGrid; }
+
+    /**
+     * @brief Returns the range of the deposits in the cell with the specified ID.
+     * @param voxelID ID of the cell (`VoxelGrid().NVoxels()` for the outside)
+     * @return the range of deposit indices, empty if there is no voxel index
+     */
+    IndexRange_t VoxelDeposits(size_type voxelID) const
+      {
+        if (!HasVoxelIndex()) return { 0, 0 };
+        return { fVoxelOffsets[voxelID], fVoxelOffsets[voxelID + 1] };
+      }
+
+    /// Returns the range of the deposits in the cell with the specified indices.
+    IndexRange_t VoxelDeposits
+      (unsigned int ix, unsigned int iy, unsigned int iz) const
+      { return VoxelDeposits(fGrid.VoxelID(ix, iy, iz)); }
+
+    /// Returns the range of the deposits not in any cell (empty if no index).
+    IndexRange_t OutsideDeposits() const
+      { return VoxelDeposits(fGrid.NVoxels()); }
+
+    ///@}
+    // --- END -- Voxel index ------------------------------------------------
+
+
+  private:
+    std::vector<float> fX; ///< x of step middle point [cm]
+    std::vector<float> fY; ///< y of step middle point [cm]
+    std::vector<float> fZ; ///< z of step middle point [cm]
+    std::vector<double> fT; ///< Time of step middle point [ns]
+    std::vector<float> fEnergy; ///< Deposited energy [MeV]
+    std::vector<int> fNumElectrons; ///< Ionization electrons.
+    std::vector<int> fNumPhotons; ///< Scintillation photons.
+    std::vector<float> fScintYieldRatio; ///< Scintillation yield ratio.
+    std::vector<int> fTrackID; ///< Simulation track ID.
+    std::vector<int> fPdgCode; ///< PDG code of the particle.
+
+    /// Position in the original collection (empty if never reordered).
+    std::vector<size_type> fOriginalIndex;
+
+    VoxelGrid_t fGrid {}; ///< Grid of the voxel index.
+
+    /// Deposits of cell `i` are from `fVoxelOffsets[i]` to `fVoxelOffsets[i+1]`.
+    std::vector<size_type> fVoxelOffsets;
+
+  }; // class ColumnarSimEnergyDeposits
+
+} // namespace sim
+
+
+#endif // LARDATAOBJ_SIMULATION_COLUMNARSIMENERGYDEPOSITS_H
+
+////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,166 @@
+///
+/// \file  Simulation/CompactSimChannel.cxx
+///
+/// \brief Compact storage of the energy deposits on a readout channel.
+///
+////////////////////////////////////////////////////////////////////////
+
+#include <algorithm> // std::min(), std::max()
+#include <cmath> // std::lround()
+#include <limits> // std::numeric_limits
+
+#include "lardataobj/Simulation/CompactSimChannel.h"
+
+namespace sim{
+
+  //-------------------------------------------------
+  CompactSimChannel::CompactSimChannel()
+    : fChannel(raw::InvalidChannelID)
+    , fPackOrigin{ 0.f, 0.f, 0.f }
+    , fPackStep{ 0.f, 0.f, 0.f }
+  {}
+
+  //-------------------------------------------------
+  CompactSimChannel::CompactSimChannel
+    (sim::SimChannel const& channel, bool packPositions /* = false */)
+    : fChannel(channel.Channel())
+    , fPackOrigin{ 0.f, 0.f, 0.f }
+    , fPackStep{ 0.f, 0.f, 0.f }
+  {
+    auto const& TDCIDEs = channel.TDCIDEMap();
+
+    std::size_t nIDEs = 0;
+    for (auto const& TDCinfo: TDCIDEs) nIDEs += TDCinfo.second.size();
+
+    fTDCDeltas.reserve(TDCIDEs.size());
+    fIDEOffsets.reserve(TDCIDEs.size() + 1);
+    fTrackIDs.reserve(nIDEs);
+    fNumElectrons.reserve(nIDEs);
+    fEnergies.reserve(nIDEs);
+
+    StoredTDC_t lastTDC = 0;
+    fIDEOffsets.push_back(0);
+    for (auto const& TDCinfo: TDCIDEs) {
+      // ticks are sorted; larger gaps are stored in full
+      unsigned int const delta = TDCinfo.first - lastTDC;
+      if (delta < TDCEscape) fTDCDeltas.push_back(delta);
+      else {
+        fTDCDeltas.push_back(TDCEscape);
+        fTDCEscapes.push_back(TDCinfo.first);
+      }
+      lastTDC = TDCinfo.first;
+      for (sim::IDE const& ide: TDCinfo.second) {
+        fTrackIDs.push_back(ide.trackID);
+        fNumElectrons.push_back(ide.numElectrons);
+        fEnergies.push_back(ide.energy);
+      }
+      fIDEOffsets.push_back(fTrackIDs.size());
+    } // for TDCs
+
+    if (!packPositions || (nIDEs == 0)) {
+      fX.reserve(nIDEs);
+      fY.reserve(nIDEs);
+      fZ.reserve(nIDEs);
+      for (auto const& TDCinfo: TDCIDEs) {
+        for (sim::IDE const& ide: TDCinfo.second) {
+          fX.push_back(ide.x);
+          fY.push_back(ide.y);
+          fZ.push_back(ide.z);
+        }
+      } // for TDCs
+      return;
+    }
+
+    //
+    // packed positions: find the box containing all the deposits first
+    //
+    constexpr float MaxPacked = std::numeric_limits<PackedCoord_t>::max();
+    float lower[3], upper[3];
+    {
+      sim::IDE const& first = TDCIDEs.front().second.front();
+      lower[0] = upper[0] = first.x;
+      lower[1] = upper[1] = first.y;
+      lower[2] = upper[2] = first.z;
+    }
+    for (auto const& TDCinfo: TDCIDEs) {
+      for (sim::IDE const& ide: TDCinfo.second) {
+        float const pos[3] = { ide.x, ide.y, ide.z };
+        for (int i = 0; i < 3; ++i) {
+          lower[i] = std::min(lower[i], pos[i]);
+          upper[i] = std::max(upper[i], pos[i]);
+        }
+      }
+    } // for TDCs
+    for (int i = 0; i < 3; ++i) {
+      fPackOrigin[i] = lower[i];
+      fPackStep[i] = (upper[i] - lower[i]) / MaxPacked;
+    }
+
+    fPackedPositions.reserve(3 * nIDEs);
+    for (auto const& TDCinfo: TDCIDEs) {
+      for (sim::IDE const& ide: TDCinfo.second) {
+        float const pos[3] = { ide.x, ide.y, ide.z };
+        for (int i = 0; i < 3; ++i) {
+          float const q = (fPackStep[i] > 0.f)
+            ? std::min(MaxPacked, (pos[i] - fPackOrigin[i]) / fPackStep[i])
+            : 0.f;
+          fPackedPositions.push_back
+            (static_cast<PackedCoord_t>(std::lround(std::max(q, 0.f))));
+        }
+      }
+    } // for TDCs
+
+  } // CompactSimChannel::CompactSimChannel()
+
+
+  //-------------------------------------------------
+  std::vector<CompactSimChannel::StoredTDC_t> CompactSimChannel::TDCs() const
+  {
+    std::vector<StoredTDC_t> TDCs;
+    TDCs.reserve(fTDCDeltas.size());
+    StoredTDC_t tdc = 0;
+    std::size_t iEscape = 0;
+    for (std::size_t iTDC = 0; iTDC < NTDCs(); ++iTDC)
+      TDCs.push_back(tdc = NextTDC(tdc, iTDC, iEscape));
+    return TDCs;
+  } // CompactSimChannel::TDCs()
+
+
+  //-------------------------------------------------
+  sim::IDE CompactSimChannel::IDE(std::size_t iIDE) const
+  {
+    if (!HasPackedPositions()) {
+      return { fTrackIDs[iIDE], fNumElectrons[iIDE], fEnergies[iIDE],
+        fX[iIDE], fY[iIDE], fZ[iIDE] };
+    }
+    PackedCoord_t const* packed = fPackedPositions.data() + 3 * iIDE;
+    return { fTrackIDs[iIDE], fNumElectrons[iIDE], fEnergies[iIDE],
+      fPackOrigin[0] + fPackStep[0] * packed[0],
+      fPackOrigin[1] + fPackStep[1] * packed[1],
+      fPackOrigin[2] + fPackStep[2] * packed[2]
+      };
+  } // CompactSimChannel::IDE()
+
+
+  //-------------------------------------------------
+  SimChannel::TDCIDEs_t CompactSimChannel::MakeTDCIDEMap() const
+  {
+    SimChannel::TDCIDEs_t TDCIDEs;
+    TDCIDEs.reserve(NTDCs());
+    for (auto const& [ tdc, ides ]: TDCIDEMap())
+      TDCIDEs.emplace_back(tdc, std::vector<sim::IDE>(ides.begin(), ides.end()));
+    return TDCIDEs;
+  } // CompactSimChannel::MakeTDCIDEMap()
+
+
+  //-------------------------------------------------
+  sim::SimChannel CompactSimChannel::MakeSimChannel() const
+  {
+    sim::SimChannel channel { fChannel };
+    channel.fTDCIDEs = MakeTDCIDEMap();
+    return channel;
+  } // CompactSimChannel::MakeSimChannel()
+
+
+}
+////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,291 @@
+/**
+ * @file   lardataobj/Simulation/CompactSimChannel.h
+ * @brief  Compact storage of the energy deposits on a readout channel.
+ * @see    lardataobj/Simulation/CompactSimChannel.cxx
+ */
+
+#ifndef LARDATAOBJ_SIMULATION_COMPACTSIMCHANNEL_H
+#define LARDATAOBJ_SIMULATION_COMPACTSIMCHANNEL_H
+
+// LArSoftObj libraries
+#include "lardataobj/Simulation/SimChannel.h"
+#include "larcoreobj/SimpleTypesAndConstants/RawTypes.h" // raw::ChannelID_t
+
+// C/C++ standard libraries
+#include <vector>
+#include <cstddef> // std::size_t
+#include <cstdint> // std::uint8_t, std::uint16_t
+#include <iterator> // std::forward_iterator_tag
+
+
+namespace sim {
+
+  /**
+   * @brief Energy deposited on a readout channel, in compact form.
+   *
+   * This object holds the same information as `sim::SimChannel`, with a
+   * layout which takes less memory and storage space:
+   *
+   * * the deposits (`sim::IDE`) of all the TDC ticks are stored in a single
+   *   set of arrays, one per data member ("structure of arrays"), instead of
+   *   having one vector of deposits per TDC tick;
+   * * the TDC ticks are stored as 8-bit differences from the previous one;
+   *   a tick farther than 254 ticks from the previous one is marked by the
+   *   escape value `TDCEscape` and stored in full in a separate list;
+   * * the deposits of each tick are delimited by offsets into the arrays;
+   * * optionally, the positions are packed into 16 bits per coordinate,
+   *   relative to the box containing all the deposits of the channel:
+   *   the precision is the size of the box divided by 65535, per coordinate.
+   *
+   * Track IDs, electrons and energies are always stored with full precision.
+   *
+   * The content is read back as `sim::IDE` objects, either one by one
+   * (`IDE()`) or through `TDCIDEMap()`, a view with the same structure as
+   * `sim::SimChannel::TDCIDEMap()` which decodes the deposits while iterating
+   * and does not allocate memory:
+   * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.cpp}
+   * for (auto const& [ tdc, ides ]: compactChannel.TDCIDEMap()) {
+   *   for (sim::IDE const ide: ides) {
+   *     // ...
+   *   }
+   * }
+   * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+   * `MakeTDCIDEMap()` and `MakeSimChannel()` instead copy the content into a
+   * `sim::SimChannel::TDCIDEs_t` and a complete `sim::SimChannel`.
+   */
+  class CompactSimChannel {
+  public:
+    using StoredTDC_t = SimChannel::StoredTDC_t;
+    using TDC_t = SimChannel::TDC_t;
+    using TrackID_t = SimChannel::TrackID_t;
+
+    /// Type of a packed position coordinate.
+    using PackedCoord_t = std::uint16_t;
+
+    /// Type of the difference between consecutive TDC ticks.
+    using TDCDelta_t = std::uint8_t;
+
+    /// Delta value marking a tick stored in full in the escape list.
+    static constexpr TDCDelta_t TDCEscape = 255;
+
+
+    /// The deposits of a TDC tick, decoded as `sim::IDE` on access.
+    class IDEs_t {
+    public:
+      /// Iterator returning `sim::IDE` by value.
+      class const_iterator {
+      public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = sim::IDE;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = sim::IDE;
+
+        const_iterator(CompactSimChannel const* channel, std::size_t iIDE)
+          : fChannel(channel), fIDE(iIDE) {}
+        sim::IDE operator*() const { return fChannel->IDE(fIDE); }
+        const_iterator& operator++() { ++fIDE; return *this; }
+        const_iterator operator++(int) { auto old = *this; ++fIDE; return old; }
+        bool operator== (const_iterator const& other) const
+          { return fIDE == other.fIDE; }
+        bool operator!= (const_iterator const& other) const
+          { return fIDE != other.fIDE; }
+      private:
+        CompactSimChannel const* fChannel;
+        std::size_t fIDE; ///< Position of the deposit in the channel.
+      }; // const_iterator
+
+      IDEs_t(CompactSimChannel const* channel, std::size_t b, std::size_t e)
+        : fChannel(channel), fBegin(b), fEnd(e) {}
+      const_iterator begin() const { return { fChannel, fBegin }; }
+      const_iterator end() const { return { fChannel, fEnd }; }
+      std::size_t size() const { return fEnd - fBegin; }
+      bool empty() const { return fBegin == fEnd; }
+      sim::IDE operator[] (std::size_t i) const
+        { return fChannel->IDE(fBegin + i); }
+    private:
+      CompactSimChannel const* fChannel;
+      std::size_t fBegin; ///< Position of the first deposit in the channel.
+      std::size_t fEnd;   ///< Position after the last deposit in the channel.
+    }; // IDEs_t
+
+    /// A TDC tick and its deposits, like `sim::TDCIDE`.
+    struct TDCIDE_t {
+      StoredTDC_t first; ///< TDC tick.
+      IDEs_t second;     ///< Deposits in the tick.
+    }; // TDCIDE_t
+
+    /// View of all the deposits by TDC tick, like `sim::SimChannel::TDCIDEs_t`.
+    class TDCIDEs_t {
+    public:
+      /// Iterator decoding the TDC ticks in sequence.
+      class const_iterator {
+      public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = TDCIDE_t;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = TDCIDE_t;
+
+        const_iterator(CompactSimChannel const* channel, std::size_t iTDC)
+          : fChannel(channel), fTDC(iTDC)
+          { if (fTDC < fChannel->NTDCs()) fTick = fChannel->NextTDC(0, fTDC, fEscape); }
+        TDCIDE_t operator*() const
+          {
+            return { fTick, IDEs_t
+              { fChannel, fChannel->BeginIDE(fTDC), fChannel->EndIDE(fTDC) } };
+          }
+        const_iterator& operator++()
+          {
+            if (++fTDC < fChannel->NTDCs())
+              fTick = fChannel->NextTDC(fTick, fTDC, fEscape);
+            return *this;
+          }
+        const_iterator operator++(int) { auto old = *this; ++*this; return old; }
+        bool operator== (const_iterator const& other) const
+          { return fTDC == other.fTDC; }
+        bool operator!= (const_iterator const& other) const
+          { return fTDC != other.fTDC; }
+      private:
+        CompactSimChannel const* fChannel;
+        std::size_t fTDC;        ///< Position of the current tick.
+        StoredTDC_t fTick = 0;   ///< Current TDC tick.
+        std::size_t fEscape = 0; ///< Position of the next escaped tick.
+      }; // const_iterator
+
+      explicit TDCIDEs_t(CompactSimChannel const* channel): fChannel(channel) {}
+      const_iterator begin() const { return { fChannel, 0 }; }
+      const_iterator end() const { return { fChannel, fChannel->NTDCs() }; }
+      std::size_t size() const { return fChannel->NTDCs(); }
+      bool empty() const { return size() == 0; }
+    private:
+      CompactSimChannel const* fChannel;
+    }; // TDCIDEs_t
+
+    /// Default constructor: an invalid channel with no deposits.
+    CompactSimChannel();
+
+    /**
+     * @brief Constructor: compacts the content of a `sim::SimChannel`.
+     * @param channel the channel to be compacted
+     * @param packPositions (default: `false`) whether to pack the positions
+     */
+    explicit CompactSimChannel
+      (sim::SimChannel const& channel, bool packPositions = false);
+
+
+    // --- BEGIN -- Accessors ------------------------------------------------
+    ///@name Accessors
+    ///@{
+
+    /// Returns the readout channel this object describes.
+    raw::ChannelID_t Channel() const { return fChannel; }
+
+    /// Returns the number of TDC ticks with deposits.
+    std::size_t NTDCs() const { return fTDCDeltas.size(); }
+
+    /// Returns the total number of deposits.
+    std::size_t NIDEs() const { return fTrackIDs.size(); }
+
+    /// Returns whether the positions are packed.
+    bool HasPackedPositions() const { return !fPackedPositions.empty(); }
+
+    /// Returns all the TDC ticks with deposits, sorted.
+    std::vector<StoredTDC_t> TDCs() const;
+
+    /// Returns the index of the first deposit in the TDC tick number `iTDC`.
+    std::size_t BeginIDE(std::size_t iTDC) const { return fIDEOffsets[iTDC]; }
+
+    /// Returns the index after the last deposit in the TDC tick number `iTDC`.
+    std::size_t EndIDE(std::size_t iTDC) const
+      { return fIDEOffsets[iTDC + 1]; }
+
+    /// Returns the deposit number `iIDE` (`0` to `NIDEs()`, excluded).
+    sim::IDE IDE(std::size_t iIDE) const;
+
+    ///@}
+    // --- END -- Accessors --------------------------------------------------
+
+
+    // --- BEGIN -- Conversion -----------------------------------------------
+    ///@name Conversion
+    ///@{
+
+    /**
+     * @brief Returns a view of all the deposits, organized by TDC tick.
+     * @see sim::SimChannel::TDCIDEMap(), MakeTDCIDEMap()
+     *
+     * The view refers to this object, and decodes ticks and deposits while
+     * it is iterated through.
+     */
+    TDCIDEs_t TDCIDEMap() const { return TDCIDEs_t{ this }; }
+
+    /**
+     * @brief Returns a copy of all the deposits, with the `sim::SimChannel` layout.
+     * @return all the deposits, organized by TDC tick
+     * @see sim::SimChannel::TDCIDEMap()
+     *
+     * The content is the same as the one of the original `sim::SimChannel`,
+     * except for the precision of packed positions.
+     */
+    SimChannel::TDCIDEs_t MakeTDCIDEMap() const;
+
+    /// Returns a `sim::SimChannel` with the content of this object.
+    sim::SimChannel MakeSimChannel() const;
+
+    ///@}
+    // --- END -- Conversion -------------------------------------------------
+
+
+    /// Comparison: sorts by channel ID.
+    bool operator< (CompactSimChannel const& other) const
+      { return fChannel < other.fChannel; }
+
+
+  private:
+    raw::ChannelID_t fChannel; ///< Readout channel.
+
+    /// TDC of each tick with deposits, as difference from the previous one.
+    std::vector<TDCDelta_t> fTDCDeltas;
+
+    /// Ticks whose delta is `TDCEscape`, in full.
+    std::vector<StoredTDC_t> fTDCEscapes;
+
+    /// Deposits of tick `i` are from `fIDEOffsets[i]` to `fIDEOffsets[i+1]`.
+    std::vector<unsigned int> fIDEOffsets;
+
+    std::vector<TrackID_t> fTrackIDs;  ///< Track ID of each deposit.
+    std::vector<float> fNumElectrons;  ///< Electrons of each deposit.
+    std::vector<float> fEnergies;      ///< Energy of each deposit [MeV].
+
+    std::vector<float> fX; ///< x position of each deposit (if not packed) [cm].
+    std::vector<float> fY; ///< y position of each deposit (if not packed) [cm].
+    std::vector<float> fZ; ///< z position of each deposit (if not packed) [cm].
+
+    /// Packed positions (x, y and z of each deposit, if packed).
+    std::vector<PackedCoord_t> fPackedPositions;
+    float fPackOrigin[3]; ///< Position corresponding to packed `0` [cm].
+    float fPackStep[3];   ///< Position step of packed coordinates [cm].
+
+    /**
+     * @brief Returns the tick number `iTDC`, given the previous one.
+     * @param prevTDC the tick number `iTDC - 1` (ignored if `iTDC` is `0`)
+     * @param iTDC position of the tick
+     * @param[in,out] iEscape position of the next escaped tick; it is updated
+     */
+    StoredTDC_t NextTDC
+      (StoredTDC_t prevTDC, std::size_t iTDC, std::size_t& iEscape) const
+      {
+        TDCDelta_t const delta = fTDCDeltas[iTDC];
+        if (delta == TDCEscape) return fTDCEscapes[iEscape++];
+        return (iTDC == 0)? delta: prevTDC + delta;
+      }
+
+  }; // class CompactSimChannel
+
+} // namespace sim
+
+
+#endif // LARDATAOBJ_SIMULATION_COMPACTSIMCHANNEL_H
+
+////////////////////////////////////////////////////////////////////////
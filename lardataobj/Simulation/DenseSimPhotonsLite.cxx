@@ -0,0 +1,207 @@
+////////////////////////////////////////////////////////////////////////
+///
+/// \file  Simulation/DenseSimPhotonsLite.cxx
+///
+/// \brief Photon counts per time tick on an optical channel, as a histogram.
+///
+////////////////////////////////////////////////////////////////////////
+
+#include <algorithm> // std::max(), std::copy(), std::upper_bound()
+#include <numeric> // std::accumulate()
+#include <utility> // std::move()
+
+#include "lardataobj/Simulation/DenseSimPhotonsLite.h"
+
+namespace sim{
+
+  //-------------------------------------------------
+  DenseSimPhotonsLite::DenseSimPhotonsLite(sim::SimPhotonsLite const& lite)
+    : fOpChannel(lite.OpChannel)
+  {
+    // the map is sorted by tick: each tick extends the last block or starts
+    // a new one after it
+    for (auto const& phot: lite.DetectedPhotons)
+      if (phot.second != 0) AddPhotons(phot.first, phot.second);
+  }
+
+  //-------------------------------------------------
+  auto DenseSimPhotonsLite::Photons(Tick_t tick) const -> Count_t
+  {
+    std::size_t const iBlock = FindBlock(tick);
+    if ((iBlock >= NBlocks()) || (tick >= BlockEndTick(iBlock))) return 0;
+    return fCounts
+      [BlockBegin(iBlock) + (static_cast<long long>(tick) - fBlockFirstTicks[iBlock])];
+  } // DenseSimPhotonsLite::Photons()
+
+  //-------------------------------------------------
+  long long DenseSimPhotonsLite::NPhotons() const
+  {
+    return std::accumulate(fCounts.begin(), fCounts.end(), 0LL);
+  } // DenseSimPhotonsLite::NPhotons()
+
+  //-------------------------------------------------
+  auto DenseSimPhotonsLite::DetectedPhotons() const -> DetectedPhotons_t
+  {
+    return {
+      const_iterator{ this, 0, 0 },
+      const_iterator{ this, NBlocks(), fCounts.size() }
+      };
+  } // DenseSimPhotonsLite::DetectedPhotons()
+
+  //-------------------------------------------------
+  void DenseSimPhotonsLite::Cover(Tick_t first, Tick_t end)
+  {
+    if (first < end) CoverRange({ first, end });
+  } // DenseSimPhotonsLite::Cover()
+
+  //-------------------------------------------------
+  void DenseSimPhotonsLite::AddPhotons(Tick_t tick, Count_t n /* = 1 */)
+  {
+    fCounts[CoverRange({ tick, static_cast<long long>(tick) + 1 })] += n;
+  } // DenseSimPhotonsLite::AddPhotons()
+
+  //-------------------------------------------------
+  DenseSimPhotonsLite& DenseSimPhotonsLite::operator+=
+    (DenseSimPhotonsLite const& rhs)
+  {
+    if (rhs.empty()) return *this;
+
+    // blocks of `rhs` not yet covered are added all at once
+    std::vector<TickRange_t> missing;
+    for (std::size_t iBlock = 0; iBlock < rhs.NBlocks(); ++iBlock) {
+      Tick_t const first = rhs.fBlockFirstTicks[iBlock];
+      long long const end = rhs.BlockEndTick(iBlock);
+      std::size_t const iMyBlock = FindBlock(first);
+      if ((iMyBlock < NBlocks()) && (end <= BlockEndTick(iMyBlock))) continue;
+      missing.emplace_back(first, end);
+    } // for
+    if (!missing.empty()) AddRanges(missing);
+
+    // plain loops on two arrays, which the compiler can vectorize
+    for (std::size_t iBlock = 0; iBlock < rhs.NBlocks(); ++iBlock) {
+      Count_t* dest = fCounts.data() + CountIndex(rhs.fBlockFirstTicks[iBlock]);
+      Count_t const* src = rhs.BlockCounts(iBlock);
+      std::size_t const n = rhs.BlockSize(iBlock);
+      for (std::size_t i = 0; i < n; ++i) dest[i] += src[i];
+    } // for
+
+    return *this;
+  } // DenseSimPhotonsLite::operator+=()
+
+  //-------------------------------------------------
+  DenseSimPhotonsLite DenseSimPhotonsLite::operator+
+    (DenseSimPhotonsLite const& rhs) const
+    { return DenseSimPhotonsLite(*this) += rhs; }
+
+  //-------------------------------------------------
+  sim::SimPhotonsLite DenseSimPhotonsLite::MakeSimPhotonsLite() const
+  {
+    sim::SimPhotonsLite lite { fOpChannel };
+    // ticks come sorted: each one is inserted at the end of the map
+    for (auto const& phot: DetectedPhotons()) {
+      lite.DetectedPhotons.emplace_hint
+        (lite.DetectedPhotons.end(), phot.first, phot.second);
+    }
+    return lite;
+  } // DenseSimPhotonsLite::MakeSimPhotonsLite()
+
+  //-------------------------------------------------
+  std::size_t DenseSimPhotonsLite::FindBlock(Tick_t tick) const
+  {
+    auto const itNext = std::upper_bound
+      (fBlockFirstTicks.begin(), fBlockFirstTicks.end(), tick);
+    return (itNext == fBlockFirstTicks.begin())
+      ? NBlocks(): (itNext - fBlockFirstTicks.begin() - 1);
+  } // DenseSimPhotonsLite::FindBlock()
+
+  //-------------------------------------------------
+  std::size_t DenseSimPhotonsLite::CountIndex(Tick_t tick) const
+  {
+    std::size_t const iBlock = FindBlock(tick);
+    return BlockBegin(iBlock)
+      + (static_cast<long long>(tick) - fBlockFirstTicks[iBlock]);
+  } // DenseSimPhotonsLite::CountIndex()
+
+  //-------------------------------------------------
+  std::size_t DenseSimPhotonsLite::CoverRange(TickRange_t range)
+  {
+    auto const [ first, end ] = range;
+
+    // common cases first: already covered, or extending after the last block
+    if (!empty()) {
+      std::size_t const iLast = NBlocks() - 1;
+      long long const lastEnd = BlockEndTick(iLast);
+      std::size_t const iBlock = FindBlock(static_cast<Tick_t>(first));
+      if ((iBlock < NBlocks()) && (end <= BlockEndTick(iBlock)))
+        return BlockBegin(iBlock) + (first - fBlockFirstTicks[iBlock]);
+      if ((iBlock == iLast) && (first <= lastEnd + MaxGap)) {
+        fCounts.resize(fCounts.size() + (end - lastEnd), 0);
+        fBlockEnds.back() = fCounts.size();
+        return BlockBegin(iLast) + (first - fBlockFirstTicks[iLast]);
+      }
+    }
+    if (empty() || (first > BlockEndTick(NBlocks() - 1) + MaxGap)) {
+      std::size_t const begin = fCounts.size();
+      fBlockFirstTicks.push_back(first);
+      fCounts.resize(begin + (end - first), 0);
+      fBlockEnds.push_back(fCounts.size());
+      return begin;
+    }
+
+    AddRanges({ range });
+    return CountIndex(static_cast<Tick_t>(first));
+  } // DenseSimPhotonsLite::CoverRange()
+
+  //-------------------------------------------------
+  void DenseSimPhotonsLite::AddRanges(std::vector<TickRange_t> const& ranges)
+  {
+    // join the existing blocks and the new ranges, both sorted, into the new
+    // blocks; blocks closer than `MaxGap` are merged
+    std::vector<TickRange_t> blocks;
+    blocks.reserve(NBlocks() + ranges.size());
+    auto const addRange = [&blocks](TickRange_t const& range)
+      {
+        if (!blocks.empty() && (range.first <= blocks.back().second + MaxGap))
+          blocks.back().second = std::max(blocks.back().second, range.second);
+        else blocks.push_back(range);
+      };
+    std::size_t iBlock = 0;
+    for (TickRange_t const& range: ranges) {
+      while ((iBlock < NBlocks()) && (fBlockFirstTicks[iBlock] <= range.first)) {
+        addRange({ fBlockFirstTicks[iBlock], BlockEndTick(iBlock) });
+        ++iBlock;
+      }
+      addRange(range);
+    } // for
+    for (; iBlock < NBlocks(); ++iBlock)
+      addRange({ fBlockFirstTicks[iBlock], BlockEndTick(iBlock) });
+
+    // move the counts to the new blocks
+    std::vector<Tick_t> firstTicks;
+    std::vector<unsigned int> blockEnds;
+    firstTicks.reserve(blocks.size());
+    blockEnds.reserve(blocks.size());
+    std::size_t nCounts = 0;
+    for (TickRange_t const& block: blocks) {
+      firstTicks.push_back(block.first);
+      nCounts += block.second - block.first;
+      blockEnds.push_back(nCounts);
+    } // for
+    std::vector<Count_t> counts(nCounts, 0);
+    std::size_t iNewBlock = 0;
+    for (iBlock = 0; iBlock < NBlocks(); ++iBlock) {
+      while (blocks[iNewBlock].second < BlockEndTick(iBlock)) ++iNewBlock;
+      std::size_t const newBegin = (iNewBlock == 0)? 0: blockEnds[iNewBlock - 1];
+      std::copy(BlockCounts(iBlock), BlockCounts(iBlock) + BlockSize(iBlock),
+        counts.begin() + newBegin
+        + (fBlockFirstTicks[iBlock] - blocks[iNewBlock].first));
+    } // for
+
+    fBlockFirstTicks = std::move(firstTicks);
+    fBlockEnds = std::move(blockEnds);
+    fCounts = std::move(counts);
+  } // DenseSimPhotonsLite::AddRanges()
+
+
+}
+////////////////////////////////////////////////////////////////////////
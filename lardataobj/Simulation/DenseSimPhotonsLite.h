@@ -0,0 +1,231 @@
+/**
+ * @file   lardataobj/Simulation/DenseSimPhotonsLite.h
+ * @brief  Photon counts per time tick on an optical channel, as a histogram.
+ * @see    lardataobj/Simulation/DenseSimPhotonsLite.cxx
+ */
+
+#ifndef LARDATAOBJ_SIMULATION_DENSESIMPHOTONSLITE_H
+#define LARDATAOBJ_SIMULATION_DENSESIMPHOTONSLITE_H
+
+// LArSoftObj libraries
+#include "lardataobj/Simulation/SimPhotons.h"
+#include "lardataobj/Utilities/IteratorRange.h"
+
+// C/C++ standard libraries
+#include <vector>
+#include <utility> // std::pair
+#include <iterator> // std::forward_iterator_tag
+#include <cstddef> // std::size_t, std::ptrdiff_t
+
+
+namespace sim {
+
+  /**
+   * @brief Number of photons detected at each time tick on an optical channel.
+   * @see   `sim::SimPhotonsLite`
+   *
+   * This object holds the same information as `sim::SimPhotonsLite`, but the
+   * counts are stored in arrays (histograms) of consecutive ticks, instead of
+   * in a map with one node per tick. Adding two objects is a loop on arrays,
+   * without any allocation when the ticks are already covered.
+   *
+   * The ticks are split in blocks: a block covers the ticks from its first to
+   * its last one with photons, and a gap of more than `MaxGap` ticks without
+   * photons starts a new block. Each tick with photons takes therefore at
+   * most `MaxGap + 1` counts of storage, and a single photon far from all the
+   * others adds a block with a single count, rather than extending a
+   * histogram to reach it. Ticks with no photons are not distinguished from
+   * ticks which are not present: the conversion from `sim::SimPhotonsLite`
+   * drops entries with no photons.
+   *
+   * All blocks are stored in a single array of counts, in tick order.
+   *
+   * The content can be iterated via `DetectedPhotons()`, which presents only
+   * the ticks with photons, as pairs (tick, photons) like the elements of
+   * `sim::SimPhotonsLite::DetectedPhotons`:
+   * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.cpp}
+   * for (auto const& [ tick, nPhotons ]: lite.DetectedPhotons()) { ... }
+   * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+   */
+  class DenseSimPhotonsLite {
+  public:
+    using Tick_t = int; ///< Type of time tick.
+    using Count_t = int; ///< Type of photon count.
+
+    /// Largest number of consecutive ticks without photons within a block.
+    static constexpr Tick_t MaxGap = 64;
+
+    /// Iterator through the ticks with photons, as pairs (tick, photons).
+    class const_iterator {
+    public:
+      using iterator_category = std::forward_iterator_tag;
+      using value_type = std::pair<Tick_t, Count_t>;
+      using difference_type = std::ptrdiff_t;
+      using pointer = value_type const*;
+      using reference = value_type;
+
+      const_iterator() = default;
+      const_iterator
+        (DenseSimPhotonsLite const* photons, std::size_t iBlock, std::size_t iCount)
+        : fPhotons(photons), fBlock(iBlock), fCount(iCount)
+        { skipEmpty(); }
+
+      value_type operator* () const
+        {
+          return {
+            static_cast<Tick_t>(fPhotons->fBlockFirstTicks[fBlock]
+              + static_cast<long long>(fCount - fPhotons->BlockBegin(fBlock))),
+            fPhotons->fCounts[fCount]
+            };
+        }
+
+      const_iterator& operator++ () { ++fCount; skipEmpty(); return *this; }
+      const_iterator operator++ (int) { auto old = *this; ++*this; return old; }
+
+      bool operator== (const_iterator const& other) const
+        { return fCount == other.fCount; }
+      bool operator!= (const_iterator const& other) const
+        { return fCount != other.fCount; }
+
+    private:
+      DenseSimPhotonsLite const* fPhotons = nullptr;
+      std::size_t fBlock = 0; ///< Block of the current count.
+      std::size_t fCount = 0; ///< Position of the current count.
+
+      void skipEmpty()
+        {
+          std::vector<Count_t> const& counts = fPhotons->fCounts;
+          while ((fCount < counts.size()) && (counts[fCount] == 0)) ++fCount;
+          while ((fBlock < fPhotons->NBlocks())
+            && (fCount >= fPhotons->fBlockEnds[fBlock]))
+            ++fBlock;
+        }
+    }; // const_iterator
+
+    /// Range of the ticks with photons (see `DetectedPhotons()`).
+    using DetectedPhotons_t = util::IteratorRange<const_iterator>;
+
+
+    /// Default constructor (do not use! it's for ROOT only).
+    DenseSimPhotonsLite() = default;
+
+    /// Constructor: associated to optical detector channel `chan`, and empty.
+    explicit DenseSimPhotonsLite(int chan): fOpChannel(chan) {}
+
+    /// Constructor: copies the content of `lite`.
+    explicit DenseSimPhotonsLite(sim::SimPhotonsLite const& lite);
+
+
+    // --- BEGIN -- Accessors ------------------------------------------------
+    ///@name Accessors
+    ///@{
+
+    /// Returns the optical detector channel associated to this data.
+    int OpChannel() const { return fOpChannel; }
+
+    /// Returns whether there is no tick stored.
+    bool empty() const { return fCounts.empty(); }
+
+    /// Returns the number of blocks of ticks.
+    std::size_t NBlocks() const { return fBlockFirstTicks.size(); }
+
+    /// Returns the first tick of the block number `iBlock`.
+    Tick_t BlockFirstTick(std::size_t iBlock) const
+      { return fBlockFirstTicks[iBlock]; }
+
+    /// Returns the number of ticks in the block number `iBlock`.
+    std::size_t BlockSize(std::size_t iBlock) const
+      { return fBlockEnds[iBlock] - BlockBegin(iBlock); }
+
+    /// Returns the counts of the ticks of the block number `iBlock`.
+    Count_t const* BlockCounts(std::size_t iBlock) const
+      { return fCounts.data() + BlockBegin(iBlock); }
+
+    /// Returns the number of photons at the specified tick.
+    Count_t Photons(Tick_t tick) const;
+
+    /// Returns the total number of photons.
+    long long NPhotons() const;
+
+    /// Returns the ticks with photons, as pairs (tick, photons).
+    DetectedPhotons_t DetectedPhotons() const;
+
+    ///@}
+    // --- END -- Accessors --------------------------------------------------
+
+
+    // --- BEGIN -- Filling --------------------------------------------------
+    ///@name Filling
+    ///@{
+
+    /**
+     * @brief Makes the ticks `[ first, end [` part of a single block.
+     *
+     * The storage of all the ticks in the range is allocated, so the range
+     * should be limited (e.g. the readout window); filling does not need this
+     * call, which only saves reallocations.
+     */
+    void Cover(Tick_t first, Tick_t end);
+
+    /// Adds `n` photons at the specified tick.
+    void AddPhotons(Tick_t tick, Count_t n = 1);
+
+    /// Add all photons from `rhs` to this ones, at their original time.
+    DenseSimPhotonsLite& operator+= (DenseSimPhotonsLite const& rhs);
+
+    /// Creates a new object with all photons from `rhs` and this object.
+    DenseSimPhotonsLite operator+ (DenseSimPhotonsLite const& rhs) const;
+
+    ///@}
+    // --- END -- Filling ----------------------------------------------------
+
+
+    /// Returns a `sim::SimPhotonsLite` with all the ticks with photons.
+    sim::SimPhotonsLite MakeSimPhotonsLite() const;
+
+    /// Returns whether `other` is on the same channel (`OpChannel`) as this.
+    bool operator== (DenseSimPhotonsLite const& other) const
+      { return fOpChannel == other.fOpChannel; }
+
+
+  private:
+    /// A range of ticks `[ first, end [`; wider than `Tick_t` to hold any end.
+    using TickRange_t = std::pair<long long, long long>;
+
+    int fOpChannel = -1; ///< Optical detector channel associated to this data.
+
+    std::vector<Tick_t> fBlockFirstTicks; ///< First tick of each block.
+
+    /// Counts of block `i` end at `fCounts[fBlockEnds[i]]`, excluded.
+    std::vector<unsigned int> fBlockEnds;
+
+    std::vector<Count_t> fCounts; ///< Photons at each tick of all blocks.
+
+    /// Returns the position in `fCounts` of the first tick of block `iBlock`.
+    std::size_t BlockBegin(std::size_t iBlock) const
+      { return (iBlock == 0)? 0: fBlockEnds[iBlock - 1]; }
+
+    /// Returns the tick after the last one of block `iBlock`.
+    long long BlockEndTick(std::size_t iBlock) const
+      { return static_cast<long long>(fBlockFirstTicks[iBlock]) + BlockSize(iBlock); }
+
+    /// Returns the last block starting not after `tick` (`NBlocks()` if none).
+    std::size_t FindBlock(Tick_t tick) const;
+
+    /// Returns the position in `fCounts` of `tick`, which must be covered.
+    std::size_t CountIndex(Tick_t tick) const;
+
+    /// Covers the range of ticks, and returns the position of its first one.
+    std::size_t CoverRange(TickRange_t range);
+
+    /// Rearranges the blocks to cover also all `ranges` (sorted by start).
+    void AddRanges(std::vector<TickRange_t> const& ranges);
+
+  }; // class DenseSimPhotonsLite
+
+} // namespace sim
+
+
+#endif // LARDATAOBJ_SIMULATION_DENSESIMPHOTONSLITE_H
+
+////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,166 @@
+///
+/// \file  Simulation/FlatSimPhotonsCollection.cxx
+///
+/// \brief Photons of all optical channels, in contiguous storage.
+///
+////////////////////////////////////////////////////////////////////////
+
+#include <algorithm> // std::sort(), std::unique(), std::lower_bound(), ...
+#include <stdexcept> // std::runtime_error
+#include <string> // std::to_string()
+#include <utility> // std::move()
+
+#include "lardataobj/Simulation/FlatSimPhotonsCollection.h"
+
+namespace sim{
+
+  //-------------------------------------------------
+  FlatSimPhotonsCollection::FlatSimPhotonsCollection
+    (sim::SimPhotonsCollection const& photons)
+    : fTheSDName(photons.GetSDName())
+  {
+    // the map is already sorted by channel
+    size_type nPhotons = 0;
+    for (auto const& chPhotons: photons) nPhotons += chPhotons.second.size();
+
+    fChannels.reserve(photons.size());
+    fOffsets.reserve(photons.size() + 1);
+    fPhotons.reserve(nPhotons);
+
+    fOffsets.push_back(0);
+    for (auto const& chPhotons: photons) {
+      fChannels.push_back(chPhotons.first);
+      fPhotons.insert
+        (fPhotons.end(), chPhotons.second.begin(), chPhotons.second.end());
+      fOffsets.push_back(fPhotons.size());
+    } // for
+  } // FlatSimPhotonsCollection::FlatSimPhotonsCollection(SimPhotonsCollection)
+
+
+  //-------------------------------------------------
+  FlatSimPhotonsCollection::FlatSimPhotonsCollection
+    (std::vector<sim::SimPhotons> const& photons)
+  {
+    for (sim::SimPhotons const& chPhotons: photons)
+      fChannels.push_back(chPhotons.OpChannel());
+    std::sort(fChannels.begin(), fChannels.end());
+    fChannels.erase
+      (std::unique(fChannels.begin(), fChannels.end()), fChannels.end());
+
+    // count the photons of each channel, then place them
+    std::vector<size_type> counts(fChannels.size(), 0);
+    std::vector<size_type> channelIndices;
+    channelIndices.reserve(photons.size());
+    for (sim::SimPhotons const& chPhotons: photons) {
+      size_type const iChannel = std::lower_bound
+        (fChannels.begin(), fChannels.end(), chPhotons.OpChannel())
+        - fChannels.begin();
+      channelIndices.push_back(iChannel);
+      counts[iChannel] += chPhotons.size();
+    } // for
+
+    fOffsets.resize(fChannels.size() + 1);
+    fOffsets[0] = 0;
+    for (size_type i = 0; i < counts.size(); ++i)
+      fOffsets[i + 1] = fOffsets[i] + counts[i];
+
+    fPhotons.resize(fOffsets.back());
+    std::vector<size_type> next(fOffsets.begin(), fOffsets.end() - 1);
+    for (size_type i = 0; i < photons.size(); ++i) {
+      size_type& pos = next[channelIndices[i]];
+      std::copy(photons[i].begin(), photons[i].end(), fPhotons.begin() + pos);
+      pos += photons[i].size();
+    } // for
+  } // FlatSimPhotonsCollection::FlatSimPhotonsCollection(vector<SimPhotons>)
+
+
+  //-------------------------------------------------
+  FlatSimPhotonsCollection::FlatSimPhotonsCollection
+    (std::vector<int> const& channels, std::vector<sim::OnePhoton> photons)
+  {
+    if (channels.size() != photons.size()) {
+      throw std::runtime_error("FlatSimPhotonsCollection: "
+        + std::to_string(channels.size()) + " channels for "
+        + std::to_string(photons.size()) + " photons");
+    }
+
+    // photons already grouped by sorted channel are taken as they are
+    if (std::is_sorted(channels.begin(), channels.end())) {
+      fPhotons = std::move(photons);
+      fOffsets.push_back(0);
+      for (size_type i = 0; i < channels.size(); ++i) {
+        if ((i > 0) && (channels[i] == channels[i - 1])) continue;
+        if (i > 0) fOffsets.push_back(i);
+        fChannels.push_back(channels[i]);
+      }
+      if (!channels.empty()) fOffsets.push_back(channels.size());
+      return;
+    }
+
+    fChannels = channels;
+    std::sort(fChannels.begin(), fChannels.end());
+    fChannels.erase
+      (std::unique(fChannels.begin(), fChannels.end()), fChannels.end());
+
+    // counting sort of the photons by channel
+    std::vector<size_type> channelIndices;
+    channelIndices.reserve(channels.size());
+    std::vector<size_type> counts(fChannels.size(), 0);
+    for (int channel: channels) {
+      size_type const iChannel
+        = std::lower_bound(fChannels.begin(), fChannels.end(), channel)
+        - fChannels.begin();
+      channelIndices.push_back(iChannel);
+      ++counts[iChannel];
+    } // for
+
+    fOffsets.resize(fChannels.size() + 1);
+    fOffsets[0] = 0;
+    for (size_type i = 0; i < counts.size(); ++i)
+      fOffsets[i + 1] = fOffsets[i] + counts[i];
+
+    fPhotons.resize(photons.size());
+    std::vector<size_type> next(fOffsets.begin(), fOffsets.end() - 1);
+    for (size_type i = 0; i < photons.size(); ++i)
+      fPhotons[next[channelIndices[i]]++] = std::move(photons[i]);
+
+  } // FlatSimPhotonsCollection::FlatSimPhotonsCollection(channels, photons)
+
+
+  //-------------------------------------------------
+  bool FlatSimPhotonsCollection::HasChannel(int channel) const
+  {
+    return std::binary_search(fChannels.begin(), fChannels.end(), channel);
+  }
+
+
+  //-------------------------------------------------
+  auto FlatSimPhotonsCollection::Photons(int channel) const -> Photons_t
+  {
+    auto const itChannel
+      = std::lower_bound(fChannels.begin(), fChannels.end(), channel);
+    if ((itChannel == fChannels.end()) || (*itChannel != channel))
+      return { nullptr, nullptr };
+    return PhotonsAt(itChannel - fChannels.begin());
+  } // FlatSimPhotonsCollection::Photons()
+
+
+  //-------------------------------------------------
+  sim::SimPhotonsCollection FlatSimPhotonsCollection::MakeSimPhotonsCollection
+    () const
+  {
+    sim::SimPhotonsCollection photons;
+    photons.SetSDName(fTheSDName);
+    for (size_type iChannel = 0; iChannel < NChannels(); ++iChannel) {
+      int const channel = fChannels[iChannel];
+      sim::SimPhotons chPhotons { channel };
+      Photons_t const range = PhotonsAt(iChannel);
+      chPhotons.assign(range.begin(), range.end());
+      photons.emplace_hint(photons.end(), channel, std::move(chPhotons));
+    } // for
+    return photons;
+  } // FlatSimPhotonsCollection::MakeSimPhotonsCollection()
+
+
+}
+////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,135 @@
+/**
+ * @file   lardataobj/Simulation/FlatSimPhotonsCollection.h
+ * @brief  Photons of all optical channels, in contiguous storage.
+ * @see    lardataobj/Simulation/FlatSimPhotonsCollection.cxx
+ */
+
+#ifndef LARDATAOBJ_SIMULATION_FLATSIMPHOTONSCOLLECTION_H
+#define LARDATAOBJ_SIMULATION_FLATSIMPHOTONSCOLLECTION_H
+
+// LArSoftObj libraries
+#include "lardataobj/Simulation/SimPhotons.h"
+#include "lardataobj/Utilities/IteratorRange.h"
+
+// C/C++ standard libraries
+#include <vector>
+#include <string>
+#include <cstddef> // std::size_t
+
+
+namespace sim {
+
+  /**
+   * @brief Photons of all optical channels, in contiguous storage.
+   * @see   `sim::SimPhotonsCollection`
+   *
+   * This object holds the same information as `sim::SimPhotonsCollection`,
+   * with a flat layout: a sorted list of the channels, a single array with
+   * the photons of all the channels, grouped by channel in the same order,
+   * and for each channel the offset of its first photon in that array.
+   *
+   * The photons of a channel are returned as a range pointing into the
+   * array, without any copy (`Photons()`); looking up a channel is a binary
+   * search in a small array.
+   *
+   * The collection can be built from a `sim::SimPhotonsCollection` or from
+   * photons and channels in any order (the order of the photons of each
+   * channel is preserved), and converted back into a
+   * `sim::SimPhotonsCollection`.
+   */
+  class FlatSimPhotonsCollection {
+  public:
+    using size_type = std::size_t;
+
+    /// Range of photons of a channel, pointing into the collection storage.
+    using Photons_t = util::IteratorRange<sim::OnePhoton const*>;
+
+
+    /// Constructor: an empty collection and no sensitive detector name.
+    FlatSimPhotonsCollection() = default;
+
+    /// Constructor: copies the content of `photons`.
+    explicit FlatSimPhotonsCollection(sim::SimPhotonsCollection const& photons);
+
+    /**
+     * @brief Constructor: collects the photons of many `sim::SimPhotons`.
+     * @param photons the photons, each object with its channel
+     *
+     * Objects on the same channel are joined, in their order in `photons`.
+     */
+    explicit FlatSimPhotonsCollection
+      (std::vector<sim::SimPhotons> const& photons);
+
+    /**
+     * @brief Constructor: sorts photons in any order by channel.
+     * @param channels the channel of each photon
+     * @param photons the photons
+     * @throw std::runtime_error if `channels` and `photons` differ in size
+     *
+     * The photons of each channel keep their relative order.
+     */
+    FlatSimPhotonsCollection
+      (std::vector<int> const& channels, std::vector<sim::OnePhoton> photons);
+
+
+    // --- BEGIN -- Accessors ------------------------------------------------
+    ///@name Accessors
+    ///@{
+
+    /// Returns the name of the sensitive detector for this collection.
+    std::string const& GetSDName() const { return fTheSDName; }
+
+    /// Sets the name of the sensitive detector for this collection.
+    void SetSDName(std::string const& TheSDName) { fTheSDName = TheSDName; }
+
+    /// Returns the number of channels with photons.
+    size_type NChannels() const { return fChannels.size(); }
+
+    /// Returns the total number of photons.
+    size_type NPhotons() const { return fPhotons.size(); }
+
+    /// Returns the sorted list of channels with photons.
+    std::vector<int> const& Channels() const { return fChannels; }
+
+    /// Returns the photons of all channels, grouped by channel.
+    std::vector<sim::OnePhoton> const& AllPhotons() const { return fPhotons; }
+
+    /// Returns whether `channel` has photons.
+    bool HasChannel(int channel) const;
+
+    /// Returns the photons of `channel` (empty if the channel is not present).
+    Photons_t Photons(int channel) const;
+
+    /// Returns the photons of the channel number `iChannel` in `Channels()`.
+    Photons_t PhotonsAt(size_type iChannel) const
+      {
+        return
+          { fPhotons.data() + fOffsets[iChannel], fPhotons.data() + fOffsets[iChannel + 1] };
+      }
+
+    ///@}
+    // --- END -- Accessors --------------------------------------------------
+
+
+    /// Returns a `sim::SimPhotonsCollection` with all the photons.
+    sim::SimPhotonsCollection MakeSimPhotonsCollection() const;
+
+
+  private:
+    std::string fTheSDName; ///< Sensitive detector name.
+
+    std::vector<int> fChannels; ///< Sorted channels with photons.
+
+    /// Photons of `fChannels[i]` are from `fOffsets[i]` to `fOffsets[i+1]`.
+    std::vector<size_type> fOffsets;
+
+    std::vector<sim::OnePhoton> fPhotons; ///< Photons, grouped by channel.
+
+  }; // class FlatSimPhotonsCollection
+
+} // namespace sim
+
+
+#endif // LARDATAOBJ_SIMULATION_FLATSIMPHOTONSCOLLECTION_H
+
+////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,254 @@
+/**
+ * @file   lardataobj/Simulation/MergeSimCollections.h
+ * @brief  Merging of whole collections of simulated channels.
+ *
+ * The functions in this header merge a collection of `sim::SimChannel`,
+ * `sim::OpDetBacktrackerRecord` or `sim::AuxDetSimChannel` into another one
+ * of the same type, matching the elements by their channel.
+ * This header has no implementation file.
+ */
+
+#ifndef LARDATAOBJ_SIMULATION_MERGESIMCOLLECTIONS_H
+#define LARDATAOBJ_SIMULATION_MERGESIMCOLLECTIONS_H
+
+// LArSoftObj libraries
+#include "lardataobj/Simulation/SimChannel.h"
+#include "lardataobj/Simulation/OpDetBacktrackerRecord.h"
+#include "lardataobj/Simulation/AuxDetSimChannel.h"
+
+// C/C++ standard libraries
+#include <vector>
+#include <utility> // std::pair, std::forward()
+#include <algorithm> // std::sort(), std::lower_bound(), ...
+#include <limits>
+#include <type_traits> // std::decay_t
+#include <cstddef> // std::size_t
+#include <cstdint> // uint32_t
+
+
+namespace sim {
+
+  /**
+   * @brief Runs tasks one after the other.
+   *
+   * This is the default scheduler of the collection merging functions.
+   * A scheduler is called with the number of tasks `n` and a callable `f`,
+   * and must call `f(i)` exactly once for each `i` from `0` to `n - 1`; the
+   * calls may be concurrent, e.g. with TBB:
+   * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.cpp}
+   * auto parallelForEach = [](std::size_t n, auto&& f)
+   *   { tbb::parallel_for(std::size_t(0), n, f); };
+   * sim::MergeSimChannels(simChannels, otherSimChannels, offset, parallelForEach);
+   * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+   */
+  struct SerialForEach {
+    template <typename F>
+    void operator() (std::size_t n, F&& f) const
+      { for (std::size_t i = 0; i < n; ++i) f(i); }
+  }; // SerialForEach
+
+
+  namespace details {
+
+    /**
+     * @brief Merges `src` into `dest`, matching elements by key.
+     * @param dest the collection to merge into
+     * @param src the collection to be merged
+     * @param offset track ID offset passed to `merge`
+     * @param keyOf callable returning the key of an element
+     * @param makeEmpty callable returning an empty element with a given key
+     * @param merge callable merging the second element into the first one
+     * @param forEach scheduler of the merge tasks
+     * @return the range of the track IDs merged, after the offset
+     *
+     * Each destination element is changed by a single task, so the tasks
+     * can be run concurrently. If `dest` is sorted by key, it stays sorted.
+     */
+    template <
+      typename Coll, typename KeyOf, typename MakeEmpty, typename Merge,
+      typename ForEach
+      >
+    std::pair<int,int> MergeCollectionsByKey(
+      Coll& dest, Coll const& src, int offset,
+      KeyOf keyOf, MakeEmpty makeEmpty, Merge merge, ForEach&& forEach
+    ) {
+      using Key_t = std::decay_t<decltype(keyOf(src.front()))>;
+      using KeyIndex_t = std::pair<Key_t, std::size_t>;
+      auto const byKey = [](KeyIndex_t const& a, KeyIndex_t const& b)
+        { return a.first < b.first; };
+
+      std::pair<int,int> range_trackID(std::numeric_limits<int>::max(),
+                                       std::numeric_limits<int>::min());
+      if (src.empty()) return range_trackID;
+
+      std::size_t const nOriginal = dest.size();
+      bool const sorted = std::is_sorted(dest.begin(), dest.end(),
+        [&keyOf](auto const& a, auto const& b){ return keyOf(a) < keyOf(b); });
+
+      // look-up table of the destination elements (first one for each key)
+      std::vector<KeyIndex_t> destKeys;
+      destKeys.reserve(nOriginal);
+      for (std::size_t i = 0; i < nOriginal; ++i)
+        destKeys.emplace_back(keyOf(dest[i]), i);
+      std::stable_sort(destKeys.begin(), destKeys.end(), byKey);
+
+      // source elements sorted by key; the order of merging is preserved
+      std::vector<KeyIndex_t> srcKeys;
+      srcKeys.reserve(src.size());
+      for (std::size_t i = 0; i < src.size(); ++i)
+        srcKeys.emplace_back(keyOf(src[i]), i);
+      std::stable_sort(srcKeys.begin(), srcKeys.end(), byKey);
+
+      // assign each source element to a destination, adding the missing ones;
+      // tasks are (destination, source) pairs, grouped by destination
+      std::vector<std::pair<std::size_t, std::size_t>> tasks;
+      tasks.reserve(srcKeys.size());
+      std::vector<std::size_t> groupStarts;
+      auto itDest = destKeys.cbegin();
+      for (std::size_t iSrc = 0; iSrc < srcKeys.size(); ++iSrc) {
+        Key_t const& key = srcKeys[iSrc].first;
+        if ((iSrc == 0) || (srcKeys[iSrc - 1].first < key)) {
+          itDest = std::lower_bound(itDest, destKeys.cend(), srcKeys[iSrc], byKey);
+          groupStarts.push_back(tasks.size());
+          if ((itDest == destKeys.cend()) || (key < itDest->first)) {
+            tasks.emplace_back(dest.size(), srcKeys[iSrc].second);
+            dest.push_back(makeEmpty(key));
+            continue;
+          }
+        }
+        tasks.emplace_back
+          ((tasks.size() == groupStarts.back())? itDest->second: tasks.back().first,
+          srcKeys[iSrc].second);
+      } // for
+      groupStarts.push_back(tasks.size());
+
+      // merge; each group of tasks has its own destination and result
+      std::size_t const nGroups = groupStarts.size() - 1;
+      std::vector<std::pair<int,int>> ranges(nGroups, range_trackID);
+      forEach(nGroups, [&](std::size_t iGroup){
+        std::pair<int,int>& range = ranges[iGroup];
+        for (std::size_t iTask = groupStarts[iGroup];
+          iTask < groupStarts[iGroup + 1]; ++iTask)
+        {
+          auto const [ iDest, iSrc ] = tasks[iTask];
+          std::pair<int,int> const r = merge(dest[iDest], src[iSrc], offset);
+          range.first = std::min(range.first, r.first);
+          range.second = std::max(range.second, r.second);
+        } // for
+      });
+      for (std::pair<int,int> const& range: ranges) {
+        range_trackID.first = std::min(range_trackID.first, range.first);
+        range_trackID.second = std::max(range_trackID.second, range.second);
+      }
+
+      // new elements were added sorted by key
+      if (sorted && (dest.size() > nOriginal)) {
+        std::inplace_merge(dest.begin(), dest.begin() + nOriginal, dest.end(),
+          [&keyOf](auto const& a, auto const& b){ return keyOf(a) < keyOf(b); });
+      }
+
+      return range_trackID;
+    } // MergeCollectionsByKey()
+
+  } // namespace details
+
+
+  /**
+   * @brief Merges a collection of `sim::SimChannel` into another one.
+   * @tparam ForEach type of the scheduler of the merge tasks
+   * @param dest the collection to merge into
+   * @param src the collection to be merged
+   * @param offset track ID offset applied to the merged deposits
+   * @param forEach scheduler of the merge tasks (default: serial)
+   * @return the range of the track IDs merged, after the offset
+   * @see sim::SimChannel::MergeSimChannel(), sim::SerialForEach
+   *
+   * Each channel in `src` is merged into the channel with the same ID in
+   * `dest`, which is added if not present. Different channels are merged by
+   * independent tasks, scheduled by `forEach`.
+   * If `dest` is sorted by channel, it stays sorted.
+   */
+  template <typename ForEach = SerialForEach>
+  std::pair<int,int> MergeSimChannels(
+    std::vector<sim::SimChannel>& dest,
+    std::vector<sim::SimChannel> const& src,
+    int offset,
+    ForEach&& forEach = ForEach{}
+  ) {
+    return details::MergeCollectionsByKey(dest, src, offset,
+      [](sim::SimChannel const& ch){ return ch.Channel(); },
+      [](raw::ChannelID_t channel){ return sim::SimChannel(channel); },
+      [](sim::SimChannel& d, sim::SimChannel const& s, int off)
+        { return d.MergeSimChannel(s, off); },
+      std::forward<ForEach>(forEach)
+      );
+  } // MergeSimChannels()
+
+
+  /**
+   * @brief Merges a collection of `sim::OpDetBacktrackerRecord` into another.
+   * @tparam ForEach type of the scheduler of the merge tasks
+   * @param dest the collection to merge into
+   * @param src the collection to be merged
+   * @param offset track ID offset applied to the merged deposits
+   * @param forEach scheduler of the merge tasks (default: serial)
+   * @return the range of the track IDs merged, after the offset
+   * @see sim::OpDetBacktrackerRecord::MergeOpDetBacktrackerRecord(),
+   *      MergeSimChannels()
+   *
+   * Records are matched by optical detector number.
+   */
+  template <typename ForEach = SerialForEach>
+  std::pair<int,int> MergeOpDetBacktrackerRecords(
+    std::vector<sim::OpDetBacktrackerRecord>& dest,
+    std::vector<sim::OpDetBacktrackerRecord> const& src,
+    int offset,
+    ForEach&& forEach = ForEach{}
+  ) {
+    return details::MergeCollectionsByKey(dest, src, offset,
+      [](sim::OpDetBacktrackerRecord const& rec){ return rec.OpDetNum(); },
+      [](int opDet){ return sim::OpDetBacktrackerRecord(opDet); },
+      [](sim::OpDetBacktrackerRecord& d, sim::OpDetBacktrackerRecord const& s,
+        int off)
+        { return d.MergeOpDetBacktrackerRecord(s, off); },
+      std::forward<ForEach>(forEach)
+      );
+  } // MergeOpDetBacktrackerRecords()
+
+
+  /**
+   * @brief Merges a collection of `sim::AuxDetSimChannel` into another one.
+   * @tparam ForEach type of the scheduler of the merge tasks
+   * @param dest the collection to merge into
+   * @param src the collection to be merged
+   * @param offset track ID offset applied to the merged deposits
+   * @param forEach scheduler of the merge tasks (default: serial)
+   * @return the range of the track IDs merged, after the offset
+   * @see sim::AuxDetSimChannel::MergeAuxDetSimChannel(), MergeSimChannels()
+   *
+   * Channels are matched by auxiliary detector and sensitive volume IDs.
+   */
+  template <typename ForEach = SerialForEach>
+  std::pair<int,int> MergeAuxDetSimChannels(
+    std::vector<sim::AuxDetSimChannel>& dest,
+    std::vector<sim::AuxDetSimChannel> const& src,
+    int offset,
+    ForEach&& forEach = ForEach{}
+  ) {
+    return details::MergeCollectionsByKey(dest, src, offset,
+      [](sim::AuxDetSimChannel const& ch)
+        { return std::make_pair(ch.AuxDetID(), ch.AuxDetSensitiveID()); },
+      [](std::pair<uint32_t, uint32_t> const& key)
+        { return sim::AuxDetSimChannel(key.first, key.second); },
+      [](sim::AuxDetSimChannel& d, sim::AuxDetSimChannel const& s, int off)
+        { return d.MergeAuxDetSimChannel(s, off); },
+      std::forward<ForEach>(forEach)
+      );
+  } // MergeAuxDetSimChannels()
+
+} // namespace sim
+
+
+#endif // LARDATAOBJ_SIMULATION_MERGESIMCOLLECTIONS_H
+
+////////////////////////////////////////////////////////////////////////
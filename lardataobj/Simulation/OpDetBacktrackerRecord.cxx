@@ -12,7 +12,6 @@
 #include <utility>
 #include <stdexcept>
 #include <algorithm> // std::lower_bound(), std::max()
-#include <map>
 
 #include "lardataobj/Simulation/OpDetBacktrackerRecord.h"
 #include "lardataobj/Simulation/sim.h"
@@ -185,17 +184,29 @@ namespace sim{
   std::vector<sim::SDP> OpDetBacktrackerRecord::TrackIDsAndEnergies(timePDclock_t startTimePDclock,
                                                         timePDclock_t endTimePDclock) const
   {
-    // make a map of track ID values to sim::SDP objects
+    std::vector<sim::SDP> sdps;
+    TrackIDsAndEnergies(startTimePDclock, endTimePDclock, sdps);
+    return sdps;
+  }
+
+  //-----------------------------------------------------------------------
+  // the start and end iTimePDclock values are assumed to be inclusive
+  std::vector<sim::SDP> const& OpDetBacktrackerRecord::TrackIDsAndEnergies(
+    timePDclock_t startTimePDclock, timePDclock_t endTimePDclock,
+    std::vector<sim::SDP>& sdps
+  ) const
+  {
+    // the SDPs are accumulated in `sdps`, kept sorted by track ID
+
+    sdps.clear();
 
     if(startTimePDclock > endTimePDclock ){
       mf::LogWarning("OpDetBacktrackerRecord") << "requested TimePDclock range is bogus: "
 				   << startTimePDclock << " " << endTimePDclock
 				   << " return empty vector";
-      return {}; // returns an empty vector
+      return sdps; // returns an empty vector
     }
 
-    std::map<TrackID_t, sim::SDP> idToSDP;
-
       //find the lower bound for this iTimePDclock and then iterate from there
     auto itr = findClosestTimePDclockSDP(startTimePDclock);
 
@@ -207,12 +218,13 @@ namespace sim{
 
       // grab the vector of SDPs for this TimePDclock
       auto const& sdplist = itr->second;
-      // now loop over them and add their content to the map
+      // now loop over them and add their content to the list
       for(auto const& sdp : sdplist){
-        auto itTrkSDP = idToSDP.find(sdp.trackID);
-        if( itTrkSDP != idToSDP.end() ){
+        auto itTrkSDP = std::lower_bound(sdps.begin(), sdps.end(), sdp.trackID,
+          [](sim::SDP const& a, TrackID_t id){ return a.trackID < id; });
+        if( (itTrkSDP != sdps.end()) && (itTrkSDP->trackID == sdp.trackID) ){
           // the SDP we are going to update:
-          sim::SDP& trackSDP = itTrkSDP->second;
+          sim::SDP& trackSDP = *itTrkSDP;
 
           double const nPh1   = trackSDP.numPhotons;
           double const nPh2   = sdp.numPhotons;
@@ -225,20 +237,13 @@ namespace sim{
           trackSDP.numPhotons = weight;
         } // end if the track id for this one is found
         else{
-          idToSDP[sdp.trackID] = sim::SDP(sdp);
+          sdps.insert(itTrkSDP, sdp);
         }
       } // end loop over vector
 
       ++itr;
     } // end loop over iTimePDclock values
 
-      // now fill the vector with the sdps from the map
-    std::vector<sim::SDP> sdps;
-    sdps.reserve(idToSDP.size());
-    for(auto const& itr : idToSDP){
-      sdps.push_back(itr.second);
-    }
-
     return sdps;
   }
 
@@ -247,8 +252,21 @@ namespace sim{
   std::vector<sim::TrackSDP>  OpDetBacktrackerRecord::TrackSDPs(timePDclock_t startTimePDclock,
                                                     timePDclock_t endTimePDclock) const
   {
-
     std::vector<sim::TrackSDP> trackSDPs;
+    std::vector<sim::SDP> sdps;
+    TrackSDPs(startTimePDclock, endTimePDclock, trackSDPs, sdps);
+    return trackSDPs;
+  }
+
+  //-----------------------------------------------------------------------
+  // the start and end iTimePDclock values are assumed to be inclusive
+  std::vector<sim::TrackSDP> const& OpDetBacktrackerRecord::TrackSDPs(
+    timePDclock_t startTimePDclock, timePDclock_t endTimePDclock,
+    std::vector<sim::TrackSDP>& trackSDPs, std::vector<sim::SDP>& sdps
+  ) const
+  {
+
+    trackSDPs.clear();
 
     if(startTimePDclock > endTimePDclock ){
       mf::LogWarning("OpDetBacktrackerRecord::TrackSDPs") << "requested iTimePDclock range is bogus: "
@@ -258,14 +276,14 @@ namespace sim{
     }
 
     double totalPhotons = 0.;
-    std::vector<sim::SDP> const sdps = TrackIDsAndEnergies(startTimePDclock, endTimePDclock);
+    TrackIDsAndEnergies(startTimePDclock, endTimePDclock, sdps);
     for (auto const& sdp : sdps)
       totalPhotons += sdp.numPhotons;
 
     // protect against a divide by zero below
     if(totalPhotons < 1.e-5) totalPhotons = 1.;
 
-    // loop over the entries in the map and fill the input vectors
+    // loop over the entries in the list and fill the output vector
     for (auto const& sdp : sdps){
       if(sdp.trackID == sim::NoParticleId) continue;
       trackSDPs.emplace_back(sdp.trackID, sdp.numPhotons/totalPhotons, sdp.numPhotons);
@@ -288,26 +306,43 @@ namespace sim{
     std::pair<TrackID_t,TrackID_t> range_trackID(std::numeric_limits<int>::max(),
                                                  std::numeric_limits<int>::min());
 
-    for(auto const& itr : channel.timePDclockSDPsMap()){
-
-      auto iTimePDclock  = itr.first;
-      auto const& sdps = itr.second;
-
-      // find the entry from this OpDetBacktrackerRecord corresponding to the iTimePDclock from the other
-      auto itrthis = findClosestTimePDclockSDP(iTimePDclock);
+    timePDclockSDPs_t const& other = channel.timePDclockSDPsMap();
+
+    // both lists are sorted by time: merge them in a single pass;
+    // first count the times of the result, to allocate it only once
+    std::size_t nTimes = 0;
+    auto itrthis = timePDclockSDPs.cbegin(), itrother = other.cbegin();
+    while ((itrthis != timePDclockSDPs.cend()) || (itrother != other.cend())) {
+      ++nTimes;
+      if (itrother == other.cend()) ++itrthis;
+      else if (itrthis == timePDclockSDPs.cend()) ++itrother;
+      else if (itrthis->first < itrother->first) ++itrthis;
+      else if (itrother->first < itrthis->first) ++itrother;
+      else { ++itrthis; ++itrother; }
+    } // while
+
+    timePDclockSDPs_t merged;
+    merged.reserve(nTimes);
+    auto itr = timePDclockSDPs.begin();
+    for(auto const& otherTime : other){
+
+      auto iTimePDclock  = otherTime.first;
+      auto const& sdps = otherTime.second;
+
+      // times only in this OpDetBacktrackerRecord are kept as they are
+      while ((itr != timePDclockSDPs.end()) && (itr->first < iTimePDclock))
+        merged.push_back(std::move(*itr++));
 
       // pick which SDP list we have to fill: new one or existing one
-      std::vector<sim::SDP>* curSDPVec;
-      if(itrthis        == timePDclockSDPs.end() ||
-         itrthis->first != iTimePDclock){
-        timePDclockSDPs.emplace_back(iTimePDclock, std::vector<sim::SDP>());
-        curSDPVec = &(timePDclockSDPs.back().second);
-      }
+      if ((itr != timePDclockSDPs.end()) && (itr->first == iTimePDclock))
+        merged.push_back(std::move(*itr++));
       else
-        curSDPVec = &(itrthis->second);
+        merged.emplace_back(iTimePDclock, std::vector<sim::SDP>());
+      std::vector<sim::SDP>& curSDPVec = merged.back().second;
 
+      curSDPVec.reserve(curSDPVec.size() + sdps.size());
       for(auto const& sdp : sdps){
-        curSDPVec->emplace_back(sdp, offset);
+        curSDPVec.emplace_back(sdp, offset);
         if( sdp.trackID+offset < range_trackID.first  )
           range_trackID.first = sdp.trackID+offset;
         if( sdp.trackID+offset > range_trackID.second )
@@ -315,7 +350,9 @@ namespace sim{
       }//end loop over SDPs
 
     }//end loop over TimePDclockSDPMap
+    while (itr != timePDclockSDPs.end()) merged.push_back(std::move(*itr++));
 
+    timePDclockSDPs = std::move(merged);
 
     return range_trackID;
 
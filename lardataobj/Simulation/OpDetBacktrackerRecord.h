@@ -188,6 +188,24 @@ namespace sim {
     std::vector<sim::SDP> TrackIDsAndEnergies(timePDclock_t startTimePDclock,
                                               timePDclock_t endTimePDclock) const;
 
+    /**
+     * @brief Fills a container with the energy deposited by each track
+     * @param startTimePDclock iTimePDclock tick opening the time window
+     * @param endTimePDclock iTimePDclock tick closing the time window (included in the interval)
+     * @param sdps the container to be filled (its content is replaced)
+     * @return a reference to `sdps`, with one entry per track
+     * @see TrackIDsAndEnergies(timePDclock_t, timePDclock_t) const
+     *
+     * The content is the same as the one returned by
+     * `TrackIDsAndEnergies(timePDclock_t, timePDclock_t) const`, sorted by
+     * track ID. The entries are accumulated directly in `sdps`, so that when
+     * the same container is reused for many calls no new memory is allocated.
+     */
+    std::vector<sim::SDP> const& TrackIDsAndEnergies(
+      timePDclock_t startTimePDclock, timePDclock_t endTimePDclock,
+      std::vector<sim::SDP>& sdps
+      ) const;
+
     /**
      * @brief Returns all the deposited energy information as stored
      * @return all the deposited energy information as stored in the object
@@ -234,6 +252,24 @@ namespace sim {
     std::vector<sim::TrackSDP> TrackSDPs(timePDclock_t startTimePDclock,
                                          timePDclock_t endTimePDclock) const;
 
+    /**
+     * @brief Fills a container with the energy collected for each track
+     * @param startTimePDclock iTimePDclock tick opening the time window
+     * @param endTimePDclock iTimePDclock tick closing the time window (included in the interval)
+     * @param trackSDPs the container to be filled (its content is replaced)
+     * @param sdps a work area for the accumulation (its content is replaced)
+     * @return a reference to `trackSDPs`
+     * @see TrackSDPs(timePDclock_t, timePDclock_t) const
+     *
+     * The content is the same as the one returned by
+     * `TrackSDPs(timePDclock_t, timePDclock_t) const`. When the same
+     * containers are reused for many calls no new memory is allocated.
+     */
+    std::vector<sim::TrackSDP> const& TrackSDPs(
+      timePDclock_t startTimePDclock, timePDclock_t endTimePDclock,
+      std::vector<sim::TrackSDP>& trackSDPs, std::vector<sim::SDP>& sdps
+      ) const;
+
     /// Comparison: sorts by Optical Detector ID
     bool operator<  (const OpDetBacktrackerRecord& other)     const;
 
@@ -286,6 +322,8 @@ namespace sim {
 
 
   private:
+    friend class OpDetBacktrackerRecordBuilder; // adds many deposits at once
+
     /// Comparison functor, sorts by increasing timePDclocktick value
     struct CompareByTimePDclock;
 
@@ -0,0 +1,174 @@
+///
+/// \file  Simulation/OpDetBacktrackerRecordBuilder.cxx
+///
+/// \brief Helper to fill a `sim::OpDetBacktrackerRecord` with many deposits.
+///
+////////////////////////////////////////////////////////////////////////
+
+#include <limits> // std::numeric_limits
+#include <utility> // std::move()
+#include <algorithm> // std::sort(), std::find_if()
+#include <tuple> // std::tie()
+#include <cmath> // std::round()
+
+#include "lardataobj/Simulation/OpDetBacktrackerRecordBuilder.h"
+
+#include "messagefacility/MessageLogger/MessageLogger.h"
+
+namespace sim{
+
+  //-------------------------------------------------
+  OpDetBacktrackerRecordBuilder::OpDetBacktrackerRecordBuilder
+    (int opDet, timePDclock_t timeBinWidth /* = 1.0 */)
+    : fRecord(opDet)
+    , fTimeBinWidth(timeBinWidth)
+  {}
+
+  //-------------------------------------------------
+  OpDetBacktrackerRecordBuilder::OpDetBacktrackerRecordBuilder
+    (OpDetBacktrackerRecord record, timePDclock_t timeBinWidth /* = 1.0 */)
+    : fRecord(std::move(record))
+    , fTimeBinWidth(timeBinWidth)
+  {}
+
+  //-------------------------------------------------
+  auto OpDetBacktrackerRecordBuilder::BinnedTime(timePDclock_t time) const
+    -> storedTimePDclock_t
+  {
+    if (fTimeBinWidth <= 0.) return time;
+    return std::round(time / fTimeBinWidth) * fTimeBinWidth;
+  } // OpDetBacktrackerRecordBuilder::BinnedTime()
+
+  //-------------------------------------------------
+  void OpDetBacktrackerRecordBuilder::AddScintillationPhotons
+    (TrackID_t     trackID,
+     timePDclock_t timePDclock,
+     double        numberPhotons,
+     double const* xyz,
+     double        energy)
+  {
+    // no photons? no good!
+    if ((numberPhotons < std::numeric_limits<double>::epsilon())
+      || (energy <= std::numeric_limits<double>::epsilon()))
+    {
+      MF_LOG_ERROR("OpDetBacktrackerRecordBuilder")
+      << "AddScintillationPhotons() trying to add to iTimePDclock #"
+      << timePDclock
+      << " "
+      << numberPhotons
+      << " photons with "
+      << energy
+      << " MeV of energy from track ID="
+      << trackID;
+      return;
+    } // if no photons
+
+    fDeposits.push_back({
+      fDeposits.size(), trackID, BinnedTime(timePDclock),
+      numberPhotons, energy, xyz[0], xyz[1], xyz[2]
+      });
+
+  } // OpDetBacktrackerRecordBuilder::AddScintillationPhotons()
+
+
+  //-------------------------------------------------
+  OpDetBacktrackerRecord OpDetBacktrackerRecordBuilder::Build()
+  {
+    // sort by time, then by track, then in the order the deposits were added
+    std::sort(fDeposits.begin(), fDeposits.end(),
+      [](Deposit_t const& a, Deposit_t const& b)
+        {
+          return std::tie(a.time, a.trackID, a.order)
+            < std::tie(b.time, b.trackID, b.order);
+        }
+      );
+
+    OpDetBacktrackerRecord::timePDclockSDPs_t& oldTimeSDPs
+      = fRecord.timePDclockSDPs;
+
+    std::size_t nNewTimes = 0;
+    for (std::size_t i = 0; i < fDeposits.size(); ++i)
+      if ((i == 0) || (fDeposits[i].time != fDeposits[i - 1].time)) ++nNewTimes;
+
+    // merge the old time list and the new deposits, both sorted by time
+    OpDetBacktrackerRecord::timePDclockSDPs_t timeSDPs;
+    timeSDPs.reserve(oldTimeSDPs.size() + nNewTimes);
+    auto iOld = oldTimeSDPs.begin();
+    auto const oldEnd = oldTimeSDPs.end();
+    auto iDeposit = fDeposits.cbegin();
+    auto const depEnd = fDeposits.cend();
+    while (iDeposit != depEnd) {
+      auto const time = iDeposit->time;
+      auto iNext = iDeposit;
+      while ((iNext != depEnd) && (iNext->time == time)) ++iNext;
+
+      while ((iOld != oldEnd) && (iOld->first < time))
+        timeSDPs.push_back(std::move(*iOld++));
+      if ((iOld != oldEnd) && (iOld->first == time))
+        timeSDPs.push_back(std::move(*iOld++));
+      else
+        timeSDPs.emplace_back(time, std::vector<sim::SDP>());
+
+      MergeDeposits(timeSDPs.back().second, iDeposit, iNext);
+      iDeposit = iNext;
+    } // while
+    while (iOld != oldEnd) timeSDPs.push_back(std::move(*iOld++));
+
+    oldTimeSDPs = std::move(timeSDPs);
+    fDeposits.clear();
+
+    OpDetBacktrackerRecord record { std::move(fRecord) };
+    fRecord = OpDetBacktrackerRecord(record.OpDetNum());
+    return record;
+  } // OpDetBacktrackerRecordBuilder::Build()
+
+
+  //-------------------------------------------------
+  void OpDetBacktrackerRecordBuilder::MergeDeposits(
+    std::vector<sim::SDP>& sdps,
+    std::vector<Deposit_t>::const_iterator begin,
+    std::vector<Deposit_t>::const_iterator end
+  ) {
+    // deposits are sorted by track, and for each track in insertion order;
+    // the merging follows `OpDetBacktrackerRecord::AddScintillationPhotons()`
+    auto const nOldSDPs = sdps.size();
+
+    std::vector<std::pair<std::size_t, sim::SDP>> newSDPs;
+    while (begin != end) {
+      TrackID_t const trackID = begin->trackID;
+
+      // the first SDP of this track already in the record, if any
+      auto const oldEnd = sdps.begin() + nOldSDPs;
+      auto iSDP = std::find_if(sdps.begin(), oldEnd,
+        [trackID](sim::SDP const& sdp){ return sdp.trackID == trackID; });
+      sim::SDP* sdp = nullptr;
+      if (iSDP != oldEnd) sdp = &*iSDP;
+      else {
+        newSDPs.emplace_back(begin->order, sim::SDP(trackID,
+          begin->numPhotons, begin->energy, begin->x, begin->y, begin->z));
+        sdp = &(newSDPs.back().second);
+        ++begin;
+      }
+
+      for (; (begin != end) && (begin->trackID == trackID); ++begin) {
+        // make a weighted average for the location information
+        double weight    = sdp->numPhotons + begin->numPhotons;
+        sdp->x           = (sdp->x * sdp->numPhotons + begin->x*begin->numPhotons)/weight;
+        sdp->y           = (sdp->y * sdp->numPhotons + begin->y*begin->numPhotons)/weight;
+        sdp->z           = (sdp->z * sdp->numPhotons + begin->z*begin->numPhotons)/weight;
+        sdp->numPhotons  = weight;
+        sdp->energy      = sdp->energy + begin->energy;
+      } // for deposits of this track
+    } // while
+
+    // new tracks are added in the order of their first deposit
+    std::sort(newSDPs.begin(), newSDPs.end(),
+      [](auto const& a, auto const& b){ return a.first < b.first; });
+    sdps.reserve(sdps.size() + newSDPs.size());
+    for (auto& newSDP: newSDPs) sdps.push_back(std::move(newSDP.second));
+
+  } // OpDetBacktrackerRecordBuilder::MergeDeposits()
+
+
+}
+////////////////////////////////////////////////////////////////////////
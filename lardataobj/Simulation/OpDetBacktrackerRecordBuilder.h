@@ -0,0 +1,167 @@
+/**
+ * @file   lardataobj/Simulation/OpDetBacktrackerRecordBuilder.h
+ * @brief  Helper to fill a `sim::OpDetBacktrackerRecord` with many deposits.
+ * @see    lardataobj/Simulation/OpDetBacktrackerRecordBuilder.cxx
+ */
+
+#ifndef LARDATAOBJ_SIMULATION_OPDETBACKTRACKERRECORDBUILDER_H
+#define LARDATAOBJ_SIMULATION_OPDETBACKTRACKERRECORDBUILDER_H
+
+// LArSoftObj libraries
+#include "lardataobj/Simulation/OpDetBacktrackerRecord.h"
+
+// C/C++ standard libraries
+#include <vector>
+#include <cstddef> // std::size_t
+
+
+namespace sim {
+
+  /**
+   * @brief Collects photon deposits and adds them to a
+   *        `sim::OpDetBacktrackerRecord` at once.
+   *
+   * `sim::OpDetBacktrackerRecord::AddScintillationPhotons()` keeps the record
+   * content sorted at every call, inserting new times in the middle of the
+   * list. With fast optical simulation, where that is called for each photon
+   * batch on each optical detector, this becomes expensive.
+   *
+   * This builder has the same `AddScintillationPhotons()` interface, but it
+   * only appends the deposits to a buffer. When `Build()` is called, the
+   * buffer is sorted by time and track, and all deposits are merged into the
+   * record in a single pass.
+   *
+   * Time binning
+   * -------------
+   *
+   * The time of each deposit is assigned to a bin of the width specified on
+   * construction, and all the deposits in the same bin share the same time
+   * entry, whose time is the one of the center of the bin.
+   * The default width, `1` ns, rounds the times to the closest integer.
+   * This only approximates
+   * `sim::OpDetBacktrackerRecord::AddScintillationPhotons()`.
+   * That method compares each deposit only with the first entry not earlier
+   * than it, and adds the deposit to that entry if their times are within
+   * 0.5 ns. Otherwise it creates a new entry, even when an earlier entry is
+   * within 0.5 ns. The two records are guaranteed to be the same only when
+   * all the deposit times are integral.
+   * A larger width (e.g. the period of the optical detector digitizer clock)
+   * reduces the number of time entries and of `sim::SDP` in the record.
+   * A width of `0` disables binning, and each distinct time has its own entry.
+   *
+   * In each time entry, deposits from tracks already present are merged into
+   * the existing `sim::SDP` (with the same weighted average of the position
+   * as `AddScintillationPhotons()`), and the new tracks are appended in the
+   * order of their first deposit.
+   *
+   * Example:
+   * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.cpp}
+   * sim::OpDetBacktrackerRecordBuilder builder { opDet, 2.0 }; // 2 ns bins
+   * for (auto const& photons: photonBatches) {
+   *   builder.AddScintillationPhotons
+   *     (photons.trackID, photons.time, photons.n, photons.xyz, photons.energy);
+   * }
+   * sim::OpDetBacktrackerRecord record = builder.Build();
+   * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+   */
+  class OpDetBacktrackerRecordBuilder {
+  public:
+    using timePDclock_t = OpDetBacktrackerRecord::timePDclock_t;
+    using storedTimePDclock_t = OpDetBacktrackerRecord::storedTimePDclock_t;
+    using TrackID_t = OpDetBacktrackerRecord::TrackID_t;
+
+    /// A single photon deposit waiting to be added to the record.
+    struct Deposit_t {
+      std::size_t order;        ///< Position of the deposit in the buffer.
+      TrackID_t trackID;        ///< Geant4 supplied track ID.
+      storedTimePDclock_t time; ///< Time of the entry (after binning) [ns].
+      double numPhotons;        ///< Photons detected.
+      double energy;            ///< Deposited energy [MeV].
+      double x;                 ///< x position of ionization [cm].
+      double y;                 ///< y position of ionization [cm].
+      double z;                 ///< z position of ionization [cm].
+    }; // Deposit_t
+
+
+    /**
+     * @brief Constructor: builds a record with no deposits.
+     * @param opDet number of the optical detector
+     * @param timeBinWidth (default: `1`) width of the time bins [ns]
+     */
+    explicit OpDetBacktrackerRecordBuilder
+      (int opDet, timePDclock_t timeBinWidth = 1.0);
+
+    /**
+     * @brief Constructor: new deposits will be added to the content of `record`.
+     * @param record the record to be extended
+     * @param timeBinWidth (default: `1`) width of the time bins [ns]
+     *
+     * Time entries already in `record` are extended only by deposits whose
+     * binned time is exactly the same.
+     */
+    explicit OpDetBacktrackerRecordBuilder
+      (OpDetBacktrackerRecord record, timePDclock_t timeBinWidth = 1.0);
+
+    /**
+     * @brief Queues scintillation photons and energy for this detector.
+     * @param trackID ID of simulated track depositing this energy (from Geant4)
+     * @param timePDclock time when this deposit was collected [ns]
+     * @param numberPhotons photons detected at this time from this track
+     * @param xyz coordinates of original location of ionization (3D array) [cm]
+     * @param energy energy deposited at this point by this track [MeV]
+     * @see sim::OpDetBacktrackerRecord::AddScintillationPhotons()
+     *
+     * Deposits with no photons or no energy are rejected with an error
+     * message, as in `sim::OpDetBacktrackerRecord::AddScintillationPhotons()`.
+     */
+    void AddScintillationPhotons(TrackID_t trackID,
+                                 timePDclock_t timePDclock,
+                                 double numberPhotons,
+                                 double const* xyz,
+                                 double energy);
+
+    /// Prepares the buffer for `n` deposits in total.
+    void Reserve(std::size_t n) { fDeposits.reserve(n); }
+
+    /// Returns the number of deposits waiting to be added.
+    std::size_t NDeposits() const { return fDeposits.size(); }
+
+    /// Returns the optical detector being built.
+    int OpDetNum() const { return fRecord.OpDetNum(); }
+
+    /// Returns the width of the time bins (`0` if no binning) [ns].
+    timePDclock_t TimeBinWidth() const { return fTimeBinWidth; }
+
+    /// Returns the time of the entry `time` is assigned to [ns].
+    storedTimePDclock_t BinnedTime(timePDclock_t time) const;
+
+    /**
+     * @brief Adds all the queued deposits to the record and returns it.
+     * @return the record with all the deposits
+     *
+     * After this call the builder is left with an empty record with the same
+     * optical detector number, and no queued deposits.
+     */
+    OpDetBacktrackerRecord Build();
+
+
+  private:
+    OpDetBacktrackerRecord fRecord; ///< The record being built.
+    timePDclock_t fTimeBinWidth; ///< Width of the time bins [ns].
+    std::vector<Deposit_t> fDeposits; ///< Deposits not yet in the record.
+
+    /// Adds to `sdps` all the deposits in `[ begin, end [` (all at one time).
+    static void MergeDeposits(
+      std::vector<sim::SDP>& sdps,
+      std::vector<Deposit_t>::const_iterator begin,
+      std::vector<Deposit_t>::const_iterator end
+      );
+
+  }; // class OpDetBacktrackerRecordBuilder
+
+} // namespace sim
+
+
+#endif // LARDATAOBJ_SIMULATION_OPDETBACKTRACKERRECORDBUILDER_H
+
+////////////////////////////////////////////////////////////////////////
@@ -9,8 +9,7 @@
 #include <limits> // std::numeric_limits
 #include <utility>
 #include <stdexcept>
-#include <algorithm> // std::lower_bound(), std::max()
-#include <map>
+#include <algorithm> // std::lower_bound(), std::max(), std::fill()
 
 #include "lardataobj/Simulation/SimChannel.h"
 #include "lardataobj/Simulation/sim.h"
@@ -18,6 +17,31 @@
 
 #include "messagefacility/MessageLogger/MessageLogger.h"
 
+namespace {
+
+  /// Sums `member` of the IDEs in each TDC from `startTDC` into `values`.
+  void FillPerTick(
+    sim::SimChannel::TDCIDEs_t const& TDCIDEs, float sim::IDE::* member,
+    double* values, std::size_t nTicks, sim::SimChannel::TDC_t startTDC
+  ) {
+    std::fill(values, values + nTicks, 0.);
+
+    auto itr = std::lower_bound(TDCIDEs.begin(), TDCIDEs.end(), startTDC,
+      [](sim::TDCIDE const& a, sim::SimChannel::TDC_t tdc)
+        { return a.first < tdc; }
+      );
+    for (; itr != TDCIDEs.end(); ++itr) {
+      std::size_t const tick = itr->first - startTDC;
+      if (tick >= nTicks) break;
+
+      double sum = 0.;
+      for (auto const& ide: itr->second) sum += ide.*member;
+      values[tick] = sum;
+    } // for
+  } // FillPerTick()
+
+} // local namespace
+
 namespace sim{
 
   //-------------------------------------------------
@@ -173,22 +197,47 @@ namespace sim{
   }
 
 
+  //-------------------------------------------------
+  void SimChannel::FillCharges
+    (double* charges, std::size_t nTicks, TDC_t startTDC) const
+  {
+    FillPerTick(fTDCIDEs, &sim::IDE::numElectrons, charges, nTicks, startTDC);
+  }
+
+  //-------------------------------------------------
+  void SimChannel::FillEnergies
+    (double* energies, std::size_t nTicks, TDC_t startTDC) const
+  {
+    FillPerTick(fTDCIDEs, &sim::IDE::energy, energies, nTicks, startTDC);
+  }
+
+
   //-----------------------------------------------------------------------
   // the start and end tdc values are assumed to be inclusive
   std::vector<sim::IDE> SimChannel::TrackIDsAndEnergies(TDC_t startTDC,
                                                         TDC_t endTDC) const
   {
-    // make a map of track ID values to sim::IDE objects
+    std::vector<sim::IDE> ides;
+    TrackIDsAndEnergies(startTDC, endTDC, ides);
+    return ides;
+  }
+
+  //-----------------------------------------------------------------------
+  // the start and end tdc values are assumed to be inclusive
+  std::vector<sim::IDE> const& SimChannel::TrackIDsAndEnergies
+    (TDC_t startTDC, TDC_t endTDC, std::vector<sim::IDE>& ides) const
+  {
+    // the IDEs are accumulated in `ides`, kept sorted by track ID
+
+    ides.clear();
 
     if(startTDC > endTDC ){
       mf::LogWarning("SimChannel") << "requested tdc range is bogus: "
 				   << startTDC << " " << endTDC
 				   << " return empty vector";
-      return {}; // returns an empty vector
+      return ides; // returns an empty vector
     }
 
-    std::map<TrackID_t, sim::IDE> idToIDE;
-
       //find the lower bound for this tdc and then iterate from there
     auto itr = findClosestTDCIDE(startTDC);
 
@@ -200,12 +249,13 @@ namespace sim{
 
       // grab the vector of IDEs for this tdc
       auto const& idelist = itr->second;
-      // now loop over them and add their content to the map
+      // now loop over them and add their content to the list
       for(auto const& ide : idelist){
-        auto itTrkIDE = idToIDE.find(ide.trackID);
-        if( itTrkIDE != idToIDE.end() ){
+        auto itTrkIDE = std::lower_bound(ides.begin(), ides.end(), ide.trackID,
+          [](sim::IDE const& a, TrackID_t id){ return a.trackID < id; });
+        if( (itTrkIDE != ides.end()) && (itTrkIDE->trackID == ide.trackID) ){
           // the IDE we are going to update:
-          sim::IDE& trackIDE = itTrkIDE->second;
+          sim::IDE& trackIDE = *itTrkIDE;
 
           double const nel1   = trackIDE.numElectrons;
           double const nel2   = ide.numElectrons;
@@ -222,20 +272,13 @@ namespace sim{
           trackIDE.energy = energy;
         } // end if the track id for this one is found
         else{
-          idToIDE[ide.trackID] = sim::IDE(ide);
+          ides.insert(itTrkIDE, ide);
         }
       } // end loop over vector
 
       ++itr;
     } // end loop over tdc values
 
-      // now fill the vector with the ides from the map
-    std::vector<sim::IDE> ides;
-    ides.reserve(idToIDE.size());
-    for(auto const& itr : idToIDE){
-      ides.push_back(itr.second);
-    }
-
     return ides;
   }
 
@@ -244,8 +287,21 @@ namespace sim{
   std::vector<sim::TrackIDE>  SimChannel::TrackIDEs(TDC_t startTDC,
                                                     TDC_t endTDC) const
   {
-
     std::vector<sim::TrackIDE> trackIDEs;
+    std::vector<sim::IDE> ides;
+    TrackIDEs(startTDC, endTDC, trackIDEs, ides);
+    return trackIDEs;
+  }
+
+  //-----------------------------------------------------------------------
+  // the start and end tdc values are assumed to be inclusive
+  std::vector<sim::TrackIDE> const& SimChannel::TrackIDEs(
+    TDC_t startTDC, TDC_t endTDC,
+    std::vector<sim::TrackIDE>& trackIDEs, std::vector<sim::IDE>& ides
+  ) const
+  {
+
+    trackIDEs.clear();
 
     if(startTDC > endTDC ){
       mf::LogWarning("SimChannel::TrackIDEs") << "requested tdc range is bogus: "
@@ -255,14 +311,14 @@ namespace sim{
     }
 
     double totalE = 0.;
-    std::vector<sim::IDE> const ides = TrackIDsAndEnergies(startTDC, endTDC);
+    TrackIDsAndEnergies(startTDC, endTDC, ides);
     for (auto const& ide : ides)
       totalE += ide.energy;
 
     // protect against a divide by zero below
     if(totalE < 1.e-5) totalE = 1.;
 
-    // loop over the entries in the map and fill the input vectors
+    // loop over the entries in the list and fill the output vector
     for (auto const& ide : ides){
       if(ide.trackID == sim::NoParticleId) continue;
       trackIDEs.emplace_back(ide.trackID, ide.energy/totalE, ide.energy, ide.numElectrons);
@@ -285,26 +341,43 @@ namespace sim{
     std::pair<TrackID_t,TrackID_t> range_trackID(std::numeric_limits<int>::max(),
                                                  std::numeric_limits<int>::min());
 
-    for(auto const& itr : channel.TDCIDEMap()){
-
-      auto tdc  = itr.first;
-      auto const& ides = itr.second;
-
-      // find the entry from this SimChannel corresponding to the tdc from the other
-      auto itrthis = findClosestTDCIDE(tdc);
+    TDCIDEs_t const& other = channel.TDCIDEMap();
+
+    // both lists are sorted by TDC: merge them in a single pass;
+    // first count the TDCs of the result, to allocate it only once
+    std::size_t nTDCs = 0;
+    auto itrthis = fTDCIDEs.cbegin(), itrother = other.cbegin();
+    while ((itrthis != fTDCIDEs.cend()) || (itrother != other.cend())) {
+      ++nTDCs;
+      if (itrother == other.cend()) ++itrthis;
+      else if (itrthis == fTDCIDEs.cend()) ++itrother;
+      else if (itrthis->first < itrother->first) ++itrthis;
+      else if (itrother->first < itrthis->first) ++itrother;
+      else { ++itrthis; ++itrother; }
+    } // while
+
+    TDCIDEs_t merged;
+    merged.reserve(nTDCs);
+    auto itr = fTDCIDEs.begin();
+    for(auto const& otherTDC : other){
+
+      auto tdc  = otherTDC.first;
+      auto const& ides = otherTDC.second;
+
+      // TDCs only in this SimChannel are kept as they are
+      while ((itr != fTDCIDEs.end()) && (itr->first < tdc))
+        merged.push_back(std::move(*itr++));
 
       // pick which IDE list we have to fill: new one or existing one
-      std::vector<sim::IDE>* curIDEVec;
-      if(itrthis        == fTDCIDEs.end() ||
-         itrthis->first != tdc){
-        fTDCIDEs.emplace_back(tdc, std::vector<sim::IDE>());
-        curIDEVec = &(fTDCIDEs.back().second);
-      }
+      if ((itr != fTDCIDEs.end()) && (itr->first == tdc))
+        merged.push_back(std::move(*itr++));
       else
-        curIDEVec = &(itrthis->second);
+        merged.emplace_back(tdc, std::vector<sim::IDE>());
+      std::vector<sim::IDE>& curIDEVec = merged.back().second;
 
+      curIDEVec.reserve(curIDEVec.size() + ides.size());
       for(auto const& ide : ides){
-        curIDEVec->emplace_back(ide, offset);
+        curIDEVec.emplace_back(ide, offset);
         if( ide.trackID+offset < range_trackID.first  )
           range_trackID.first = ide.trackID+offset;
         if( ide.trackID+offset > range_trackID.second )
@@ -312,7 +385,9 @@ namespace sim{
       }//end loop over IDEs
 
     }//end loop over TDCIDEMap
+    while (itr != fTDCIDEs.end()) merged.push_back(std::move(*itr++));
 
+    fTDCIDEs = std::move(merged);
 
     return range_trackID;
 
@@ -350,6 +425,29 @@ namespace sim{
   }
 
 
+  //-------------------------------------------------
+  void FillChargeMatrix(
+    std::vector<sim::SimChannel> const& channels,
+    double* charges, std::size_t nTicks, SimChannel::TDC_t startTDC
+  ) {
+    for (sim::SimChannel const& channel: channels) {
+      channel.FillCharges(charges, nTicks, startTDC);
+      charges += nTicks;
+    }
+  }
+
+  //-------------------------------------------------
+  void FillEnergyMatrix(
+    std::vector<sim::SimChannel> const& channels,
+    double* energies, std::size_t nTicks, SimChannel::TDC_t startTDC
+  ) {
+    for (sim::SimChannel const& channel: channels) {
+      channel.FillEnergies(energies, nTicks, startTDC);
+      energies += nTicks;
+    }
+  }
+
+
   //-------------------------------------------------
 
 
@@ -18,6 +18,7 @@
 #include <string>
 #include <vector>
 #include <utility> // std::pair
+#include <cstddef> // std::size_t
 
 namespace sim {
 
@@ -178,6 +179,8 @@ namespace sim {
      *
      * The number of electrons can be fractional because of simulated
      * efficiency and physics effects.
+     *
+     * To add many deposits, `sim::SimChannelBuilder` is more efficient.
      */
     void AddIonizationElectrons(TrackID_t trackID,
                                 TDC_t tdc,
@@ -208,6 +211,22 @@ namespace sim {
     std::vector<sim::IDE> TrackIDsAndEnergies(TDC_t startTDC,
                                               TDC_t endTDC) const;
 
+    /**
+     * @brief Fills a container with the energy deposited by each track
+     * @param startTDC TDC tick opening the time window
+     * @param endTDC TDC tick closing the time window (included in the interval)
+     * @param ides the container to be filled (its content is replaced)
+     * @return a reference to `ides`, with one entry per track
+     * @see TrackIDsAndEnergies(TDC_t, TDC_t) const
+     *
+     * The content is the same as the one returned by
+     * `TrackIDsAndEnergies(TDC_t, TDC_t) const`, sorted by track ID.
+     * The entries are accumulated directly in `ides`, so that when the same
+     * container is reused for many calls no new memory is allocated.
+     */
+    std::vector<sim::IDE> const& TrackIDsAndEnergies
+      (TDC_t startTDC, TDC_t endTDC, std::vector<sim::IDE>& ides) const;
+
     /**
      * @brief Returns all the deposited energy information as stored
      * @return all the deposited energy information as stored in the object
@@ -229,6 +248,32 @@ namespace sim {
     /// Returns the total energy on this channel in the specified TDC [MeV]
     double Energy(TDC_t tdc) const;
 
+    /**
+     * @brief Fills a buffer with the ionization electrons in each TDC tick
+     * @param charges buffer to be filled, with at least `nTicks` elements
+     * @param nTicks number of TDC ticks to be filled
+     * @param startTDC TDC tick of the first element of the buffer
+     * @see Charge()
+     *
+     * The element `i` of the buffer is set to `Charge(startTDC + i)`,
+     * including zero for the ticks with no charge.
+     * All ticks are filled in a single pass through the channel content.
+     */
+    void FillCharges
+      (double* charges, std::size_t nTicks, TDC_t startTDC = 0) const;
+
+    /**
+     * @brief Fills a buffer with the energy in each TDC tick [MeV]
+     * @param energies buffer to be filled, with at least `nTicks` elements
+     * @param nTicks number of TDC ticks to be filled
+     * @param startTDC TDC tick of the first element of the buffer
+     * @see Energy(), FillCharges()
+     *
+     * The element `i` of the buffer is set to `Energy(startTDC + i)`.
+     */
+    void FillEnergies
+      (double* energies, std::size_t nTicks, TDC_t startTDC = 0) const;
+
     /**
      * @brief Returns energies collected for each track within a time interval
      * @param startTDC TDC tick opening the time window
@@ -254,6 +299,24 @@ namespace sim {
     std::vector<sim::TrackIDE> TrackIDEs(TDC_t startTDC,
                                          TDC_t endTDC) const;
 
+    /**
+     * @brief Fills a container with the energy collected for each track
+     * @param startTDC TDC tick opening the time window
+     * @param endTDC TDC tick closing the time window (included in the interval)
+     * @param trackIDEs the container to be filled (its content is replaced)
+     * @param ides a work area for the accumulation (its content is replaced)
+     * @return a reference to `trackIDEs`
+     * @see TrackIDEs(TDC_t, TDC_t) const
+     *
+     * The content is the same as the one returned by
+     * `TrackIDEs(TDC_t, TDC_t) const`. When the same containers are reused
+     * for many calls no new memory is allocated.
+     */
+    std::vector<sim::TrackIDE> const& TrackIDEs(
+      TDC_t startTDC, TDC_t endTDC,
+      std::vector<sim::TrackIDE>& trackIDEs, std::vector<sim::IDE>& ides
+      ) const;
+
     /// Comparison: sorts by channel ID
     bool operator<  (const SimChannel& other)     const;
 
@@ -306,6 +369,9 @@ namespace sim {
 
 
   private:
+    friend class SimChannelBuilder; // adds many deposits at once
+    friend class CompactSimChannel; // restores the full channel
+
     /// Comparison functor, sorts by increasing TDCtick value
     struct CompareByTDC;
 
@@ -320,6 +386,36 @@ namespace sim {
 
   };
 
+
+  /**
+   * @brief Fills a channel × tick matrix with the ionization electrons
+   * @param channels the simulated channels
+   * @param charges buffer to be filled, with `channels.size() * nTicks` elements
+   * @param nTicks number of TDC ticks for each channel
+   * @param startTDC TDC tick of the first column of the matrix
+   * @see SimChannel::FillCharges()
+   *
+   * The matrix is stored by row: the charge of `channels[i]` at TDC tick
+   * `startTDC + t` is in `charges[i * nTicks + t]`.
+   */
+  void FillChargeMatrix(
+    std::vector<sim::SimChannel> const& channels,
+    double* charges, std::size_t nTicks, SimChannel::TDC_t startTDC = 0
+    );
+
+  /**
+   * @brief Fills a channel × tick matrix with the energy [MeV]
+   * @param channels the simulated channels
+   * @param energies buffer to be filled, with `channels.size() * nTicks` elements
+   * @param nTicks number of TDC ticks for each channel
+   * @param startTDC TDC tick of the first column of the matrix
+   * @see FillChargeMatrix(), SimChannel::FillEnergies()
+   */
+  void FillEnergyMatrix(
+    std::vector<sim::SimChannel> const& channels,
+    double* energies, std::size_t nTicks, SimChannel::TDC_t startTDC = 0
+    );
+
 } // namespace sim
 
 
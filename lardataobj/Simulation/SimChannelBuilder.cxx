@@ -0,0 +1,160 @@
+///
+/// \file  Simulation/SimChannelBuilder.cxx
+///
+/// \brief Helper to fill a `sim::SimChannel` with many energy deposits.
+///
+////////////////////////////////////////////////////////////////////////
+
+#include <limits> // std::numeric_limits
+#include <utility> // std::move()
+#include <algorithm> // std::sort(), std::find_if()
+#include <tuple> // std::tie()
+
+#include "lardataobj/Simulation/SimChannelBuilder.h"
+
+#include "messagefacility/MessageLogger/MessageLogger.h"
+
+namespace sim{
+
+  //-------------------------------------------------
+  SimChannelBuilder::SimChannelBuilder(raw::ChannelID_t channel)
+    : fChannel(channel)
+  {}
+
+  //-------------------------------------------------
+  SimChannelBuilder::SimChannelBuilder(SimChannel channel)
+    : fChannel(std::move(channel))
+  {}
+
+  //-------------------------------------------------
+  void SimChannelBuilder::AddIonizationElectrons(TrackID_t     trackID,
+                                                 TDC_t         tdc,
+                                                 double        numberElectrons,
+                                                 double const* xyz,
+                                                 double        energy)
+  {
+    // no electrons? no energy? no good!
+    if ((numberElectrons < std::numeric_limits<double>::epsilon())
+      || (energy <= std::numeric_limits<double>::epsilon()))
+    {
+      MF_LOG_ERROR("SimChannelBuilder")
+      << "AddIonizationElectrons() trying to add to TDC #"
+      << tdc
+      << " "
+      << numberElectrons
+      << " electrons with "
+      << energy
+      << " MeV of energy from track ID="
+      << trackID;
+      return;
+    } // if no energy or no electrons
+
+    fDeposits.push_back({
+      fDeposits.size(), trackID, static_cast<SimChannel::StoredTDC_t>(tdc),
+      numberElectrons, energy, xyz[0], xyz[1], xyz[2]
+      });
+
+  } // SimChannelBuilder::AddIonizationElectrons()
+
+
+  //-------------------------------------------------
+  SimChannel SimChannelBuilder::Build()
+  {
+    // sort by TDC, then by track, then in the order the deposits were added
+    std::sort(fDeposits.begin(), fDeposits.end(),
+      [](Deposit_t const& a, Deposit_t const& b)
+        {
+          return std::tie(a.tdc, a.trackID, a.order)
+            < std::tie(b.tdc, b.trackID, b.order);
+        }
+      );
+
+    SimChannel::TDCIDEs_t& oldTDCIDEs = fChannel.fTDCIDEs;
+
+    std::size_t nNewTDCs = 0;
+    for (std::size_t i = 0; i < fDeposits.size(); ++i)
+      if ((i == 0) || (fDeposits[i].tdc != fDeposits[i - 1].tdc)) ++nNewTDCs;
+
+    // merge the old TDC list and the new deposits, both sorted by TDC
+    SimChannel::TDCIDEs_t TDCIDEs;
+    TDCIDEs.reserve(oldTDCIDEs.size() + nNewTDCs);
+    auto iOld = oldTDCIDEs.begin();
+    auto const oldEnd = oldTDCIDEs.end();
+    auto iDeposit = fDeposits.cbegin();
+    auto const depEnd = fDeposits.cend();
+    while (iDeposit != depEnd) {
+      auto const tdc = iDeposit->tdc;
+      auto iNext = iDeposit;
+      while ((iNext != depEnd) && (iNext->tdc == tdc)) ++iNext;
+
+      while ((iOld != oldEnd) && (iOld->first < tdc))
+        TDCIDEs.push_back(std::move(*iOld++));
+      if ((iOld != oldEnd) && (iOld->first == tdc))
+        TDCIDEs.push_back(std::move(*iOld++));
+      else
+        TDCIDEs.emplace_back(tdc, std::vector<sim::IDE>());
+
+      MergeDeposits(TDCIDEs.back().second, iDeposit, iNext);
+      iDeposit = iNext;
+    } // while
+    while (iOld != oldEnd) TDCIDEs.push_back(std::move(*iOld++));
+
+    oldTDCIDEs = std::move(TDCIDEs);
+    fDeposits.clear();
+
+    SimChannel channel { std::move(fChannel) };
+    fChannel = SimChannel(channel.Channel());
+    return channel;
+  } // SimChannelBuilder::Build()
+
+
+  //-------------------------------------------------
+  void SimChannelBuilder::MergeDeposits(
+    std::vector<sim::IDE>& ides,
+    std::vector<Deposit_t>::const_iterator begin,
+    std::vector<Deposit_t>::const_iterator end
+  ) {
+    // deposits are sorted by track, and for each track in insertion order;
+    // the result must match the one of adding the deposits one by one
+    // with `SimChannel::AddIonizationElectrons()`
+    auto const nOldIDEs = ides.size();
+
+    std::vector<std::pair<std::size_t, sim::IDE>> newIDEs;
+    while (begin != end) {
+      TrackID_t const trackID = begin->trackID;
+
+      // the first IDE of this track already in the channel, if any
+      auto const oldEnd = ides.begin() + nOldIDEs;
+      auto iIDE = std::find_if(ides.begin(), oldEnd,
+        [trackID](sim::IDE const& ide){ return ide.trackID == trackID; });
+      sim::IDE* ide = nullptr;
+      if (iIDE != oldEnd) ide = &*iIDE;
+      else {
+        newIDEs.emplace_back(begin->order, sim::IDE(trackID,
+          begin->numElectrons, begin->energy, begin->x, begin->y, begin->z));
+        ide = &(newIDEs.back().second);
+        ++begin;
+      }
+
+      for (; (begin != end) && (begin->trackID == trackID); ++begin) {
+        // make a weighted average for the location information
+        double weight     = ide->numElectrons + begin->numElectrons;
+        ide->x            = (ide->x * ide->numElectrons + begin->x*begin->numElectrons)/weight;
+        ide->y            = (ide->y * ide->numElectrons + begin->y*begin->numElectrons)/weight;
+        ide->z            = (ide->z * ide->numElectrons + begin->z*begin->numElectrons)/weight;
+        ide->numElectrons = weight;
+        ide->energy       = ide->energy + begin->energy;
+      } // for deposits of this track
+    } // while
+
+    // new tracks are added in the order of their first deposit
+    std::sort(newIDEs.begin(), newIDEs.end(),
+      [](auto const& a, auto const& b){ return a.first < b.first; });
+    ides.reserve(ides.size() + newIDEs.size());
+    for (auto& newIDE: newIDEs) ides.push_back(std::move(newIDE.second));
+
+  } // SimChannelBuilder::MergeDeposits()
+
+
+}
+////////////////////////////////////////////////////////////////////////
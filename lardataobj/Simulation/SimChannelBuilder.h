@@ -0,0 +1,130 @@
+/**
+ * @file   lardataobj/Simulation/SimChannelBuilder.h
+ * @brief  Helper to fill a `sim::SimChannel` with many energy deposits.
+ * @see    lardataobj/Simulation/SimChannelBuilder.cxx
+ */
+
+#ifndef LARDATAOBJ_SIMULATION_SIMCHANNELBUILDER_H
+#define LARDATAOBJ_SIMULATION_SIMCHANNELBUILDER_H
+
+// LArSoftObj libraries
+#include "lardataobj/Simulation/SimChannel.h"
+#include "larcoreobj/SimpleTypesAndConstants/RawTypes.h" // raw::ChannelID_t
+
+// C/C++ standard libraries
+#include <vector>
+#include <cstddef> // std::size_t
+
+
+namespace sim {
+
+  /**
+   * @brief Collects energy deposits and adds them to a `sim::SimChannel` at once.
+   *
+   * `sim::SimChannel::AddIonizationElectrons()` keeps the channel content
+   * sorted at every call: a deposit on a new TDC tick is inserted in the middle
+   * of the list of ticks, and a deposit on an existing tick looks for its track
+   * through all the deposits of that tick. With many deposits this becomes
+   * expensive.
+   *
+   * This builder has the same `AddIonizationElectrons()` interface, but it
+   * only appends the deposits to a buffer. When `Build()` is called, the
+   * buffer is sorted by TDC tick and track, and all deposits are merged into
+   * the channel in a single pass.
+   *
+   * The result is the same as adding each deposit with
+   * `sim::SimChannel::AddIonizationElectrons()` in the same order: in each TDC
+   * tick, deposits from tracks already present are merged into the existing
+   * `sim::IDE` (with the same weighted average of the position), and the new
+   * tracks are appended in the order of their first deposit.
+   *
+   * Example:
+   * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.cpp}
+   * sim::SimChannelBuilder builder { channel };
+   * for (auto const& step: steps) {
+   *   builder.AddIonizationElectrons
+   *     (step.trackID, step.tdc, step.electrons, step.xyz, step.energy);
+   * }
+   * sim::SimChannel simChannel = builder.Build();
+   * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+   */
+  class SimChannelBuilder {
+  public:
+    using TDC_t = SimChannel::TDC_t;
+    using TrackID_t = SimChannel::TrackID_t;
+
+    /// A single energy deposit waiting to be added to the channel.
+    struct Deposit_t {
+      std::size_t order;           ///< Position of the deposit in the buffer.
+      TrackID_t trackID;           ///< Geant4 supplied track ID.
+      SimChannel::StoredTDC_t tdc; ///< TDC tick.
+      double numElectrons;         ///< Electrons at the readout.
+      double energy;               ///< Deposited energy [MeV].
+      double x;                    ///< x position of ionization [cm].
+      double y;                    ///< y position of ionization [cm].
+      double z;                    ///< z position of ionization [cm].
+    }; // Deposit_t
+
+
+    /// Constructor: builds a channel with no deposits.
+    explicit SimChannelBuilder(raw::ChannelID_t channel);
+
+    /// Constructor: new deposits will be added to the content of `channel`.
+    explicit SimChannelBuilder(SimChannel channel);
+
+    /**
+     * @brief Queues ionization electrons and energy for this channel.
+     * @param trackID ID of simulated track depositing this energy (from Geant4)
+     * @param tdc TDC tick when this deposit was collected
+     * @param numberElectrons electrons created at this point by this track
+     * @param xyz coordinates of original location of ionization (3D array) [cm]
+     * @param energy energy deposited at this point by this track [MeV]
+     * @see sim::SimChannel::AddIonizationElectrons()
+     *
+     * Deposits with no electrons or no energy are rejected with an error
+     * message, as in `sim::SimChannel::AddIonizationElectrons()`.
+     */
+    void AddIonizationElectrons(TrackID_t trackID,
+                                TDC_t tdc,
+                                double numberElectrons,
+                                double const* xyz,
+                                double energy);
+
+    /// Prepares the buffer for `n` deposits in total.
+    void Reserve(std::size_t n) { fDeposits.reserve(n); }
+
+    /// Returns the number of deposits waiting to be added.
+    std::size_t NDeposits() const { return fDeposits.size(); }
+
+    /// Returns the readout channel being built.
+    raw::ChannelID_t Channel() const { return fChannel.Channel(); }
+
+    /**
+     * @brief Adds all the queued deposits to the channel and returns it.
+     * @return the channel with all the deposits
+     *
+     * After this call the builder is left with an empty channel with the same
+     * channel ID, and no queued deposits.
+     */
+    SimChannel Build();
+
+
+  private:
+    SimChannel fChannel; ///< The channel being built.
+    std::vector<Deposit_t> fDeposits; ///< Deposits not yet in the channel.
+
+    /// Adds to `ides` all the deposits in `[ begin, end [` (all on one tick).
+    static void MergeDeposits(
+      std::vector<sim::IDE>& ides,
+      std::vector<Deposit_t>::const_iterator begin,
+      std::vector<Deposit_t>::const_iterator end
+      );
+
+  }; // class SimChannelBuilder
+
+} // namespace sim
+
+
+#endif // LARDATAOBJ_SIMULATION_SIMCHANNELBUILDER_H
+
+////////////////////////////////////////////////////////////////////////
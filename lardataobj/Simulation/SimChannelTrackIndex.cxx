@@ -0,0 +1,217 @@
+///
+/// \file  Simulation/SimChannelTrackIndex.cxx
+///
+/// \brief Index of the energy deposits in `sim::SimChannel` by track ID.
+///
+////////////////////////////////////////////////////////////////////////
+
+#include <algorithm> // std::stable_sort(), std::make_heap(), ...
+#include <utility> // std::move()
+#include <stdexcept> // std::runtime_error
+#include <string> // std::to_string()
+#include <tuple> // std::tie()
+
+#include "lardataobj/Simulation/SimChannelTrackIndex.h"
+
+namespace sim{
+
+  //-------------------------------------------------
+  SimChannelTrackIndex::SimChannelTrackIndex
+    (std::vector<sim::SimChannel> const& channels)
+    : SimChannelTrackIndex
+      (channels, { IndexChannels(channels, 0, channels.size()) })
+  {}
+
+
+  //-------------------------------------------------
+  SimChannelTrackIndex::SimChannelTrackIndex(
+    std::vector<sim::SimChannel> const& channels,
+    std::vector<Partial_t> partials
+  )
+    : fChannels(&channels)
+  {
+    using Entry_t = std::pair<TrackID_t, IDERef_t>;
+
+    std::size_t nEntries = 0;
+    std::size_t expectedBegin = 0;
+    for (Partial_t const& partial: partials) {
+      if (partial.begin != expectedBegin) {
+        throw std::runtime_error("SimChannelTrackIndex: partial index starts at"
+          " channel #" + std::to_string(partial.begin) + ", expected #"
+          + std::to_string(expectedBegin));
+      }
+      expectedBegin = partial.end;
+      nEntries += partial.entries.size();
+    } // for
+    if (expectedBegin != channels.size()) {
+      throw std::runtime_error("SimChannelTrackIndex: partial indices cover "
+        + std::to_string(expectedBegin) + " of "
+        + std::to_string(channels.size()) + " channels");
+    }
+
+    // join the partial indices with a single k-way merge; for the same track,
+    // the earlier block comes first, so that the deposits of each track stay
+    // sorted by channel position
+    struct Cursor_t {
+      TrackID_t trackID;    ///< Track of the next entry of the block.
+      std::size_t iPartial; ///< Position of the block.
+      std::size_t next;     ///< Position of the next entry in the block.
+    };
+    auto const after = [](Cursor_t const& a, Cursor_t const& b)
+      { return std::tie(a.trackID, a.iPartial) > std::tie(b.trackID, b.iPartial); };
+    std::vector<Cursor_t> heap;
+    heap.reserve(partials.size());
+    for (std::size_t iPartial = 0; iPartial < partials.size(); ++iPartial) {
+      auto const& partialEntries = partials[iPartial].entries;
+      if (!partialEntries.empty())
+        heap.push_back({ partialEntries.front().first, iPartial, 0 });
+    }
+    std::make_heap(heap.begin(), heap.end(), after);
+
+    std::vector<Entry_t> entries;
+    entries.reserve(nEntries);
+    while (!heap.empty()) {
+      std::pop_heap(heap.begin(), heap.end(), after);
+      Cursor_t& cursor = heap.back();
+      auto& partialEntries = partials[cursor.iPartial].entries;
+      // move all the entries of this track in the block at once
+      std::size_t next = cursor.next;
+      while ((next < partialEntries.size())
+        && (partialEntries[next].first == cursor.trackID))
+      {
+        entries.push_back(std::move(partialEntries[next++]));
+      }
+      if (next < partialEntries.size()) {
+        cursor.trackID = partialEntries[next].first;
+        cursor.next = next;
+        std::push_heap(heap.begin(), heap.end(), after);
+      }
+      else heap.pop_back();
+    } // while
+
+    // fill the compressed rows
+    fRefs.reserve(entries.size());
+    for (Entry_t const& entry: entries) {
+      if (fTrackIDs.empty() || (fTrackIDs.back() != entry.first)) {
+        fTrackIDs.push_back(entry.first);
+        fOffsets.push_back(fRefs.size());
+      }
+      fRefs.push_back(entry.second);
+    } // for
+    fOffsets.push_back(fRefs.size());
+
+  } // SimChannelTrackIndex::SimChannelTrackIndex()
+
+
+  //-------------------------------------------------
+  auto SimChannelTrackIndex::IndexChannels
+    (std::vector<sim::SimChannel> const& channels, std::size_t begin, std::size_t end)
+    -> Partial_t
+  {
+    Partial_t partial;
+    partial.begin = begin;
+    partial.end = end;
+
+    std::size_t nIDEs = 0;
+    for (std::size_t iChannel = begin; iChannel < end; ++iChannel) {
+      for (auto const& TDCinfo: channels[iChannel].TDCIDEMap())
+        nIDEs += TDCinfo.second.size();
+    }
+    partial.entries.reserve(nIDEs);
+
+    for (std::size_t iChannel = begin; iChannel < end; ++iChannel) {
+      auto const& TDCIDEs = channels[iChannel].TDCIDEMap();
+      for (std::size_t iTDC = 0; iTDC < TDCIDEs.size(); ++iTDC) {
+        auto const& ides = TDCIDEs[iTDC].second;
+        for (std::size_t iIDE = 0; iIDE < ides.size(); ++iIDE) {
+          partial.entries.push_back({ ides[iIDE].trackID, {
+            static_cast<unsigned int>(iChannel),
+            static_cast<unsigned int>(iTDC),
+            static_cast<unsigned int>(iIDE)
+          } });
+        } // for IDEs
+      } // for TDCs
+    } // for channels
+
+    std::stable_sort(partial.entries.begin(), partial.entries.end(),
+      [](auto const& a, auto const& b){ return a.first < b.first; });
+
+    return partial;
+  } // SimChannelTrackIndex::IndexChannels()
+
+
+  //-------------------------------------------------
+  bool SimChannelTrackIndex::HasTrack(TrackID_t trackID) const
+  {
+    return std::binary_search(fTrackIDs.begin(), fTrackIDs.end(), trackID);
+  }
+
+
+  //-------------------------------------------------
+  auto SimChannelTrackIndex::IDEs(TrackID_t trackID) const -> IDERefs_t
+  {
+    auto const itTrack
+      = std::lower_bound(fTrackIDs.begin(), fTrackIDs.end(), trackID);
+    if ((itTrack == fTrackIDs.end()) || (*itTrack != trackID))
+      return { nullptr, nullptr };
+    std::size_t const iTrack = itTrack - fTrackIDs.begin();
+    return
+      { fRefs.data() + fOffsets[iTrack], fRefs.data() + fOffsets[iTrack + 1] };
+  } // SimChannelTrackIndex::IDEs()
+
+
+  //-------------------------------------------------
+  std::vector<std::pair<raw::ChannelID_t, double>>
+  SimChannelTrackIndex::ChargeByChannel(TrackID_t trackID) const
+  {
+    std::vector<std::pair<raw::ChannelID_t, double>> charges;
+
+    // references are sorted by channel position
+    unsigned int lastChannel = 0;
+    for (IDERef_t const& ref: IDEs(trackID)) {
+      if (charges.empty() || (ref.channel != lastChannel)) {
+        charges.emplace_back(GetChannel(ref).Channel(), 0.);
+        lastChannel = ref.channel;
+      }
+      charges.back().second += GetIDE(ref).numElectrons;
+    } // for
+
+    // the collection is usually sorted by channel ID, but it is not required
+    auto const byChannel = [](auto const& a, auto const& b)
+      { return a.first < b.first; };
+    auto const notAfter = [](auto const& a, auto const& b)
+      { return a.first >= b.first; };
+    if (std::adjacent_find(charges.begin(), charges.end(), notAfter)
+      != charges.end())
+    {
+      std::stable_sort(charges.begin(), charges.end(), byChannel);
+      std::vector<std::pair<raw::ChannelID_t, double>> merged;
+      for (auto const& charge: charges) {
+        if (!merged.empty() && (merged.back().first == charge.first))
+          merged.back().second += charge.second;
+        else
+          merged.push_back(charge);
+      } // for
+      charges = std::move(merged);
+    }
+
+    return charges;
+  } // SimChannelTrackIndex::ChargeByChannel()
+
+
+  //-------------------------------------------------
+  std::vector<std::pair<raw::ChannelID_t, SimChannelTrackIndex::TDC_t>>
+  SimChannelTrackIndex::TicksTouched(TrackID_t trackID) const
+  {
+    std::vector<std::pair<raw::ChannelID_t, TDC_t>> ticks;
+    for (IDERef_t const& ref: IDEs(trackID))
+      ticks.emplace_back(GetChannel(ref).Channel(), GetTDC(ref));
+
+    std::sort(ticks.begin(), ticks.end());
+    ticks.erase(std::unique(ticks.begin(), ticks.end()), ticks.end());
+    return ticks;
+  } // SimChannelTrackIndex::TicksTouched()
+
+
+}
+////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,192 @@
+/**
+ * @file   lardataobj/Simulation/SimChannelTrackIndex.h
+ * @brief  Index of the energy deposits in `sim::SimChannel` by track ID.
+ * @see    lardataobj/Simulation/SimChannelTrackIndex.cxx
+ */
+
+#ifndef LARDATAOBJ_SIMULATION_SIMCHANNELTRACKINDEX_H
+#define LARDATAOBJ_SIMULATION_SIMCHANNELTRACKINDEX_H
+
+// LArSoftObj libraries
+#include "lardataobj/Simulation/SimChannel.h"
+#include "larcoreobj/SimpleTypesAndConstants/RawTypes.h" // raw::ChannelID_t
+#include "lardataobj/Utilities/IteratorRange.h"
+
+// C/C++ standard libraries
+#include <vector>
+#include <utility> // std::pair
+#include <cstddef> // std::size_t
+
+
+namespace sim {
+
+  /**
+   * @brief Index of the energy deposits of a `sim::SimChannel` collection by track.
+   *
+   * The index is built from a `std::vector<sim::SimChannel>`, and for each
+   * Geant4 track ID it lists all the energy deposits (`sim::IDE`) of that
+   * track, as references to their position in the collection.
+   * The lists are stored in a single array (compressed sparse row format):
+   * the deposits of a track are contiguous, sorted by channel position, TDC
+   * and deposit position.
+   *
+   * The index does not own the channels: the collection must outlive the
+   * index and must not be changed after the index is built.
+   *
+   * Example:
+   * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.cpp}
+   * sim::SimChannelTrackIndex const index { simChannels };
+   * for (auto const& [ channel, charge ]: index.ChargeByChannel(trackID)) {
+   *   // ...
+   * }
+   * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+   *
+   * Building in parallel
+   * ---------------------
+   *
+   * The scan of the channels can be split in blocks of channels, which may be
+   * processed concurrently (e.g. with TBB) by `IndexChannels()`. The partial
+   * indices are then joined by the constructor:
+   * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.cpp}
+   * std::size_t const blockSize = 256;
+   * std::size_t const nBlocks = (simChannels.size() + blockSize - 1) / blockSize;
+   * std::vector<sim::SimChannelTrackIndex::Partial_t> partials(nBlocks);
+   * tbb::parallel_for(std::size_t(0), nBlocks, [&](std::size_t iBlock){
+   *   std::size_t const begin = iBlock * blockSize;
+   *   std::size_t const end = std::min(begin + blockSize, simChannels.size());
+   *   partials[iBlock]
+   *     = sim::SimChannelTrackIndex::IndexChannels(simChannels, begin, end);
+   * });
+   * sim::SimChannelTrackIndex const index { simChannels, std::move(partials) };
+   * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+   */
+  class SimChannelTrackIndex {
+  public:
+    using TrackID_t = SimChannel::TrackID_t;
+    using TDC_t = SimChannel::TDC_t;
+
+    /// Reference to an energy deposit: positions of channel, TDC and IDE.
+    struct IDERef_t {
+      unsigned int channel; ///< Position of the channel in the collection.
+      unsigned int tdc;     ///< Position of the TDC entry in the channel.
+      unsigned int ide;     ///< Position of the IDE in the TDC entry.
+    }; // IDERef_t
+
+    /// Sequence of references to the deposits of a track.
+    using IDERefs_t = util::IteratorRange<IDERef_t const*>;
+
+    /// Index of a block of channels, to be joined into a full index.
+    struct Partial_t {
+      std::size_t begin = 0; ///< Position of the first indexed channel.
+      std::size_t end = 0;   ///< Position after the last indexed channel.
+      /// Track ID and deposit, sorted by track ID.
+      std::vector<std::pair<TrackID_t, IDERef_t>> entries;
+    }; // Partial_t
+
+
+    /// Constructor: indexes all the deposits in `channels`.
+    explicit SimChannelTrackIndex(std::vector<sim::SimChannel> const& channels);
+
+    /**
+     * @brief Constructor: joins the indices of blocks of channels.
+     * @param channels the full collection of channels
+     * @param partials indices of the blocks of channels, in order
+     * @throw std::runtime_error if `partials` do not cover all `channels`
+     * @see IndexChannels()
+     *
+     * The blocks must be sorted and contiguous, and must cover the whole
+     * collection.
+     */
+    SimChannelTrackIndex(
+      std::vector<sim::SimChannel> const& channels,
+      std::vector<Partial_t> partials
+      );
+
+    /**
+     * @brief Indexes a block of channels.
+     * @param channels the full collection of channels
+     * @param begin position of the first channel to be indexed
+     * @param end position after the last channel to be indexed
+     * @return the index of the channels in the block
+     *
+     * This function does not change any state, and it can be called
+     * concurrently for different blocks.
+     */
+    static Partial_t IndexChannels
+      (std::vector<sim::SimChannel> const& channels, std::size_t begin, std::size_t end);
+
+
+    // --- BEGIN -- Queries --------------------------------------------------
+    ///@name Queries
+    ///@{
+
+    /// Returns the number of indexed tracks.
+    std::size_t NTracks() const { return fTrackIDs.size(); }
+
+    /// Returns the IDs of all the tracks with deposits, sorted.
+    std::vector<TrackID_t> const& TrackIDs() const { return fTrackIDs; }
+
+    /// Returns whether the track has any deposit in the channels.
+    bool HasTrack(TrackID_t trackID) const;
+
+    /// Returns all the deposits of the track (empty if track is not present).
+    IDERefs_t IDEs(TrackID_t trackID) const;
+
+    /**
+     * @brief Returns the charge deposited by a track on each channel.
+     * @param trackID ID of the track
+     * @return pairs (channel, number of electrons), sorted by channel
+     */
+    std::vector<std::pair<raw::ChannelID_t, double>> ChargeByChannel
+      (TrackID_t trackID) const;
+
+    /**
+     * @brief Returns the TDC ticks where the track deposited charge.
+     * @param trackID ID of the track
+     * @return pairs (channel, TDC), sorted and without duplicates
+     */
+    std::vector<std::pair<raw::ChannelID_t, TDC_t>> TicksTouched
+      (TrackID_t trackID) const;
+
+    ///@}
+    // --- END -- Queries ----------------------------------------------------
+
+
+    // --- BEGIN -- Accessors ------------------------------------------------
+    ///@name Accessors
+    ///@{
+
+    /// Returns the channel of the referenced deposit.
+    sim::SimChannel const& GetChannel(IDERef_t const& ref) const
+      { return (*fChannels)[ref.channel]; }
+
+    /// Returns the TDC tick of the referenced deposit.
+    TDC_t GetTDC(IDERef_t const& ref) const
+      { return GetChannel(ref).TDCIDEMap()[ref.tdc].first; }
+
+    /// Returns the referenced deposit.
+    sim::IDE const& GetIDE(IDERef_t const& ref) const
+      { return GetChannel(ref).TDCIDEMap()[ref.tdc].second[ref.ide]; }
+
+    ///@}
+    // --- END -- Accessors --------------------------------------------------
+
+
+  private:
+    std::vector<sim::SimChannel> const* fChannels; ///< Indexed channels.
+
+    std::vector<TrackID_t> fTrackIDs; ///< Sorted IDs of the tracks.
+
+    /// Deposits of track `fTrackIDs[i]` start at `fRefs[fOffsets[i]]`.
+    std::vector<std::size_t> fOffsets;
+
+    std::vector<IDERef_t> fRefs; ///< All deposits, grouped by track.
+
+  }; // class SimChannelTrackIndex
+
+} // namespace sim
+
+
+#endif // LARDATAOBJ_SIMULATION_SIMCHANNELTRACKINDEX_H
+
+////////////////////////////////////////////////////////////////////////
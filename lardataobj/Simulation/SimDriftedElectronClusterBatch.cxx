@@ -0,0 +1,172 @@
+///
+/// \file  Simulation/SimDriftedElectronClusterBatch.cxx
+///
+/// \brief Many clusters of drifted electrons, as one array per quantity.
+///
+////////////////////////////////////////////////////////////////////////
+
+#include <algorithm> // std::copy()
+#include <cmath> // std::sqrt(), std::exp(), std::lround()
+
+#include "lardataobj/Simulation/SimDriftedElectronClusterBatch.h"
+
+namespace sim{
+
+  //-------------------------------------------------
+  SimDriftedElectronClusterBatch::SimDriftedElectronClusterBatch
+    (std::vector<sim::SimDriftedElectronCluster> const& clusters)
+  {
+    Reserve(clusters.size());
+    for (sim::SimDriftedElectronCluster const& cluster: clusters) Add(cluster);
+  }
+
+  //-------------------------------------------------
+  void SimDriftedElectronClusterBatch::Reserve(size_type n)
+  {
+    fNumElectrons.reserve(n);
+    fTime.reserve(n);
+    fInitialX.reserve(n);
+    fInitialY.reserve(n);
+    fInitialZ.reserve(n);
+    fFinalX.reserve(n);
+    fFinalY.reserve(n);
+    fFinalZ.reserve(n);
+    fWidthX.reserve(n);
+    fWidthY.reserve(n);
+    fWidthZ.reserve(n);
+    fEnergy.reserve(n);
+    fTrackID.reserve(n);
+  } // SimDriftedElectronClusterBatch::Reserve()
+
+  //-------------------------------------------------
+  void SimDriftedElectronClusterBatch::Resize(size_type n)
+  {
+    fNumElectrons.resize(n, 0);
+    fTime.resize(n, 0.0);
+    fInitialX.resize(n, 0.f);
+    fInitialY.resize(n, 0.f);
+    fInitialZ.resize(n, 0.f);
+    fFinalX.resize(n, 0.f);
+    fFinalY.resize(n, 0.f);
+    fFinalZ.resize(n, 0.f);
+    fWidthX.resize(n, 0.f);
+    fWidthY.resize(n, 0.f);
+    fWidthZ.resize(n, 0.f);
+    fEnergy.resize(n, 0.f);
+    fTrackID.resize(n, 0);
+  } // SimDriftedElectronClusterBatch::Resize()
+
+  //-------------------------------------------------
+  void SimDriftedElectronClusterBatch::Add
+    (sim::SimDriftedElectronCluster const& cluster)
+  {
+    geo::Point_t const initialPos = cluster.InitialPosition();
+    geo::Point_t const finalPos = cluster.FinalPosition();
+    geo::Vector_t const width = cluster.ClusterWidth();
+    fNumElectrons.push_back(cluster.NumberOfElectrons());
+    fTime.push_back(cluster.Time());
+    fInitialX.push_back(initialPos.X());
+    fInitialY.push_back(initialPos.Y());
+    fInitialZ.push_back(initialPos.Z());
+    fFinalX.push_back(finalPos.X());
+    fFinalY.push_back(finalPos.Y());
+    fFinalZ.push_back(finalPos.Z());
+    fWidthX.push_back(width.X());
+    fWidthY.push_back(width.Y());
+    fWidthZ.push_back(width.Z());
+    fEnergy.push_back(cluster.Energy());
+    fTrackID.push_back(cluster.TrackID());
+  } // SimDriftedElectronClusterBatch::Add()
+
+  //-------------------------------------------------
+  sim::SimDriftedElectronCluster SimDriftedElectronClusterBatch::Cluster
+    (size_type i) const
+  {
+    return {
+      fNumElectrons[i], fTime[i],
+      { fInitialX[i], fInitialY[i], fInitialZ[i] },
+      { fFinalX[i], fFinalY[i], fFinalZ[i] },
+      { fWidthX[i], fWidthY[i], fWidthZ[i] },
+      fEnergy[i], fTrackID[i]
+      };
+  } // SimDriftedElectronClusterBatch::Cluster()
+
+  //-------------------------------------------------
+  std::vector<sim::SimDriftedElectronCluster>
+  SimDriftedElectronClusterBatch::MakeClusters() const
+  {
+    std::vector<sim::SimDriftedElectronCluster> clusters;
+    clusters.reserve(size());
+    for (size_type i = 0; i < size(); ++i) clusters.push_back(Cluster(i));
+    return clusters;
+  } // SimDriftedElectronClusterBatch::MakeClusters()
+
+
+  //-------------------------------------------------
+  SimDriftedElectronClusterBatch SimDriftedElectronClusterBatch::DriftDeposits(
+    sim::ColumnarSimEnergyDeposits const& deposits,
+    DriftParameters_t const& params
+  ) {
+    SimDriftedElectronClusterBatch batch;
+    size_type const n = deposits.size();
+    batch.Resize(n);
+
+    float const* x = deposits.X().data();
+    double const* t = deposits.T().data();
+    double const anodeX = params.anodeX;
+    double const direction = (params.driftDirection < 0)? -1.0: +1.0;
+    double const velocity = params.driftVelocity;
+
+    // drift time, temporarily stored as the time of the clusters;
+    // deposits behind the anode don't drift
+    double* time = batch.fTime.data();
+    for (size_type i = 0; i < n; ++i) {
+      double const distance = direction * (anodeX - x[i]);
+      time[i] = (distance > 0.0)? distance / velocity: 0.0;
+    }
+
+    // electrons, with attenuation from the finite lifetime
+    int const* electrons = deposits.NumElectrons().data();
+    int* driftedElectrons = batch.fNumElectrons.data();
+    if (params.lifetime > 0.0) {
+      double const invLifetime = 1.0 / params.lifetime;
+      for (size_type i = 0; i < n; ++i) {
+        driftedElectrons[i] = static_cast<int>
+          (std::lround(electrons[i] * std::exp(-time[i] * invLifetime)));
+      }
+    }
+    else std::copy(electrons, electrons + n, driftedElectrons);
+
+    // no electron reaches the anode from behind it
+    for (size_type i = 0; i < n; ++i)
+      if (direction * (anodeX - x[i]) < 0.0) driftedElectrons[i] = 0;
+
+    // diffusion: width is sqrt(2 D t)
+    double const twoDL = 2.0 * params.longDiffusion;
+    double const twoDT = 2.0 * params.transDiffusion;
+    float* widthX = batch.fWidthX.data();
+    for (size_type i = 0; i < n; ++i) widthX[i] = std::sqrt(twoDL * time[i]);
+    float* widthY = batch.fWidthY.data();
+    for (size_type i = 0; i < n; ++i) widthY[i] = std::sqrt(twoDT * time[i]);
+    batch.fWidthZ = batch.fWidthY;
+
+    // arrival time
+    for (size_type i = 0; i < n; ++i) time[i] += t[i];
+
+    // positions
+    batch.fInitialX = deposits.X();
+    batch.fInitialY = deposits.Y();
+    batch.fInitialZ = deposits.Z();
+    batch.fFinalX.assign(n, static_cast<float>(anodeX));
+    batch.fFinalY = deposits.Y();
+    batch.fFinalZ = deposits.Z();
+
+    batch.fEnergy = deposits.Energy();
+    batch.fTrackID = deposits.TrackID();
+
+    return batch;
+  } // SimDriftedElectronClusterBatch::DriftDeposits()
+
+
+}
+////////////////////////////////////////////////////////////////////////
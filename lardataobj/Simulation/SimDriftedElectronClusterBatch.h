@@ -0,0 +1,175 @@
+/**
+ * @file   lardataobj/Simulation/SimDriftedElectronClusterBatch.h
+ * @brief  Many clusters of drifted electrons, as one array per quantity.
+ * @see    lardataobj/Simulation/SimDriftedElectronClusterBatch.cxx
+ */
+
+#ifndef LARDATAOBJ_SIMULATION_SIMDRIFTEDELECTRONCLUSTERBATCH_H
+#define LARDATAOBJ_SIMULATION_SIMDRIFTEDELECTRONCLUSTERBATCH_H
+
+// LArSoftObj libraries
+#include "lardataobj/Simulation/SimDriftedElectronCluster.h"
+#include "lardataobj/Simulation/ColumnarSimEnergyDeposits.h"
+
+// C/C++ standard libraries
+#include <vector>
+#include <cstddef> // std::size_t
+
+
+namespace sim {
+
+  /**
+   * @brief Clusters of drifted electrons, stored as one array per quantity.
+   * @see   `sim::SimDriftedElectronCluster`
+   *
+   * This container holds the same information as a collection of
+   * `sim::SimDriftedElectronCluster`, with each quantity (and each coordinate)
+   * in its own array. Positions and widths are stored in single precision.
+   *
+   * The readout simulation can loop on the arrays directly; single clusters
+   * are created only on demand (`Cluster()`, `MakeClusters()`).
+   *
+   * `DriftDeposits()` creates a batch from a batch of energy deposits.
+   */
+  class SimDriftedElectronClusterBatch {
+  public:
+    using size_type = std::size_t;
+
+    /// Constructor: an empty batch.
+    SimDriftedElectronClusterBatch() = default;
+
+    /// Constructor: copies the content of `clusters`, in the same order.
+    explicit SimDriftedElectronClusterBatch
+      (std::vector<sim::SimDriftedElectronCluster> const& clusters);
+
+
+    // --- BEGIN -- Filling --------------------------------------------------
+    ///@name Filling
+    ///@{
+
+    /// Prepares the storage for `n` clusters in total.
+    void Reserve(size_type n);
+
+    /// Sets the number of clusters; new clusters have all values `0`.
+    void Resize(size_type n);
+
+    /// Appends a cluster.
+    void Add(sim::SimDriftedElectronCluster const& cluster);
+
+    ///@}
+    // --- END -- Filling ----------------------------------------------------
+
+
+    // --- BEGIN -- Accessors ------------------------------------------------
+    ///@name Accessors
+    ///@{
+
+    /// Returns the number of clusters.
+    size_type size() const { return fNumElectrons.size(); }
+
+    /// Returns whether there are no clusters.
+    bool empty() const { return fNumElectrons.empty(); }
+
+    /// Number of electrons of each cluster.
+    std::vector<int> const& NumElectrons() const { return fNumElectrons; }
+    /// Time of each cluster (ns)
+    std::vector<double> const& Time() const { return fTime; }
+    /// Initial position of each cluster, x coordinate (cm)
+    std::vector<float> const& InitialX() const { return fInitialX; }
+    /// Initial position of each cluster, y coordinate (cm)
+    std::vector<float> const& InitialY() const { return fInitialY; }
+    /// Initial position of each cluster, z coordinate (cm)
+    std::vector<float> const& InitialZ() const { return fInitialZ; }
+    /// Final position of each cluster, x coordinate (cm)
+    std::vector<float> const& FinalX() const { return fFinalX; }
+    /// Final position of each cluster, y coordinate (cm)
+    std::vector<float> const& FinalY() const { return fFinalY; }
+    /// Final position of each cluster, z coordinate (cm)
+    std::vector<float> const& FinalZ() const { return fFinalZ; }
+    /// Width of each cluster on x direction (cm)
+    std::vector<float> const& WidthX() const { return fWidthX; }
+    /// Width of each cluster on y direction (cm)
+    std::vector<float> const& WidthY() const { return fWidthY; }
+    /// Width of each cluster on z direction (cm)
+    std::vector<float> const& WidthZ() const { return fWidthZ; }
+    /// Energy of each cluster (MeV)
+    std::vector<float> const& Energy() const { return fEnergy; }
+    /// Simulation track ID of each cluster.
+    std::vector<int> const& TrackID() const { return fTrackID; }
+
+    /// Returns the cluster number `i`.
+    sim::SimDriftedElectronCluster Cluster(size_type i) const;
+
+    /// Returns all the clusters, in order.
+    std::vector<sim::SimDriftedElectronCluster> MakeClusters() const;
+
+    ///@}
+    // --- END -- Accessors --------------------------------------------------
+
+
+    /// Parameters of the drift of the electrons (see `DriftDeposits()`).
+    struct DriftParameters_t {
+      double anodeX;          ///< Position of the anode on the drift axis (cm)
+      int driftDirection;     ///< Drift on _x_: `+1` to larger, `-1` to smaller
+      double driftVelocity;   ///< Drift velocity (cm/ns)
+      double longDiffusion;   ///< Longitudinal diffusion constant (cm^2/ns)
+      double transDiffusion;  ///< Transverse diffusion constant (cm^2/ns)
+      double lifetime = 0.0;  ///< Electron lifetime (`0` for no loss) (ns)
+    }; // DriftParameters_t
+
+    /**
+     * @brief Drifts all the deposits of a batch to the anode.
+     * @param deposits the energy deposits
+     * @param params the parameters of the drift
+     * @return a batch with one cluster per deposit, in the same order
+     *
+     * Each deposit is drifted along _x_ to the anode plane, at `anodeX`, in the
+     * direction `driftDirection`: the deposits must be in the drift volume
+     * in front of that anode, that is at _x_ below `anodeX` if the direction
+     * is `+1`, above it if it is `-1`.
+     *
+     * * the drift time is the distance to the anode divided by the drift
+     *   velocity, and it is added to the time of the deposit;
+     * * the final position is the one on the anode plane;
+     * * the width of the cluster is `sqrt(2 D t)` for the drift time `t`,
+     *   with the longitudinal diffusion constant on _x_ and the transverse
+     *   one on _y_ and _z_;
+     * * if a lifetime is specified, the electrons are reduced by the
+     *   attenuation factor `exp(-t / lifetime)` (rounded to the closest
+     *   integer).
+     *
+     * Deposits behind the anode can't reach it: their clusters have no
+     * electrons, no drift time and no width.
+     *
+     * No random fluctuation is applied: the caller can sample the actual
+     * electrons from the returned mean values and widths.
+     */
+    static SimDriftedElectronClusterBatch DriftDeposits(
+      sim::ColumnarSimEnergyDeposits const& deposits,
+      DriftParameters_t const& params
+      );
+
+
+  private:
+    std::vector<int> fNumElectrons; ///< Ionization electrons.
+    std::vector<double> fTime; ///< Time (ns)
+    std::vector<float> fInitialX; ///< Initial position, x (cm)
+    std::vector<float> fInitialY; ///< Initial position, y (cm)
+    std::vector<float> fInitialZ; ///< Initial position, z (cm)
+    std::vector<float> fFinalX; ///< Final position, x (cm)
+    std::vector<float> fFinalY; ///< Final position, y (cm)
+    std::vector<float> fFinalZ; ///< Final position, z (cm)
+    std::vector<float> fWidthX; ///< Cluster width, x (cm)
+    std::vector<float> fWidthY; ///< Cluster width, y (cm)
+    std::vector<float> fWidthZ; ///< Cluster width, z (cm)
+    std::vector<float> fEnergy; ///< Energy deposition (MeV)
+    std::vector<int> fTrackID; ///< Simulation track ID.
+
+  }; // class SimDriftedElectronClusterBatch
+
+} // namespace sim
+
+
+#endif // LARDATAOBJ_SIMULATION_SIMDRIFTEDELECTRONCLUSTERBATCH_H
+
+////////////////////////////////////////////////////////////////////////
@@ -77,10 +77,14 @@ namespace sim
       , numElectrons(ne)
       , scintYieldRatio(sy)
       , edep(e)
-      , startPos(start)
-      , endPos(end)
+      , startPosX(start.X())
+      , startPosY(start.Y())
+      , startPosZ(start.Z())
+      , endPosX(end.X())
+      , endPosY(end.Y())
+      , endPosZ(end.Z())
       , startTime(t0)
-      , endTime(t1)
+      , deltaTime(t1 - t0)
       , trackID(id)
       , pdgCode(pdg)
     {
@@ -97,9 +101,9 @@ namespace sim
     int NumElectrons() const { return numElectrons; }
     double ScintYieldRatio() const { return scintYieldRatio;}
     double Energy() const { return edep; }
-    geo::Point_t Start() const { return { startPos.X(), startPos.Y(), startPos.Z() }; }
-    geo::Point_t End() const { return { endPos.X(), endPos.Y(), endPos.Z() }; }
-    double Time() const { return (startTime+endTime)/2.; }
+    geo::Point_t Start() const { return { startPosX, startPosY, startPosZ }; }
+    geo::Point_t End() const { return { endPosX, endPosY, endPosZ }; }
+    double Time() const { return (startTime+EndT())/2.; }
     int TrackID() const { return trackID; }
     int PdgCode() const { return pdgCode; }
 
@@ -107,38 +111,34 @@ namespace sim
     // constructor, it's not clear how users will want to access its
     // data. So give them as many different kinds of accessors as I
     // can think of.
-    geo::Length_t StartX() const { return startPos.X(); }
-    geo::Length_t StartY() const { return startPos.Y(); }
-    geo::Length_t StartZ() const { return startPos.Z(); }
+    geo::Length_t StartX() const { return startPosX; }
+    geo::Length_t StartY() const { return startPosY; }
+    geo::Length_t StartZ() const { return startPosZ; }
     double StartT() const { return startTime; }
-    geo::Length_t EndX() const { return endPos.X(); }
-    geo::Length_t EndY() const { return endPos.Y(); }
-    geo::Length_t EndZ() const { return endPos.Z(); }
-    double EndT() const { return endTime; }
+    geo::Length_t EndX() const { return endPosX; }
+    geo::Length_t EndY() const { return endPosY; }
+    geo::Length_t EndZ() const { return endPosZ; }
+    double EndT() const { return startTime + deltaTime; }
 
     // Step mid-point.
     geo::Point_t MidPoint() const {
-      return {
-	  ( startPos.X() + endPos.X() )/2.
-	, ( startPos.Y() + endPos.Y() )/2.
-	, ( startPos.Z() + endPos.Z() )/2.
-	    };
+      return { MidPointX(), MidPointY(), MidPointZ() };
     }
-    geo::Length_t MidPointX() const { return ( startPos.X() + endPos.X() )/2.; }
-    geo::Length_t MidPointY() const { return ( startPos.Y() + endPos.Y() )/2.; }
-    geo::Length_t MidPointZ() const { return ( startPos.Z() + endPos.Z() )/2.; }
-    geo::Length_t X() const { return ( startPos.X() + endPos.X() )/2.; }
-    geo::Length_t Y() const { return ( startPos.Y() + endPos.Y() )/2.; }
-    geo::Length_t Z() const { return ( startPos.Z() + endPos.Z() )/2.; }
-    double T() const { return (startTime+endTime)/2.; }
+    geo::Length_t MidPointX() const { return ( StartX() + EndX() )/2.; }
+    geo::Length_t MidPointY() const { return ( StartY() + EndY() )/2.; }
+    geo::Length_t MidPointZ() const { return ( StartZ() + EndZ() )/2.; }
+    geo::Length_t X() const { return MidPointX(); }
+    geo::Length_t Y() const { return MidPointY(); }
+    geo::Length_t Z() const { return MidPointZ(); }
+    double T() const { return (startTime+EndT())/2.; }
     double T0() const { return startTime; }
-    double T1() const { return endTime; }
+    double T1() const { return EndT(); }
     double E() const { return edep; }
 
     // Step length. (Recall that the difference between two
     // geo::Point_t objects is a geo::Vector_t; we get the length from
     // spherical coordinates.
-    geo::Length_t StepLength() const { return ( endPos - startPos ).R(); }
+    geo::Length_t StepLength() const { return ( End() - Start() ).R(); }
 
     // Just in case someone wants to store sim::SimEnergyDeposit
     // objects in a sorted container, define a sort function. Note
@@ -151,9 +151,9 @@ namespace sim
     {
       return trackID < rhs.trackID
 	&& startTime < rhs.startTime
-	&& startPos.Z() < rhs.startPos.Z()
-	&& startPos.Y() < rhs.startPos.Y()
-	&& startPos.X() < rhs.startPos.X()
+	&& startPosZ < rhs.startPosZ
+	&& startPosY < rhs.startPosY
+	&& startPosX < rhs.startPosX
 	&& edep > rhs.edep; // sort by _decreasing_ energy
     }
 
@@ -168,8 +168,9 @@ namespace sim
     // smallest position resolution in the simulation is about 0.1mm,
     // or 10^-4m. With seven digits of precision, that means a float
     // can be accurate to up to the range of 10^3m. That's why the
-    // definition of our local Point_t (see above) is based on float,
-    // while geo::Point_t is based on double.
+    // coordinates are stored as Length_t (see above), which is float,
+    // while geo::Point_t is based on double. They are stored one by
+    // one rather than as a point of floats, which has no dictionary.
 
     // If the above reasoning is wrong, just change the definition of
     // Length_t near the top of this file. Of course, also edit these
@@ -179,7 +180,9 @@ namespace sim
     // For time, it's possible for long-lived particles like neutrons
     // to deposit energy after billions of ns. Chances are time cuts
     // will take care of that, but let's make sure that any overlay studies
-    // won't suffer due to lack of precision.
+    // won't suffer due to lack of precision: the start time is kept in
+    // double precision, and the end time is stored as the duration of
+    // the step, which is short and fits a float.
 
     int           numPhotons;      ///< of scintillation photons
 //    int           numFPhotons;     ///< of fast scintillation photons
@@ -187,10 +190,14 @@ namespace sim
     int           numElectrons;    ///< of ionization electrons
     float         scintYieldRatio; ///< scintillation yield of LAr
     float         edep;            ///< energy deposition (MeV)
-    geo::Point_t       startPos;     ///< positions in (cm)
-    geo::Point_t       endPos;
+    Length_t      startPosX;    ///< positions in (cm)
+    Length_t      startPosY;
+    Length_t      startPosZ;
+    Length_t      endPosX;
+    Length_t      endPosY;
+    Length_t      endPosZ;
     double        startTime;    ///< (ns)
-    double        endTime;      ///< (ns)
+    float         deltaTime;    ///< end time minus start time (ns)
     int           trackID;      ///< simulation track id
     int           pdgCode;      ///< pdg code of particle to avoid lookup by particle type later
   };
@@ -15,7 +15,7 @@
 // -----------------------------------------------------------------------------
 sim::SimPhotons& sim::SimPhotons::operator+= (const SimPhotons &rhs) {
 
-  this->insert(this->begin(), rhs.cbegin(), rhs.cend());
+  this->insert(this->end(), rhs.cbegin(), rhs.cend());
   return *this;
 
 } // sim::SimPhotons::operator+=()
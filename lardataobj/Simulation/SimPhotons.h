@@ -170,9 +170,23 @@ public:
   void      SetChannel(int ch);
 
 
-  /// Add all photons from `rhs` to this ones; no sorting is applied.
+  /// Add all photons from `rhs` after these ones; no sorting is applied.
   SimPhotons& operator+=(const SimPhotons &rhs);
 
+  /**
+   * @brief Adds all photons from a sequence of `sim::SimPhotons`.
+   * @tparam Iter type of iterator to `sim::SimPhotons`
+   * @param begin iterator to the first `sim::SimPhotons` to be added
+   * @param end iterator past the last `sim::SimPhotons` to be added
+   * @return this object
+   *
+   * The photons are appended in order, as with repeated `operator+=`, but
+   * memory is allocated only once. The channel of the added photons is not
+   * checked.
+   */
+  template <typename Iter>
+  SimPhotons& Merge(Iter begin, Iter end);
+
   /// Creates a new `sim::SimPhotons` with all photons from `rhs` and
   /// this object.
   SimPhotons operator+(const SimPhotons &rhs) const;
@@ -258,6 +272,15 @@ inline void sim::SimPhotons::SetChannel(int ch) { fOpChannel = ch; }
 inline bool sim::SimPhotons::operator== (const sim::SimPhotons& other) const
   { return OpChannel() == other.OpChannel(); }
 
+template <typename Iter>
+sim::SimPhotons& sim::SimPhotons::Merge(Iter begin, Iter end) {
+  size_type n = size();
+  for (Iter it = begin; it != end; ++it) n += it->size();
+  reserve(n);
+  for (; begin != end; ++begin) insert(this->end(), begin->cbegin(), begin->cend());
+  return *this;
+} // sim::SimPhotons::Merge()
+
 // -----------------------------------------------------------------------------
 // ---  sim::SimPhotonsCollection
 // -----------------------------------------------------------------------------
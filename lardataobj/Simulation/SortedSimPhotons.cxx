@@ -0,0 +1,128 @@
+///
+/// \file  Simulation/SortedSimPhotons.cxx
+///
+/// \brief Photons on an optical detector channel, sorted by time.
+///
+////////////////////////////////////////////////////////////////////////
+
+#include <algorithm> // std::stable_sort(), std::lower_bound(), ...
+#include <numeric> // std::iota()
+#include <stdexcept> // std::runtime_error
+
+#include "lardataobj/Simulation/SortedSimPhotons.h"
+#include "lardataobj/Utilities/ApplyOrder.h"
+
+namespace sim{
+
+  //-------------------------------------------------
+  SortedSimPhotons::SortedSimPhotons(sim::SimPhotons const& photons)
+    : fOpChannel(photons.OpChannel())
+  {
+    Add(photons);
+    Sort();
+  }
+
+  //-------------------------------------------------
+  void SortedSimPhotons::Reserve(size_type n)
+  {
+    fTimes.reserve(n);
+    fEnergies.reserve(n);
+    fMotherTrackIDs.reserve(n);
+    fX.reserve(n);
+    fY.reserve(n);
+    fZ.reserve(n);
+  } // SortedSimPhotons::Reserve()
+
+  //-------------------------------------------------
+  void SortedSimPhotons::Add(sim::OnePhoton const& photon)
+  {
+    fTimes.push_back(photon.Time);
+    fEnergies.push_back(photon.Energy);
+    fMotherTrackIDs.push_back(photon.MotherTrackID);
+    fX.push_back(photon.InitialPosition.X());
+    fY.push_back(photon.InitialPosition.Y());
+    fZ.push_back(photon.InitialPosition.Z());
+    fSorted = false;
+  } // SortedSimPhotons::Add(OnePhoton)
+
+  //-------------------------------------------------
+  void SortedSimPhotons::Add(sim::SimPhotons const& photons)
+  {
+    Reserve(size() + photons.size());
+    for (sim::OnePhoton const& photon: photons) Add(photon);
+  } // SortedSimPhotons::Add(SimPhotons)
+
+  //-------------------------------------------------
+  void SortedSimPhotons::Sort()
+  {
+    if (fSorted) return;
+    fSorted = true;
+
+    auto const before = [this](std::size_t a, std::size_t b)
+      {
+        if (fTimes[a] < fTimes[b]) return true;
+        if (fTimes[a] > fTimes[b]) return false;
+        return fMotherTrackIDs[a] < fMotherTrackIDs[b];
+      };
+
+    std::vector<std::size_t> order(size());
+    std::iota(order.begin(), order.end(), 0);
+    if (std::is_sorted(order.begin(), order.end(), before)) return;
+    std::stable_sort(order.begin(), order.end(), before);
+
+    util::applyOrder(fTimes, order);
+    util::applyOrder(fEnergies, order);
+    util::applyOrder(fMotherTrackIDs, order);
+    util::applyOrder(fX, order);
+    util::applyOrder(fY, order);
+    util::applyOrder(fZ, order);
+  } // SortedSimPhotons::Sort()
+
+  //-------------------------------------------------
+  sim::OnePhoton SortedSimPhotons::Photon(size_type i) const
+  {
+    sim::OnePhoton photon;
+    photon.InitialPosition = InitialPosition(i);
+    photon.Time = fTimes[i];
+    photon.Energy = fEnergies[i];
+    photon.MotherTrackID = fMotherTrackIDs[i];
+    return photon;
+  } // SortedSimPhotons::Photon()
+
+  //-------------------------------------------------
+  auto SortedSimPhotons::TimeRange(float startTime, float endTime) const
+    -> IndexRange_t
+  {
+    if (!fSorted) {
+      throw std::runtime_error
+        ("SortedSimPhotons::TimeRange(): photons are not sorted");
+    }
+    auto const begin
+      = std::lower_bound(fTimes.begin(), fTimes.end(), startTime);
+    auto const end = std::lower_bound(begin, fTimes.end(), endTime);
+    return {
+      static_cast<size_type>(begin - fTimes.begin()),
+      static_cast<size_type>(end - fTimes.begin())
+      };
+  } // SortedSimPhotons::TimeRange()
+
+  //-------------------------------------------------
+  auto SortedSimPhotons::CountInTime(float startTime, float endTime) const
+    -> size_type
+  {
+    IndexRange_t const range = TimeRange(startTime, endTime);
+    return range.second - range.first;
+  } // SortedSimPhotons::CountInTime()
+
+  //-------------------------------------------------
+  sim::SimPhotons SortedSimPhotons::MakeSimPhotons() const
+  {
+    sim::SimPhotons photons { fOpChannel };
+    photons.reserve(size());
+    for (size_type i = 0; i < size(); ++i) photons.push_back(Photon(i));
+    return photons;
+  } // SortedSimPhotons::MakeSimPhotons()
+
+
+}
+////////////////////////////////////////////////////////////////////////
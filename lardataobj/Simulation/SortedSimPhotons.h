@@ -0,0 +1,164 @@
+/**
+ * @file   lardataobj/Simulation/SortedSimPhotons.h
+ * @brief  Photons on an optical detector channel, sorted by time.
+ * @see    lardataobj/Simulation/SortedSimPhotons.cxx
+ */
+
+#ifndef LARDATAOBJ_SIMULATION_SORTEDSIMPHOTONS_H
+#define LARDATAOBJ_SIMULATION_SORTEDSIMPHOTONS_H
+
+// LArSoftObj libraries
+#include "lardataobj/Simulation/SimPhotons.h"
+#include "larcoreobj/SimpleTypesAndConstants/geo_vectors.h" // geo::Point_t
+
+// C/C++ standard libraries
+#include <vector>
+#include <utility> // std::pair
+#include <cstddef> // std::size_t
+
+
+namespace sim {
+
+  /**
+   * @brief Photons on an optical detector channel, sorted by time.
+   *
+   * This object stores the photons of a channel as one array per quantity
+   * ("structure of arrays"): arrival time, energy, ID of the mother track and
+   * scintillation position. Algorithms which use only some of them (e.g. the
+   * arrival times) read only the memory they need.
+   *
+   * Photons are added with `Add()`, which only appends them; `Sort()` sorts
+   * all of them at once by time (and then by mother track ID, like
+   * `sim::OnePhoton` comparison), keeping the order of addition for equal
+   * photons. Queries by time window require the photons to be sorted.
+   *
+   * The local position of the photon in the optical detector and the
+   * `SetInSD` flag of `sim::OnePhoton` are not stored: `Photon()` and
+   * `MakeSimPhotons()` leave them to their default values.
+   */
+  class SortedSimPhotons {
+  public:
+    using size_type = std::size_t;
+
+    /// Range of photon indices: `[ first, second [`.
+    using IndexRange_t = std::pair<size_type, size_type>;
+
+    /// Default constructor (do not use! it's for ROOT only).
+    SortedSimPhotons() = default;
+
+    /// Constructor: associated to optical detector channel `chan`, and empty.
+    explicit SortedSimPhotons(int chan): fOpChannel(chan) {}
+
+    /// Constructor: copies and sorts all the photons of `photons`.
+    explicit SortedSimPhotons(sim::SimPhotons const& photons);
+
+
+    // --- BEGIN -- Filling --------------------------------------------------
+    ///@name Filling
+    ///@{
+
+    /// Prepares the storage for `n` photons in total.
+    void Reserve(size_type n);
+
+    /// Appends a photon; photons are not sorted any more.
+    void Add(sim::OnePhoton const& photon);
+
+    /// Appends all the photons of `photons`; photons are not sorted any more.
+    void Add(sim::SimPhotons const& photons);
+
+    /// Sorts the photons by time, then by mother track ID (stable).
+    void Sort();
+
+    ///@}
+    // --- END -- Filling ----------------------------------------------------
+
+
+    // --- BEGIN -- Accessors ------------------------------------------------
+    ///@name Accessors
+    ///@{
+
+    /// Returns the optical channel number this object is associated to.
+    int OpChannel() const { return fOpChannel; }
+
+    /// Returns the number of photons.
+    size_type size() const { return fTimes.size(); }
+
+    /// Returns whether there are no photons.
+    bool empty() const { return fTimes.empty(); }
+
+    /// Returns whether the photons are sorted.
+    bool IsSorted() const { return fSorted; }
+
+    /// Arrival time of all photons [ns]
+    std::vector<float> const& Times() const { return fTimes; }
+
+    /// Energy of all photons [GeV]
+    std::vector<float> const& Energies() const { return fEnergies; }
+
+    /// ID of the GEANT4 track causing the scintillation, for all photons.
+    std::vector<int> const& MotherTrackIDs() const { return fMotherTrackIDs; }
+
+    /// Arrival time of photon `i` [ns]
+    float Time(size_type i) const { return fTimes[i]; }
+
+    /// Energy of photon `i` [GeV]
+    float Energy(size_type i) const { return fEnergies[i]; }
+
+    /// ID of the GEANT4 track causing the scintillation of photon `i`.
+    int MotherTrackID(size_type i) const { return fMotherTrackIDs[i]; }
+
+    /// Scintillation position of photon `i` in world coordinates [cm]
+    geo::Point_t InitialPosition(size_type i) const
+      { return { fX[i], fY[i], fZ[i] }; }
+
+    /// Returns photon `i` (local position and `SetInSD` are default values).
+    sim::OnePhoton Photon(size_type i) const;
+
+    ///@}
+    // --- END -- Accessors --------------------------------------------------
+
+
+    // --- BEGIN -- Queries --------------------------------------------------
+    ///@name Queries
+    ///@{
+
+    /**
+     * @brief Returns the photons arriving in the specified time interval.
+     * @param startTime start of the interval (included) [ns]
+     * @param endTime end of the interval (excluded) [ns]
+     * @return the range of indices of the photons in the interval
+     * @throw std::runtime_error if the photons are not sorted
+     */
+    IndexRange_t TimeRange(float startTime, float endTime) const;
+
+    /// Returns the number of photons arriving in `[ startTime, endTime [`.
+    size_type CountInTime(float startTime, float endTime) const;
+
+    ///@}
+    // --- END -- Queries ----------------------------------------------------
+
+
+    /// Returns a `sim::SimPhotons` with all the photons, in the current order.
+    sim::SimPhotons MakeSimPhotons() const;
+
+
+  private:
+    int fOpChannel = -1; ///< Optical detector channel associated to this data.
+
+    bool fSorted = true; ///< Whether the photons are sorted.
+
+    std::vector<float> fTimes;        ///< Arrival time of each photon [ns]
+    std::vector<float> fEnergies;     ///< Energy of each photon [GeV]
+    std::vector<int> fMotherTrackIDs; ///< Mother track ID of each photon.
+    std::vector<double> fX; ///< x of scintillation position of each photon [cm]
+    std::vector<double> fY; ///< y of scintillation position of each photon [cm]
+    std::vector<double> fZ; ///< z of scintillation position of each photon [cm]
+
+  }; // class SortedSimPhotons
+
+} // namespace sim
+
+
+#endif // LARDATAOBJ_SIMULATION_SORTEDSIMPHOTONS_H
+
+////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,46 @@
+/**
+ * @file   lardataobj/Utilities/ApplyOrder.h
+ * @brief  Rearrangement of the elements of a vector in a given order.
+ *
+ * This is a header-only library.
+ *
+ */
+
+#ifndef LARDATAOBJ_UTILITIES_APPLYORDER_H
+#define LARDATAOBJ_UTILITIES_APPLYORDER_H
+
+// C/C++ standard libraries
+#include <vector>
+#include <utility> // std::move()
+#include <cstddef> // std::size_t
+
+
+namespace util {
+
+  /**
+   * @brief Rearranges `data` so that `data[i]` becomes the old `data[order[i]]`.
+   * @tparam T type of the elements
+   * @param data the vector to be rearranged
+   * @param order the position in `data` of each new element
+   *
+   * This is the usual way to sort many "columns" of data in the same way:
+   * the order is computed once (e.g. sorting the positions of the elements
+   * with a comparison on some of the columns) and then applied to each column.
+   * `order` is not required to be a permutation: `data` will have as many
+   * elements as `order`, and the elements not in `order` are dropped.
+   * Each selected element is moved out of `data`, so `order` must not contain
+   * repeated indices.
+   */
+  template <typename T>
+  void applyOrder(std::vector<T>& data, std::vector<std::size_t> const& order)
+  {
+    std::vector<T> sorted;
+    sorted.reserve(order.size());
+    for (std::size_t i: order) sorted.push_back(std::move(data[i]));
+    data = std::move(sorted);
+  } // applyOrder()
+
+} // namespace util
+
+
+#endif // LARDATAOBJ_UTILITIES_APPLYORDER_H
@@ -0,0 +1,76 @@
+/**
+ * @file   lardataobj/Utilities/IteratorRange.h
+ * @brief  Non-owning view of a sequence delimited by two iterators.
+ *
+ * This is a header-only library.
+ *
+ */
+
+#ifndef LARDATAOBJ_UTILITIES_ITERATORRANGE_H
+#define LARDATAOBJ_UTILITIES_ITERATORRANGE_H
+
+// C/C++ standard libraries
+#include <iterator> // std::distance()
+#include <cstddef> // std::size_t
+
+
+namespace util {
+
+  /**
+   * @brief Range of elements between two iterators, without ownership.
+   * @tparam Iter type of the iterators delimiting the range
+   *
+   * This is the type returned by the data products that expose a part of
+   * their storage (typically a pair of pointers into a vector) without
+   * copying it. The range is valid as long as the underlying storage is not
+   * changed or destroyed.
+   *
+   * `size()` is constant time for random access iterators (e.g. pointers),
+   * and linear otherwise; `operator[]` is available only with random access
+   * iterators.
+   *
+   * Example:
+   * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.cpp}
+   * std::vector<float> const data { 1.0, 2.0, 3.0, 4.0 };
+   * util::IteratorRange<float const*> const tail
+   *   { data.data() + 1, data.data() + data.size() };
+   * for (float v: tail) std::cout << " " << v; // prints " 2 3 4"
+   * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+   */
+  template <typename Iter>
+  class IteratorRange {
+  public:
+    using iterator = Iter; ///< Type of iterator to the elements.
+    using size_type = std::size_t; ///< Type of the size of the range.
+
+    /// Constructor: an empty range (value-initialized iterators).
+    IteratorRange(): fBegin(), fEnd() {}
+
+    /// Constructor: the range `[b, e)`.
+    IteratorRange(Iter b, Iter e): fBegin(b), fEnd(e) {}
+
+    /// Returns an iterator to the first element.
+    Iter begin() const { return fBegin; }
+
+    /// Returns an iterator past the last element.
+    Iter end() const { return fEnd; }
+
+    /// Returns whether the range has no elements.
+    bool empty() const { return fBegin == fEnd; }
+
+    /// Returns the number of elements in the range.
+    size_type size() const { return std::distance(fBegin, fEnd); }
+
+    /// Returns the element at position `i` (random access iterators only).
+    decltype(auto) operator[] (size_type i) const { return fBegin[i]; }
+
+  private:
+    Iter fBegin; ///< Iterator to the first element.
+    Iter fEnd; ///< Iterator past the last element.
+
+  }; // class IteratorRange
+
+} // namespace util
+
+
+#endif // LARDATAOBJ_UTILITIES_ITERATORRANGE_H
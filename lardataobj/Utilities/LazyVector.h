@@ -14,6 +14,9 @@
 // C/C++ standard libraries
 #include <algorithm>
 #include <vector>
+#if __has_include(<memory_resource>) // not in libstdc++ before GCC 9
+#  include <memory_resource> // std::pmr::polymorphic_allocator
+#endif
 #include <string> // std::to_string()
 #include <stdexcept> // std::out_of_range
 #include <cassert>
@@ -143,6 +146,13 @@ namespace util {
      */
     LazyVector(size_type n, value_type const& defValue);
 
+    /// Constructor: like `LazyVector(size_type)`, using the allocator `a`.
+    LazyVector(size_type n, allocator_type const& a);
+
+    /// Constructor: like `LazyVector(size_type, value_type const&)`, using the
+    /// allocator `a`.
+    LazyVector(size_type n, value_type const& defValue, allocator_type const& a);
+
 
     /// --- END Constructors -------------------------------------------------
 
@@ -155,6 +165,9 @@ namespace util {
     /// Returns the size of the vector.
     size_type size() const noexcept { return fNominalSize; }
 
+    /// Returns the allocator used for the data storage.
+    allocator_type get_allocator() const { return storage().get_allocator(); }
+
     /// Returns whether the vector is empty.
     bool empty() const noexcept { return fNominalSize == 0U; }
 
@@ -473,6 +486,27 @@ namespace util {
 
   }; // LazyVector<>
 
+
+#if __has_include(<memory_resource>)
+  namespace pmr {
+
+    /**
+     * @brief A `util::LazyVector` drawing its memory from a memory resource.
+     * @tparam T type of contained data
+     *
+     * Example:
+     * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.cpp}
+     * std::pmr::monotonic_buffer_resource arena;
+     * util::pmr::LazyVector<double> v(6U, &arena);
+     * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+     * The memory resource must outlive the vector.
+     */
+    template <typename T>
+    using LazyVector = util::LazyVector<T, std::pmr::polymorphic_allocator<T>>;
+
+  } // namespace pmr
+#endif // __has_include(<memory_resource>)
+
 } // namespace util
 
 
@@ -506,6 +540,23 @@ util::LazyVector<T,A>::LazyVector(size_type n, value_type const& defValue)
   {}
 
 
+//------------------------------------------------------------------------------
+template <typename T, typename A /* = std::vector<T>::allocator_type */>
+util::LazyVector<T,A>::LazyVector(size_type n, allocator_type const& a)
+  : LazyVector(n, defaultValueType(), a)
+  {}
+
+
+//------------------------------------------------------------------------------
+template <typename T, typename A /* = std::vector<T>::allocator_type */>
+util::LazyVector<T,A>::LazyVector
+  (size_type n, value_type const& defValue, allocator_type const& a)
+  : fData(a)
+  , fNominalSize(n)
+  , fDefValue(defValue)
+  {}
+
+
 //------------------------------------------------------------------------------
 template <typename T, typename A /* = std::vector<T>::allocator_type */>
 typename util::LazyVector<T,A>::reference util::LazyVector<T,A>::at
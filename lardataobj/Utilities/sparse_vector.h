@@ -21,6 +21,10 @@
 #include <algorithm> // std::upper_bound(), std::max()
 #include <numeric> // std::accumulate
 #include <type_traits> // std::is_integral
+#include <memory> // std::allocator, std::allocator_traits
+#if __has_include(<memory_resource>) // not in libstdc++ before GCC 9
+#  include <memory_resource> // std::pmr::polymorphic_allocator
+#endif
 
 
 /// Namespace for generic LArSoft-related utilities.
@@ -286,18 +290,19 @@ class range_t {
 // ---
 
 // the price of having used subclasses extensively:
-template <typename T> class sparse_vector;
+template <typename T, typename A = std::allocator<T>> class sparse_vector;
 
 namespace details {
-  template <typename T>
+  template <typename T, typename A>
   decltype(auto) make_const_datarange_t
-    (typename sparse_vector<T>::datarange_t& r);
+    (typename sparse_vector<T, A>::datarange_t& r);
 } // namespace details
 
 
 /** ****************************************************************************
  * @brief A sparse vector
  * @tparam T type of data stored in the vector
+ * @tparam A allocator for the data (default: STL vector's default allocator)
  * @todo backward iteration; reverse iterators; iterator on non-void elements
  * only; iterator on non-void elements only, returning a pair (index;value)
  *
@@ -433,6 +438,16 @@ namespace details {
  * So far, set_at() is the closest thing to it.
  *
  *
+ * Allocators
+ * ----------
+ *
+ * The allocator `A` is used for the data of all the ranges and, rebound, for
+ * the list of ranges itself. Ranges are allocator-aware, so that allocators
+ * propagating to their elements (like `std::pmr::polymorphic_allocator`) are
+ * also used for the range data. `lar::pmr::sparse_vector` is a shortcut for
+ * the sparse vector with a polymorphic allocator.
+ *
+ *
  * Non-supported usage
  * -------------------
  *
@@ -463,15 +478,16 @@ namespace details {
  * (see above).
  *
  */
-template <typename T>
+template <typename T, typename A>
 class sparse_vector {
-  typedef sparse_vector<T> this_t;
+  typedef sparse_vector<T, A> this_t;
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
   //  - - - public interface
     public:
   //  - - - types
   typedef T value_type; ///< type of the stored values
-  typedef std::vector<value_type> vector_t;
+  typedef A allocator_type; ///< type of allocator for the stored values
+  typedef std::vector<value_type, allocator_type> vector_t;
                                       ///< type of STL vector holding this data
   typedef typename vector_t::size_type size_type;                ///< size type
   typedef typename vector_t::difference_type difference_type;
@@ -489,9 +505,14 @@ class sparse_vector {
 
   class datarange_t;
   class const_datarange_t;
+
+  class cursor;
   // --- ----------------- ---
 
-  typedef std::vector<datarange_t> range_list_t;
+  typedef typename std::allocator_traits<allocator_type>::template
+    rebind_alloc<datarange_t> range_allocator_type;
+                                           ///< type of allocator for ranges
+  typedef std::vector<datarange_t, range_allocator_type> range_list_t;
                                                ///< type of sparse vector data
   typedef typename range_list_t::iterator range_iterator;
                                              ///< type of iterator over ranges
@@ -504,29 +525,50 @@ class sparse_vector {
   /// Default constructor: an empty vector
   sparse_vector(): nominal_size(0), ranges() {}
 
+  /// Constructor: an empty vector, allocating its data with `alloc`
+  explicit sparse_vector(allocator_type const& alloc):
+    nominal_size(0), ranges(range_allocator_type(alloc)) {}
+
 
   /// Constructor: a vector with new_size elements in the void
   sparse_vector(size_type new_size): nominal_size(0), ranges()
     { resize(new_size); }
 
+  /// Constructor: a vector with new_size elements in the void, using `alloc`
+  sparse_vector(size_type new_size, allocator_type const& alloc):
+    nominal_size(0), ranges(range_allocator_type(alloc))
+    { resize(new_size); }
+
   /**
    * @brief Constructor: a solid vector from an existing STL vector
    * @param from vector to copy data from
    * @param offset (default: 0) index the data starts from (preceeded by void)
    */
   sparse_vector(const vector_t& from, size_type offset = 0):
-    nominal_size(0), ranges()
+    nominal_size(0), ranges(range_allocator_type(from.get_allocator()))
     { add_range(offset, from.begin(), from.end()); }
 
   /// Copy constructor: default
   sparse_vector(sparse_vector const&) = default;
 
+  /// Copy constructor, allocating the copy with `alloc`
+  sparse_vector(sparse_vector const& from, allocator_type const& alloc)
+    : nominal_size(from.nominal_size)
+    , ranges(from.ranges, range_allocator_type(alloc))
+    {}
+
   /// Move constructor
   sparse_vector(sparse_vector&& from)
     : nominal_size(from.nominal_size)
     , ranges(std::move(from.ranges))
     { from.nominal_size = 0; }
 
+  /// Move constructor; data is copied if `alloc` differs from `from`'s one
+  sparse_vector(sparse_vector&& from, allocator_type const& alloc)
+    : nominal_size(from.nominal_size)
+    , ranges(std::move(from.ranges), range_allocator_type(alloc))
+    { from.ranges.clear(); from.nominal_size = 0; }
+
   /// Copy assignment: default
   sparse_vector& operator=(sparse_vector const&) = default;
 
@@ -545,7 +587,7 @@ class sparse_vector {
    * @param offset (default: 0) index the data starts from (preceeded by void)
    */
   sparse_vector(vector_t&& from, size_type offset = 0):
-    nominal_size(0), ranges()
+    nominal_size(0), ranges(range_allocator_type(from.get_allocator()))
     { add_range(offset, std::move(from)); }
 
 
@@ -553,7 +595,72 @@ class sparse_vector {
   ~sparse_vector() = default;
 
 
+  ///@{ @name Construction from dense data
+
+  /**
+   * @brief Creates a sparse vector keeping only the values above threshold.
+   * @tparam ITER type of random access iterator to the dense data
+   * @param first iterator to the first element of the dense data
+   * @param last iterator past the last element of the dense data
+   * @param thr values not above this threshold (in module) are void
+   * @param padding number of elements to keep around each value above threshold
+   * @param alloc allocator for the new vector
+   * @return a sparse vector with the same size as the dense data
+   *
+   * The elements are selected with the same criterion as
+   * `push_back(value, thr)`, that is they are kept if not `is_zero(value, thr)`.
+   * In addition, up to `padding` elements before and after each selected
+   * element are also kept (with their original value, whatever it is).
+   * Padded regions which overlap or touch are merged into a single range.
+   *
+   * All the range boundaries are found first, with a scan of the dense data
+   * designed for auto-vectorization; then each range is allocated once and
+   * filled with a copy of its data.
+   *
+   * Example:
+   * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.cpp}
+   * std::vector<float> waveform;
+   * // ...
+   * auto ROIs = lar::sparse_vector<float>::from_dense
+   *   (waveform.begin(), waveform.end(), 2.5f, 5U);
+   * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+   */
+  template <typename ITER>
+  static sparse_vector from_dense(
+    ITER first, ITER last, value_type thr, size_type padding = 0,
+    allocator_type const& alloc = allocator_type()
+    );
+
+  /**
+   * @brief Creates a sparse vector keeping only the values selected by a mask.
+   * @tparam ITER type of random access iterator to the dense data
+   * @tparam MITER type of random access iterator to the mask
+   * @param first iterator to the first element of the dense data
+   * @param last iterator past the last element of the dense data
+   * @param mask iterator to the first element of the mask
+   * @param padding number of elements to keep around each selected element
+   * @param alloc allocator for the new vector
+   * @return a sparse vector with the same size as the dense data
+   *
+   * The element `i` is selected if `mask[i]` converts to `true`; the mask
+   * must have at least as many elements as the dense data.
+   * Padding and merging of the ranges follow the same rules as in
+   * `from_dense(ITER, ITER, value_type, size_type, allocator_type const&)`.
+   */
+  template <typename ITER, typename MITER>
+  static sparse_vector from_dense_mask(
+    ITER first, ITER last, MITER mask, size_type padding = 0,
+    allocator_type const& alloc = allocator_type()
+    );
+
+  ///@}
+
+
   //  - - - STL-like interface
+  /// Returns the allocator used for the data
+  allocator_type get_allocator() const
+    { return allocator_type(ranges.get_allocator()); }
+
   /// Removes all the data, making the vector empty
   void clear() { ranges.clear(); nominal_size = 0; }
 
@@ -795,6 +902,23 @@ class sparse_vector {
   datarange_t& find_range(size_type index);
   //@}
 
+  /**
+   * @brief Returns a cursor for repeated look-ups into this vector.
+   * @return a cursor positioned at the beginning of the vector
+   * @see `cursor`
+   *
+   * The cursor remembers the range of the last look-up and starts the search
+   * for the next one from there. It is more efficient than `operator[]`,
+   * `is_void()` and `find_range_iterator()` when the indices are probed in
+   * (roughly) monotonic order:
+   * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.cpp}
+   * auto cursor = sv.make_cursor();
+   * for (std::size_t tick: sortedTicks) total += cursor[tick];
+   * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+   * The cursor is invalidated by any change in the ranges of the vector.
+   */
+  cursor make_cursor() const;
+
   /**
    * @brief Casts the whole range with the specified item into the void
    * @param index absolute index of the element whose range is cast to void
@@ -1046,6 +1170,24 @@ class sparse_vector {
   size_type nominal_size; ///< current size
   range_list_t ranges; ///< list of ranges
 
+  /// Implementation of `from_dense()`: `selected(i)` tells if `i` is kept
+  template <typename ITER, typename PRED>
+  static sparse_vector from_dense_impl(
+    ITER first, ITER last, PRED selected, size_type padding,
+    allocator_type const& alloc
+    );
+
+  /**
+   * @brief Returns the first index in `[ from, to [` with `selected() == sel`.
+   * @return the first index with `selected(index) == sel`, or `to` if none
+   *
+   * The test is performed on blocks of indices at a time, with no early exit
+   * inside each block, so that it can be vectorized by the compiler.
+   */
+  template <typename PRED>
+  static size_type find_selection
+    (PRED& selected, bool sel, size_type from, size_type to);
+
   //@{
   /**
    * @brief Returns an iterator to the range after `index`.
@@ -1170,6 +1312,29 @@ class sparse_vector {
 }; // class sparse_vector<>
 
 
+#if __has_include(<memory_resource>)
+namespace pmr {
+
+  /**
+   * @brief A `lar::sparse_vector` drawing its memory from a memory resource.
+   * @tparam T type of data stored in the vector
+   *
+   * Both the list of ranges and the data of each range are allocated from the
+   * memory resource specified on construction:
+   * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.cpp}
+   * std::pmr::monotonic_buffer_resource arena;
+   * lar::pmr::sparse_vector<float> sv(4096, &arena);
+   * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+   * The memory resource must outlive the vector.
+   */
+  template <typename T>
+  using sparse_vector
+    = lar::sparse_vector<T, std::pmr::polymorphic_allocator<T>>;
+
+} // namespace pmr
+#endif // __has_include(<memory_resource>)
+
+
 } // namespace lar
 
 
@@ -1188,8 +1353,8 @@ class sparse_vector {
  *   ...
  * </pre>
  */
-template <typename T>
-std::ostream& operator<< (std::ostream& out, const lar::sparse_vector<T>& v);
+template <typename T, typename A>
+std::ostream& operator<< (std::ostream& out, const lar::sparse_vector<T, A>& v);
 
 
 
@@ -1198,32 +1363,56 @@ std::ostream& operator<< (std::ostream& out, const lar::sparse_vector<T>& v);
 // ---
 
 /// Range class, with range and data
-template <typename T>
-class lar::sparse_vector<T>::datarange_t: public range_t<size_type> {
+template <typename T, typename A>
+class lar::sparse_vector<T, A>::datarange_t: public range_t<size_type> {
     public:
   typedef range_t<size_type> base_t; ///< base class
 
   typedef typename vector_t::iterator iterator;
   typedef typename vector_t::const_iterator const_iterator;
 
+  /// Type of allocator of the data (makes this class allocator-aware).
+  typedef typename sparse_vector<T, A>::allocator_type allocator_type;
+
   /// Default constructor: an empty range
   datarange_t(): base_t(), values() {}
 
+  /// Constructor: an empty range with the specified allocator
+  explicit datarange_t(allocator_type const& alloc): base_t(), values(alloc) {}
+
   /// Constructor: range initialized with 0
-  datarange_t(const base_t& range): base_t(range), values(range.size()) {}
+  datarange_t
+    (const base_t& range, allocator_type const& alloc = allocator_type()):
+    base_t(range), values(range.size(), value_zero, alloc) {}
 
   /// Constructor: offset and data
   template <typename ITER>
-  datarange_t(size_type offset, ITER first, ITER last):
+  datarange_t(
+    size_type offset, ITER first, ITER last,
+    allocator_type const& alloc = allocator_type()
+    ):
     base_t(offset, offset + std::distance(first, last)),
-    values(first, last)
+    values(first, last, alloc)
     {}
 
   /// Constructor: offset and data as a vector (which will be used directly)
   datarange_t(size_type offset, vector_t&& data):
-    base_t(offset, offset + data.size()), values(data)
+    base_t(offset, offset + data.size()), values(std::move(data))
+    {}
+
+  /// Constructor: offset and data as a vector, stored with `alloc`
+  datarange_t(size_type offset, vector_t&& data, allocator_type const& alloc):
+    base_t(offset, offset + data.size()), values(std::move(data), alloc)
     {}
 
+  //@{
+  /// Copy and move constructors storing the data with the specified allocator
+  datarange_t(datarange_t const& from, allocator_type const& alloc):
+    base_t(from), values(from.values, alloc) {}
+  datarange_t(datarange_t&& from, allocator_type const& alloc):
+    base_t(from), values(std::move(from.values), alloc) {}
+  //@}
+
 
   //@{
   /// Returns an iterator to the specified absolute value (no check!)
@@ -1321,8 +1510,8 @@ class lar::sparse_vector<T>::datarange_t: public range_t<size_type> {
  *
  * Values in the range can be modified, but their position and number can not.
  */
-template <typename T>
-class lar::sparse_vector<T>::const_datarange_t: private datarange_t {
+template <typename T, typename A>
+class lar::sparse_vector<T, A>::const_datarange_t: private datarange_t {
     public:
   using iterator = typename datarange_t::iterator;
   using const_iterator = typename datarange_t::const_iterator;
@@ -1362,7 +1551,7 @@ class lar::sparse_vector<T>::const_datarange_t: private datarange_t {
   ~const_datarange_t() = delete; // can't destroy; can cast into it though
 
     protected:
-  friend decltype(auto) details::make_const_datarange_t<T>(datarange_t&);
+  friend decltype(auto) details::make_const_datarange_t<T, A>(datarange_t&);
 
   datarange_t const& base() const
     { return static_cast<datarange_t const&>(*this); }
@@ -1374,13 +1563,94 @@ class lar::sparse_vector<T>::const_datarange_t: private datarange_t {
 }; // lar::sparse_vector<T>::const_datarange_t
 
 
+/**
+ * @brief Read-only look-up helper remembering the last range it visited.
+ *
+ * A cursor answers the same questions as `sparse_vector::operator[]`,
+ * `sparse_vector::is_void()` and `sparse_vector::find_range_iterator()`.
+ * Instead of a binary search on all the ranges, each query starts from the
+ * range found by the previous one and moves forward or backward with a
+ * galloping (exponential) search, which is followed by a binary search in the
+ * bracketed interval.
+ * A sequence of look-ups with increasing (or decreasing) indices costs
+ * O(log d) each, where d is the number of ranges skipped since the last
+ * query, and it is O(1) for indices in the same or in the next range.
+ *
+ * The cursor holds a pointer to the sparse vector and the position of a range
+ * in its list; any operation changing the ranges of the vector (including
+ * assignment, moving and destruction) invalidates it.
+ * The `reset()` method brings it back to the first range.
+ */
+template <typename T, typename A>
+class lar::sparse_vector<T, A>::cursor {
+  using container_t = sparse_vector<T, A>;
+
+    public:
+  using value_type = typename container_t::value_type;
+  using size_type = typename container_t::size_type;
+  using range_const_iterator = typename container_t::range_const_iterator;
+
+  /// Default constructor: not associated to any vector (do not use it!).
+  cursor() = default;
+
+  /// Constructor: cursor on the specified vector, at its first range.
+  explicit cursor(container_t const& c): cont(&c) {}
+
+  /// Returns the value at `index` (zero if in the void).
+  value_type operator[] (size_type index);
+
+  /**
+   * @brief Returns whether the specified position is void.
+   * @param index position of the cell to be tested
+   * @throw out_of_range if index is not in the vector
+   * @see `sparse_vector::is_void()`
+   */
+  bool is_void(size_type index);
+
+  /**
+   * @brief Returns an iterator to the range containing the specified index.
+   * @param index absolute index of the element to be sought
+   * @return iterator to containing range, or `get_ranges().end()` if in void
+   * @throw std::out_of_range if the vector has no range
+   * @see `sparse_vector::find_range_iterator()`
+   */
+  range_const_iterator find_range_iterator(size_type index);
+
+  /**
+   * @brief Returns an iterator to the first range starting after `index`.
+   * @param index the absolute index
+   * @return iterator to the first range with offset larger than `index`,
+   *         or `get_ranges().end()` if none
+   *
+   * This is the same result as a `std::upper_bound()` on the range offsets,
+   * and the primitive of all the other look-ups.
+   */
+  range_const_iterator find_next_range_iter(size_type index);
+
+  /// Moves the cursor back to the first range.
+  void reset() { next = 0; }
+
+  /// Returns the vector this cursor looks into.
+  container_t const& container() const { return *cont; }
+
+    private:
+  container_t const* cont = nullptr; ///< vector the cursor looks into
+  std::size_t next = 0; ///< upper bound (as range number) of the last query
+
+  /// Returns the offset of the range number `i`.
+  size_type range_offset(std::size_t i) const
+    { return cont->ranges[i].begin_index(); }
+
+}; // lar::sparse_vector<T>::cursor
+
+
 // -----------------------------------------------------------------------------
 // --- sparse_vector iterators definition
 // ---
 
 /// Special little box to allow void elements to be treated as references.
-template <typename T>
-class lar::sparse_vector<T>::const_reference {
+template <typename T, typename A>
+class lar::sparse_vector<T, A>::const_reference {
     protected:
   const value_type* ptr;
     public:
@@ -1400,8 +1670,8 @@ class lar::sparse_vector<T>::const_reference {
   * if the internal pointer is invalid (as in case of void cell),
   * dereferencing or assigning will provoke a segmentation fault.
   */
-template <typename T>
-class lar::sparse_vector<T>::reference: public const_reference {
+template <typename T, typename A>
+class lar::sparse_vector<T, A>::reference: public const_reference {
   friend class iterator;
 
   // This object "disappears" when assigned to: either the assignment is not
@@ -1427,8 +1697,8 @@ class lar::sparse_vector<T>::reference: public const_reference {
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 /// Iterator to the sparse vector values
-template <typename T>
-class lar::sparse_vector<T>::const_iterator {
+template <typename T, typename A>
+class lar::sparse_vector<T, A>::const_iterator {
   //
   // This iterator fulfils the traits of an immutable forward iterator.
   //
@@ -1436,7 +1706,7 @@ class lar::sparse_vector<T>::const_iterator {
     protected:
   friend class container_t;
 
-  typedef sparse_vector<T> container_t;
+  typedef sparse_vector<T, A> container_t;
   typedef typename container_t::size_type size_type;
   typedef typename container_t::range_list_t::const_iterator ranges_const_iterator;
 
@@ -1576,8 +1846,8 @@ class lar::sparse_vector<T>::const_iterator {
  * to a cell which is not in a range already is not supported yet
  * (it can be done with some complicate mechanism).
  */
-template <typename T>
-class lar::sparse_vector<T>::iterator: public const_iterator {
+template <typename T, typename A>
+class lar::sparse_vector<T, A>::iterator: public const_iterator {
   typedef typename const_iterator::container_t container_t;
   friend typename const_iterator::container_t;
 
@@ -1661,17 +1931,17 @@ namespace lar::details {
 
 
   // --------------------------------------------------------------------------
-  template <typename T>
+  template <typename T, typename A>
   decltype(auto) make_const_datarange_t
-    (typename sparse_vector<T>::datarange_t& r)
-    { return static_cast<typename sparse_vector<T>::const_datarange_t&>(r); }
+    (typename sparse_vector<T, A>::datarange_t& r)
+    { return static_cast<typename sparse_vector<T, A>::const_datarange_t&>(r); }
 
 
   // --------------------------------------------------------------------------
-  template <typename T>
+  template <typename T, typename A>
   class const_datarange_iterator {
-    using const_datarange_t = typename sparse_vector<T>::const_datarange_t;
-    using base_iterator = typename sparse_vector<T>::range_iterator;
+    using const_datarange_t = typename sparse_vector<T, A>::const_datarange_t;
+    using base_iterator = typename sparse_vector<T, A>::range_iterator;
     base_iterator it;
       public:
     // minimal set of features for ranged-for loops
@@ -1680,7 +1950,7 @@ namespace lar::details {
 
     const_datarange_iterator& operator++() { ++it; return *this; }
     const_datarange_t& operator*() const
-      { return make_const_datarange_t<T>(*it); }
+      { return make_const_datarange_t<T, A>(*it); }
     bool operator!=(const_datarange_iterator const& other) const
       { return it != other.it; }
 
@@ -1694,20 +1964,20 @@ namespace lar::details {
 //------------------------------------------------------------------------------
 //--- sparse_vector implementation
 
-template <typename T>
-constexpr typename lar::sparse_vector<T>::value_type
-  lar::sparse_vector<T>::value_zero;
+template <typename T, typename A>
+constexpr typename lar::sparse_vector<T, A>::value_type
+  lar::sparse_vector<T, A>::value_zero;
 
-template <typename T>
-decltype(auto) lar::sparse_vector<T>::iterate_ranges() {
+template <typename T, typename A>
+decltype(auto) lar::sparse_vector<T, A>::iterate_ranges() {
   return details::iteratorRange(
-    details::const_datarange_iterator<T>(ranges.begin()),
-    details::const_datarange_iterator<T>(ranges.end())
+    details::const_datarange_iterator<T, A>(ranges.begin()),
+    details::const_datarange_iterator<T, A>(ranges.end())
     );
 } // lar::sparse_vector<T>::iterate_ranges()
 
-template <typename T>
-void lar::sparse_vector<T>::resize(size_type new_size) {
+template <typename T, typename A>
+void lar::sparse_vector<T, A>::resize(size_type new_size) {
   if (new_size >= size()) {
     nominal_size = new_size;
     return;
@@ -1729,13 +1999,13 @@ void lar::sparse_vector<T>::resize(size_type new_size) {
 } // lar::sparse_vector<T>::resize()
 
 
-template <typename T>
-void lar::sparse_vector<T>::resize(size_type new_size, value_type def_value) {
+template <typename T, typename A>
+void lar::sparse_vector<T, A>::resize(size_type new_size, value_type def_value) {
   if (new_size == size()) return;
   if (new_size > size()) {
 
     if (back_is_void()) // add a new range
-      append(vector_t(new_size - size(), def_value));
+      append(vector_t(new_size - size(), def_value, get_allocator()));
     else // extend the last range
       ranges.back().resize(new_size - ranges.back().begin_index(), def_value);
 
@@ -1747,26 +2017,26 @@ void lar::sparse_vector<T>::resize(size_type new_size, value_type def_value) {
 } // lar::sparse_vector<T>::resize()
 
 
-template <typename T>
-inline typename lar::sparse_vector<T>::iterator lar::sparse_vector<T>::begin()
+template <typename T, typename A>
+inline typename lar::sparse_vector<T, A>::iterator lar::sparse_vector<T, A>::begin()
   { return iterator(*this, typename iterator::special::begin()); }
 
-template <typename T>
-inline typename lar::sparse_vector<T>::iterator lar::sparse_vector<T>::end()
+template <typename T, typename A>
+inline typename lar::sparse_vector<T, A>::iterator lar::sparse_vector<T, A>::end()
   { return iterator(*this, typename iterator::special::end()); }
 
-template <typename T>
-inline typename lar::sparse_vector<T>::const_iterator
-  lar::sparse_vector<T>::begin() const
+template <typename T, typename A>
+inline typename lar::sparse_vector<T, A>::const_iterator
+  lar::sparse_vector<T, A>::begin() const
   { return const_iterator(*this, typename const_iterator::special::begin()); }
 
-template <typename T>
-inline typename lar::sparse_vector<T>::const_iterator
-  lar::sparse_vector<T>::end() const
+template <typename T, typename A>
+inline typename lar::sparse_vector<T, A>::const_iterator
+  lar::sparse_vector<T, A>::end() const
   { return const_iterator(*this, typename const_iterator::special::end()); }
 
-template <typename T>
-typename lar::sparse_vector<T>::value_type lar::sparse_vector<T>::operator[]
+template <typename T, typename A>
+typename lar::sparse_vector<T, A>::value_type lar::sparse_vector<T, A>::operator[]
   (size_type index) const
 {
   // first range not including the index
@@ -1784,8 +2054,8 @@ typename lar::sparse_vector<T>::value_type lar::sparse_vector<T>::operator[]
 } // lar::sparse_vector<T>::operator[]
 
 
-template <typename T>
-typename lar::sparse_vector<T>::reference lar::sparse_vector<T>::operator[]
+template <typename T, typename A>
+typename lar::sparse_vector<T, A>::reference lar::sparse_vector<T, A>::operator[]
   (size_type index)
 {
   // first range not including the index
@@ -1803,8 +2073,8 @@ typename lar::sparse_vector<T>::reference lar::sparse_vector<T>::operator[]
 } // lar::sparse_vector<T>::operator[]
 
 
-template <typename T>
-bool lar::sparse_vector<T>::is_void(size_type index) const {
+template <typename T, typename A>
+bool lar::sparse_vector<T, A>::is_void(size_type index) const {
   if (ranges.empty() || (index >= size()))
     throw std::out_of_range("empty sparse vector");
   // range after the index:
@@ -1814,8 +2084,8 @@ bool lar::sparse_vector<T>::is_void(size_type index) const {
 } // lar::sparse_vector<T>::is_void()
 
 
-template <typename T>
-inline typename lar::sparse_vector<T>::size_type lar::sparse_vector<T>::count()
+template <typename T, typename A>
+inline typename lar::sparse_vector<T, A>::size_type lar::sparse_vector<T, A>::count()
   const
 {
   return std::accumulate(begin_range(), end_range(), size_type(0),
@@ -1824,8 +2094,8 @@ inline typename lar::sparse_vector<T>::size_type lar::sparse_vector<T>::count()
 } // count()
 
 
-template <typename T>
-typename lar::sparse_vector<T>::value_type& lar::sparse_vector<T>::set_at
+template <typename T, typename A>
+typename lar::sparse_vector<T, A>::value_type& lar::sparse_vector<T, A>::set_at
   (size_type const index, value_type value)
 {
   // first range not including the index
@@ -1842,12 +2112,13 @@ typename lar::sparse_vector<T>::value_type& lar::sparse_vector<T>::set_at
     if (index < range.end_index()) return range[index] = value;
   }
   // so we are in the void; add the value as a new range
-  return const_cast<datarange_t&>(add_range(index, { value }))[index];
+  return const_cast<datarange_t&>
+    (add_range(index, vector_t({ value }, get_allocator())))[index];
 } // lar::sparse_vector<T>::set_at()
 
 
-template <typename T>
-void lar::sparse_vector<T>::unset_at(size_type index) {
+template <typename T, typename A>
+void lar::sparse_vector<T, A>::unset_at(size_type index) {
   // first range not including the index
   range_iterator iNextRange = find_next_range_iter(index);
 
@@ -1883,18 +2154,18 @@ void lar::sparse_vector<T>::unset_at(size_type index) {
 } // lar::sparse_vector<T>::unset_at()
 
 
-template <typename T>
-auto lar::sparse_vector<T>::range_data(std::size_t const i)
+template <typename T, typename A>
+auto lar::sparse_vector<T, A>::range_data(std::size_t const i)
   { auto& r = ranges[i]; return details::iteratorRange(r.begin(), r.end()); }
 
-template <typename T>
-auto lar::sparse_vector<T>::range_const_data(std::size_t const i) const
+template <typename T, typename A>
+auto lar::sparse_vector<T, A>::range_const_data(std::size_t const i) const
   { auto& r = ranges[i]; return details::iteratorRange(r.cbegin(), r.cend()); }
 
 
-template <typename T>
-typename lar::sparse_vector<T>::range_const_iterator
-  lar::sparse_vector<T>::find_range_iterator(size_type index) const
+template <typename T, typename A>
+typename lar::sparse_vector<T, A>::range_const_iterator
+  lar::sparse_vector<T, A>::find_range_iterator(size_type index) const
 {
   if (ranges.empty()) throw std::out_of_range("empty sparse vector");
   // range after the index:
@@ -1905,9 +2176,9 @@ typename lar::sparse_vector<T>::range_const_iterator
 } // lar::sparse_vector<T>::find_range_iterator() const
 
 
-template <typename T>
-const typename lar::sparse_vector<T>::datarange_t&
-  lar::sparse_vector<T>::find_range(size_type index) const
+template <typename T, typename A>
+const typename lar::sparse_vector<T, A>::datarange_t&
+  lar::sparse_vector<T, A>::find_range(size_type index) const
 {
   if (ranges.empty()) throw std::out_of_range("empty sparse vector");
   // range on the index:
@@ -1917,17 +2188,22 @@ const typename lar::sparse_vector<T>::datarange_t&
   return *iNextRange;
 } // lar::sparse_vector<T>::find_range() const
 
-template <typename T>
-inline typename lar::sparse_vector<T>::datarange_t&
-  lar::sparse_vector<T>::find_range(size_type index)
+template <typename T, typename A>
+inline typename lar::sparse_vector<T, A>::datarange_t&
+  lar::sparse_vector<T, A>::find_range(size_type index)
 {
   return const_cast<datarange_t&>
     (const_cast<const this_t*>(this)->find_range(index));
 } // lar::sparse_vector<T>::find_range()
 
 
-template <typename T>
-auto lar::sparse_vector<T>::make_void_around(size_type index) -> datarange_t {
+template <typename T, typename A>
+inline auto lar::sparse_vector<T, A>::make_cursor() const -> cursor
+  { return cursor(*this); }
+
+
+template <typename T, typename A>
+auto lar::sparse_vector<T, A>::make_void_around(size_type index) -> datarange_t {
   if (ranges.empty() || (index >= size()))
     throw std::out_of_range("empty sparse vector");
   // range after the index:
@@ -1941,8 +2217,8 @@ auto lar::sparse_vector<T>::make_void_around(size_type index) -> datarange_t {
 } // lar::sparse_vector<T>::make_void_around()
 
 
-template <typename T> template <typename ITER>
-const typename lar::sparse_vector<T>::datarange_t& lar::sparse_vector<T>::add_range
+template <typename T, typename A> template <typename ITER>
+const typename lar::sparse_vector<T, A>::datarange_t& lar::sparse_vector<T, A>::add_range
   (size_type offset, ITER first, ITER last)
 {
   // insert the new range before the existing range which starts after offset
@@ -1956,14 +2232,14 @@ const typename lar::sparse_vector<T>::datarange_t& lar::sparse_vector<T>::add_ra
   else {
     // no range before the insertion one includes the offset of the new range;
     // ... we need to add it as a new range
-    iInsert = insert_range(iInsert, { offset, first, last });
+    iInsert = insert_range(iInsert, { offset, first, last, get_allocator() });
   }
   return merge_ranges(iInsert);
 } // lar::sparse_vector<T>::add_range<ITER>()
 
 
-template <typename T>
-const typename lar::sparse_vector<T>::datarange_t& lar::sparse_vector<T>::add_range
+template <typename T, typename A>
+const typename lar::sparse_vector<T, A>::datarange_t& lar::sparse_vector<T, A>::add_range
   (size_type offset, vector_t&& new_data)
 {
   // insert the new range before the existing range which starts after offset
@@ -1977,9 +2253,9 @@ const typename lar::sparse_vector<T>::datarange_t& lar::sparse_vector<T>::add_ra
 } // lar::sparse_vector<T>::add_range(vector)
 
 
-template <typename T>
+template <typename T, typename A>
 template <typename ITER, typename OP>
-auto lar::sparse_vector<T>::combine_range(
+auto lar::sparse_vector<T, A>::combine_range(
   size_type offset, ITER first, ITER last, OP&& op,
   value_type void_value /* = value_zero */
   )
@@ -2035,7 +2311,7 @@ auto lar::sparse_vector<T>::combine_range(
       ? std::distance(src, last): (destRange->begin_index() - offset);
 
     // prepare the data (we'll plug it in directly)
-    vector_t combinedData;
+    vector_t combinedData(get_allocator());
     combinedData.reserve(newRangeSize);
     size_type i = 0;
     while (i++ < newRangeSize) {
@@ -2065,8 +2341,8 @@ auto lar::sparse_vector<T>::combine_range(
 } // lar::sparse_vector<T>::combine_range<ITER>()
 
 
-template <typename T>
-void lar::sparse_vector<T>::make_void(iterator first, iterator last) {
+template <typename T, typename A>
+void lar::sparse_vector<T, A>::make_void(iterator first, iterator last) {
   // iterators have in "currentRange" either the range they point into,
   // or the range next to the void they point to
 
@@ -2114,16 +2390,16 @@ void lar::sparse_vector<T>::make_void(iterator first, iterator last) {
 } // lar::sparse_vector<T>::make_void()
 
 
-template <typename T>
-auto lar::sparse_vector<T>::void_range(range_iterator iRange) -> datarange_t {
+template <typename T, typename A>
+auto lar::sparse_vector<T, A>::void_range(range_iterator iRange) -> datarange_t {
   auto r { std::move(*iRange) }; // triggering move constructor
   ranges.erase(iRange);          // the emptied range is removed from vector
   return r;                      // returning it as a temporary avoids copies
 } // lar::sparse_vector<T>::void_range()
 
 
-template <typename T>
-bool lar::sparse_vector<T>::is_valid() const {
+template <typename T, typename A>
+bool lar::sparse_vector<T, A>::is_valid() const {
   // a sparse vector with no non-null elements can't be detected invalid
   if (ranges.empty()) return true;
 
@@ -2144,9 +2420,9 @@ bool lar::sparse_vector<T>::is_valid() const {
 
 // --- private methods
 
-template <typename T>
-typename lar::sparse_vector<T>::range_iterator
-  lar::sparse_vector<T>::find_next_range_iter
+template <typename T, typename A>
+typename lar::sparse_vector<T, A>::range_iterator
+  lar::sparse_vector<T, A>::find_next_range_iter
   (size_type index, range_iterator rbegin)
 {
   // this range has the offset (first index) above the index argument:
@@ -2156,9 +2432,9 @@ typename lar::sparse_vector<T>::range_iterator
     );
 } // lar::sparse_vector<T>::find_next_range_iter()
 
-template <typename T>
-typename lar::sparse_vector<T>::range_const_iterator
-  lar::sparse_vector<T>::find_next_range_iter
+template <typename T, typename A>
+typename lar::sparse_vector<T, A>::range_const_iterator
+  lar::sparse_vector<T, A>::find_next_range_iter
   (size_type index, range_const_iterator rbegin) const
 {
   // this range has the offset (first index) above the index argument:
@@ -2169,9 +2445,9 @@ typename lar::sparse_vector<T>::range_const_iterator
 } // lar::sparse_vector<T>::find_next_range_iter() const
 
 
-template <typename T>
-typename lar::sparse_vector<T>::range_const_iterator
-  lar::sparse_vector<T>::find_range_iter_at_or_after(size_type index) const
+template <typename T, typename A>
+typename lar::sparse_vector<T, A>::range_const_iterator
+  lar::sparse_vector<T, A>::find_range_iter_at_or_after(size_type index) const
 {
   // this range has the offset (first index) above the index argument:
   auto after = find_next_range_iter(index);
@@ -2181,9 +2457,9 @@ typename lar::sparse_vector<T>::range_const_iterator
 } // lar::sparse_vector<T>::find_range_iter_at_or_after() const
 
 
-template <typename T>
-typename lar::sparse_vector<T>::range_iterator
-  lar::sparse_vector<T>::find_range_iter_at_or_after(size_type index)
+template <typename T, typename A>
+typename lar::sparse_vector<T, A>::range_iterator
+  lar::sparse_vector<T, A>::find_range_iter_at_or_after(size_type index)
 {
   // this range has the offset (first index) above the index argument:
   auto after = find_next_range_iter(index);
@@ -2193,9 +2469,9 @@ typename lar::sparse_vector<T>::range_iterator
 } // lar::sparse_vector<T>::find_range_iter_at_or_after()
 
 
-template <typename T>
-typename lar::sparse_vector<T>::range_iterator
-  lar::sparse_vector<T>::find_extending_range_iter
+template <typename T, typename A>
+typename lar::sparse_vector<T, A>::range_iterator
+  lar::sparse_vector<T, A>::find_extending_range_iter
   (size_type index, range_iterator rbegin)
 {
   // this range has the offset (first index) above the index argument:
@@ -2206,9 +2482,9 @@ typename lar::sparse_vector<T>::range_iterator
 } // lar::sparse_vector<T>::find_extending_range_iter()
 
 
-template <typename T>
-typename lar::sparse_vector<T>::range_const_iterator
-  lar::sparse_vector<T>::find_extending_range_iter
+template <typename T, typename A>
+typename lar::sparse_vector<T, A>::range_const_iterator
+  lar::sparse_vector<T, A>::find_extending_range_iter
   (size_type index, range_const_iterator rbegin) const
 {
   // this range has the offset (first index) above the index argument:
@@ -2219,8 +2495,8 @@ typename lar::sparse_vector<T>::range_const_iterator
 } // lar::sparse_vector<T>::find_extending_range_iter() const
 
 
-template <typename T>
-const typename lar::sparse_vector<T>::datarange_t& lar::sparse_vector<T>::add_range_before
+template <typename T, typename A>
+const typename lar::sparse_vector<T, A>::datarange_t& lar::sparse_vector<T, A>::add_range_before
   (size_type offset, vector_t&& new_data, range_iterator nextRange)
 {
   // insert the new range before the existing range which starts after offset
@@ -2243,8 +2519,8 @@ const typename lar::sparse_vector<T>::datarange_t& lar::sparse_vector<T>::add_ra
 } // lar::sparse_vector<T>::add_range_before(vector, iterator)
 
 
-template <typename T>
-typename lar::sparse_vector<T>::datarange_t& lar::sparse_vector<T>::merge_ranges
+template <typename T, typename A>
+typename lar::sparse_vector<T, A>::datarange_t& lar::sparse_vector<T, A>::merge_ranges
   (range_iterator iRange)
 {
   range_iterator iNext = iRange + 1;
@@ -2263,8 +2539,8 @@ typename lar::sparse_vector<T>::datarange_t& lar::sparse_vector<T>::merge_ranges
 } // lar::sparse_vector<T>::merge_ranges()
 
 
-template <typename T>
-typename lar::sparse_vector<T>::range_iterator lar::sparse_vector<T>::eat_range_head
+template <typename T, typename A>
+typename lar::sparse_vector<T, A>::range_iterator lar::sparse_vector<T, A>::eat_range_head
   (range_iterator iRange, size_t index)
 {
   if (index <= iRange->begin_index()) return iRange;
@@ -2274,8 +2550,8 @@ typename lar::sparse_vector<T>::range_iterator lar::sparse_vector<T>::eat_range_
 } // lar::sparse_vector<T>::eat_range_head()
 
 
-template <typename T>
-typename lar::sparse_vector<T>::size_type lar::sparse_vector<T>::fix_size() {
+template <typename T, typename A>
+typename lar::sparse_vector<T, A>::size_type lar::sparse_vector<T, A>::fix_size() {
   if (!ranges.empty())
     nominal_size = std::max(nominal_size, ranges.back().end_index());
   return nominal_size;
@@ -2284,8 +2560,8 @@ typename lar::sparse_vector<T>::size_type lar::sparse_vector<T>::fix_size() {
 
 // --- static methods
 
-template <typename T>
-inline size_t lar::sparse_vector<T>::expected_vector_size(size_t size) {
+template <typename T, typename A>
+inline size_t lar::sparse_vector<T, A>::expected_vector_size(size_t size) {
   // apparently, a chunk of heap memory takes at least 32 bytes;
   // that means that a vector of 1 or 5 32-bit integers takes the same
   // space; the overhead appears to be 8 bytes, which can be allocated
@@ -2294,8 +2570,8 @@ inline size_t lar::sparse_vector<T>::expected_vector_size(size_t size) {
 } // lar::sparse_vector<T>::expected_vector_size()
 
 
-template <typename T>
-inline size_t lar::sparse_vector<T>::min_gap() {
+template <typename T, typename A>
+inline size_t lar::sparse_vector<T, A>::min_gap() {
   // we assume here that there is no additional overhead by alignment;
   // the gap adds the space of another datarange_t, including the vector,
   // its data and overhead from heap (apparently, 8 bytes);
@@ -2304,8 +2580,8 @@ inline size_t lar::sparse_vector<T>::min_gap() {
 } // lar::sparse_vector<T>::min_gap()
 
 
-template <typename T>
-inline bool lar::sparse_vector<T>::should_merge(
+template <typename T, typename A>
+inline bool lar::sparse_vector<T, A>::should_merge(
   const typename datarange_t::base_t& a,
   const typename datarange_t::base_t& b
   )
@@ -2319,13 +2595,93 @@ inline bool lar::sparse_vector<T>::should_merge(
 
 
 
+// --- construction from dense data
+
+template <typename T, typename A>
+template <typename ITER>
+lar::sparse_vector<T, A> lar::sparse_vector<T, A>::from_dense(
+  ITER first, ITER last, value_type thr, size_type padding,
+  allocator_type const& alloc
+) {
+  auto selected = [first, thr](size_type i)
+    { return !(abs(first[i] - value_zero) <= thr); };
+  return from_dense_impl(first, last, selected, padding, alloc);
+} // lar::sparse_vector<T>::from_dense()
+
+
+template <typename T, typename A>
+template <typename ITER, typename MITER>
+lar::sparse_vector<T, A> lar::sparse_vector<T, A>::from_dense_mask(
+  ITER first, ITER last, MITER mask, size_type padding,
+  allocator_type const& alloc
+) {
+  auto selected = [mask](size_type i){ return static_cast<bool>(mask[i]); };
+  return from_dense_impl(first, last, selected, padding, alloc);
+} // lar::sparse_vector<T>::from_dense_mask()
+
+
+template <typename T, typename A>
+template <typename ITER, typename PRED>
+lar::sparse_vector<T, A> lar::sparse_vector<T, A>::from_dense_impl(
+  ITER first, ITER last, PRED selected, size_type padding,
+  allocator_type const& alloc
+) {
+  size_type const n = std::distance(first, last);
+
+  // first pass: find all the range boundaries, padded and merged
+  std::vector<range_t<size_type>> bounds;
+  size_type index = find_selection(selected, true, 0, n);
+  while (index < n) {
+    size_type const end = find_selection(selected, false, index + 1, n);
+    size_type const padded_begin = (index > padding)? index - padding: 0;
+    size_type const padded_end = (n - end > padding)? end + padding: n;
+    if (!bounds.empty() && (padded_begin <= bounds.back().end_index()))
+      bounds.back().set(bounds.back().begin_index(), padded_end);
+    else
+      bounds.emplace_back(padded_begin, padded_end);
+    index = find_selection(selected, true, end, n);
+  } // while
+
+  // second pass: one allocation per range
+  sparse_vector result(alloc);
+  result.ranges.reserve(bounds.size());
+  for (range_t<size_type> const& range: bounds) {
+    result.ranges.emplace_back(range.begin_index(),
+      first + range.begin_index(), first + range.end_index());
+  }
+  result.nominal_size = n;
+  return result;
+} // lar::sparse_vector<T>::from_dense_impl()
+
+
+template <typename T, typename A>
+template <typename PRED>
+auto lar::sparse_vector<T, A>::find_selection
+  (PRED& selected, bool sel, size_type from, size_type to) -> size_type
+{
+  constexpr size_type block_size = 16;
+
+  // skip whole blocks without any match
+  while (to - from >= block_size) {
+    bool found = false;
+    for (size_type i = from; i < from + block_size; ++i)
+      found |= (selected(i) == sel);
+    if (found) break;
+    from += block_size;
+  } // while
+  while ((from < to) && (selected(from) != sel)) ++from;
+  return from;
+} // lar::sparse_vector<T>::find_selection()
+
+
+
 // --- non-member functions
-template <typename T>
-std::ostream& operator<< (std::ostream& out, const lar::sparse_vector<T>& v) {
+template <typename T, typename A>
+std::ostream& operator<< (std::ostream& out, const lar::sparse_vector<T, A>& v) {
 
   out << "Sparse vector of size " << v.size() << " with "
     << v.get_ranges().size() << " ranges:";
-  typename lar::sparse_vector<T>::range_const_iterator
+  typename lar::sparse_vector<T, A>::range_const_iterator
     iRange = v.begin_range(), rend = v.end_range();
   while (iRange != rend) {
     out << "\n  ";
@@ -2333,7 +2689,7 @@ std::ostream& operator<< (std::ostream& out, const lar::sparse_vector<T>& v) {
     /*
     out << "\n  [" << iRange->begin_index() << " - " << iRange->end_index()
       << "] (" << iRange->size() << "):";
-    typename lar::sparse_vector<T>::datarange_t::const_iterator
+    typename lar::sparse_vector<T, A>::datarange_t::const_iterator
       iValue = iRange->begin(), vend = iRange->end();
     while (iValue != vend) out << " " << (*(iValue++));
     */
@@ -2347,8 +2703,8 @@ std::ostream& operator<< (std::ostream& out, const lar::sparse_vector<T>& v) {
 // -----------------------------------------------------------------------------
 // --- lar::sparse_vector<T>::datarange_t implementation
 // ---
-template <typename T> template <typename ITER>
-typename lar::sparse_vector<T>::datarange_t& lar::sparse_vector<T>::datarange_t::extend
+template <typename T, typename A> template <typename ITER>
+typename lar::sparse_vector<T, A>::datarange_t& lar::sparse_vector<T, A>::datarange_t::extend
   (size_type index, ITER first, ITER last)
 {
   size_type new_size = std::max(
@@ -2361,8 +2717,8 @@ typename lar::sparse_vector<T>::datarange_t& lar::sparse_vector<T>::datarange_t:
 } // lar::sparse_vector<T>::datarange_t::extend()
 
 
-template <typename T>
-void lar::sparse_vector<T>::datarange_t::move_head
+template <typename T, typename A>
+void lar::sparse_vector<T, A>::datarange_t::move_head
   (size_type to_index, value_type def_value /* = value_zero */)
 {
   difference_type delta = to_index - base_t::begin_index();
@@ -2379,9 +2735,9 @@ void lar::sparse_vector<T>::datarange_t::move_head
 } // lar::sparse_vector<T>::datarange_t::move_head()
 
 
-template <typename T>
+template <typename T, typename A>
 template <typename Stream>
-void lar::sparse_vector<T>::datarange_t::dump(Stream&& out) const {
+void lar::sparse_vector<T, A>::datarange_t::dump(Stream&& out) const {
   out << "[" << this->begin_index() << " - " << this->end_index() << "] ("
     << this->size() << "): {";
   for (auto const& v: this->values) out << " " << v;
@@ -2389,12 +2745,94 @@ void lar::sparse_vector<T>::datarange_t::dump(Stream&& out) const {
 } // lar::sparse_vector<T>::datarange_t::dump()
 
 
+// -----------------------------------------------------------------------------
+// --- lar::sparse_vector<T>::cursor implementation
+// ---
+template <typename T, typename A>
+auto lar::sparse_vector<T, A>::cursor::find_next_range_iter(size_type index)
+  -> range_const_iterator
+{
+  auto const& ranges = cont->ranges;
+  std::size_t const n = ranges.size();
+
+  // the answer is the first range with offset larger than index;
+  // the previous answer, `next`, brackets the search from one side
+  std::size_t lower, upper; // answer is in ]lower, upper]
+  if ((next < n) && (range_offset(next) <= index)) {
+    // gallop forward
+    std::size_t step = 1;
+    lower = next;
+    while ((lower + step < n) && (range_offset(lower + step) <= index)) {
+      lower += step;
+      step *= 2;
+    }
+    upper = std::min(lower + step, n);
+  }
+  else if ((next > 0) && (range_offset(next - 1) > index)) {
+    // gallop backward
+    std::size_t step = 1;
+    upper = next - 1;
+    while ((upper >= step) && (range_offset(upper - step) > index)) {
+      upper -= step;
+      step *= 2;
+    }
+    if (upper < step) { // no range before upper has been tested yet
+      next = std::upper_bound(
+        ranges.begin(), ranges.begin() + upper, index,
+        typename datarange_t::less_int_range(datarange_t::less)
+        ) - ranges.begin();
+      return ranges.begin() + next;
+    }
+    lower = upper - step;
+  }
+  else return ranges.begin() + next; // same spot as the last query
+
+  next = std::upper_bound(
+    ranges.begin() + lower + 1, ranges.begin() + upper, index,
+    typename datarange_t::less_int_range(datarange_t::less)
+    ) - ranges.begin();
+  return ranges.begin() + next;
+} // lar::sparse_vector<T>::cursor::find_next_range_iter()
+
+
+template <typename T, typename A>
+auto lar::sparse_vector<T, A>::cursor::operator[] (size_type index) -> value_type
+{
+  range_const_iterator iNextRange = find_next_range_iter(index);
+  if (iNextRange == cont->ranges.begin()) return value_zero;
+  const datarange_t& range(*--iNextRange);
+  return (index < range.end_index())? range[index]: value_zero;
+} // lar::sparse_vector<T>::cursor::operator[]
+
+
+template <typename T, typename A>
+bool lar::sparse_vector<T, A>::cursor::is_void(size_type index) {
+  if (cont->ranges.empty() || (index >= cont->size()))
+    throw std::out_of_range("empty sparse vector");
+  range_const_iterator iNextRange = find_next_range_iter(index);
+  return ((iNextRange == cont->ranges.begin())
+    || ((--iNextRange)->end_index() <= index));
+} // lar::sparse_vector<T>::cursor::is_void()
+
+
+template <typename T, typename A>
+auto lar::sparse_vector<T, A>::cursor::find_range_iterator(size_type index)
+  -> range_const_iterator
+{
+  if (cont->ranges.empty()) throw std::out_of_range("empty sparse vector");
+  range_const_iterator iNextRange = find_next_range_iter(index);
+  return ((iNextRange == cont->ranges.begin())
+    || (index >= (--iNextRange)->end_index()))?
+    cont->ranges.end(): iNextRange;
+} // lar::sparse_vector<T>::cursor::find_range_iterator()
+
+
 // -----------------------------------------------------------------------------
 // --- lar::sparse_vector<T>::const_iterator implementation
 // ---
-template <typename T>
-typename lar::sparse_vector<T>::const_iterator&
-lar::sparse_vector<T>::const_iterator::operator++() {
+template <typename T, typename A>
+typename lar::sparse_vector<T, A>::const_iterator&
+lar::sparse_vector<T, A>::const_iterator::operator++() {
   // no container, not doing anything;
   // index beyond the end: stays there
   if (!cont || (index >= cont->size())) return *this;
@@ -2412,9 +2850,9 @@ lar::sparse_vector<T>::const_iterator::operator++() {
 } // lar::sparse_vector<T>::iterator::operator++()
 
 
-template <typename T>
-typename lar::sparse_vector<T>::const_iterator::const_reference
-lar::sparse_vector<T>::const_iterator::operator*() const {
+template <typename T, typename A>
+typename lar::sparse_vector<T, A>::const_iterator::const_reference
+lar::sparse_vector<T, A>::const_iterator::operator*() const {
   // no container, no idea what to do
   if (!cont) throw std::out_of_range("iterator to no sparse vector");
 
@@ -2431,9 +2869,9 @@ lar::sparse_vector<T>::const_iterator::operator*() const {
 } // lar::sparse_vector<T>::const_iterator::operator*()
 
 
-template <typename T>
-typename lar::sparse_vector<T>::const_iterator&
-  lar::sparse_vector<T>::const_iterator::operator+= (difference_type delta)
+template <typename T, typename A>
+typename lar::sparse_vector<T, A>::const_iterator&
+  lar::sparse_vector<T, A>::const_iterator::operator+= (difference_type delta)
 {
   if (delta == 1) return this->operator++();
   index += delta;
@@ -2444,15 +2882,15 @@ typename lar::sparse_vector<T>::const_iterator&
   return *this;
 } // lar::sparse_vector<T>::const_iterator::operator+=()
 
-template <typename T>
-inline typename lar::sparse_vector<T>::const_iterator&
-  lar::sparse_vector<T>::const_iterator::operator-= (difference_type delta)
+template <typename T, typename A>
+inline typename lar::sparse_vector<T, A>::const_iterator&
+  lar::sparse_vector<T, A>::const_iterator::operator-= (difference_type delta)
   { return this->operator+= (-delta); }
 
 
-template <typename T>
-typename lar::sparse_vector<T>::const_iterator
-  lar::sparse_vector<T>::const_iterator::operator+ (difference_type delta) const
+template <typename T, typename A>
+typename lar::sparse_vector<T, A>::const_iterator
+  lar::sparse_vector<T, A>::const_iterator::operator+ (difference_type delta) const
 {
   if ((currentRange == cont->ranges.end())
     || !currentRange->includes(index + delta)
@@ -2463,16 +2901,16 @@ typename lar::sparse_vector<T>::const_iterator
   return iter;
 } // lar::sparse_vector<T>::const_iterator::operator+()
 
-template <typename T>
-inline typename lar::sparse_vector<T>::const_iterator
-  lar::sparse_vector<T>::const_iterator::operator- (difference_type delta) const
+template <typename T, typename A>
+inline typename lar::sparse_vector<T, A>::const_iterator
+  lar::sparse_vector<T, A>::const_iterator::operator- (difference_type delta) const
   { return this->operator+ (-delta); }
 
 
 /// distance operator
-template <typename T>
-inline typename lar::sparse_vector<T>::const_iterator::difference_type
-  lar::sparse_vector<T>::const_iterator::operator-
+template <typename T, typename A>
+inline typename lar::sparse_vector<T, A>::const_iterator::difference_type
+  lar::sparse_vector<T, A>::const_iterator::operator-
   (const const_iterator& iter) const
 {
   if (cont != iter.cont) {
@@ -2483,8 +2921,8 @@ inline typename lar::sparse_vector<T>::const_iterator::difference_type
 } // lar::sparse_vector<T>::const_iterator::operator-(const_iterator)
 
 
-template <typename T>
-void lar::sparse_vector<T>::const_iterator::refresh_state() {
+template <typename T, typename A>
+void lar::sparse_vector<T, A>::const_iterator::refresh_state() {
   // update the currentRange
   // currentRange is the range including the current item, or next to it
   if (cont) {
@@ -0,0 +1,156 @@
+/**
+ * @file    MVAOutputBatch_test.cc
+ * @brief   Test of the batch operations on anab::FeatureVector collections
+ *
+ * This test verifies the tie breaking of anab::argmax(), the handling of null
+ * sums in anab::normalize(), and the construction of feature vectors from
+ * float and double buffers with different strides.
+ *
+ * See http://www.boost.org/libs/test for the Boost test library home page.
+ */
+
+// C/C++ standard library
+#include <array>
+#include <cstddef> // std::size_t
+#include <vector>
+
+
+// Boost libraries
+#define BOOST_TEST_MODULE ( mvaoutputbatch_test )
+#include "boost/test/unit_test.hpp"
+
+// LArSoft libraries
+#include "lardataobj/AnalysisBase/MVAOutputBatch.h"
+
+// framework libraries
+#include "cetlib_except/exception.h"
+
+
+
+//------------------------------------------------------------------------------
+//--- Test code
+//
+
+template <std::size_t N>
+void CheckVector
+  (anab::FeatureVector<N> const& vector, std::array<float, N> const& expected)
+{
+  for (std::size_t j = 0; j < N; ++j) {
+    BOOST_TEST_CONTEXT("element #" << j) {
+      BOOST_TEST(vector[j] == expected[j]);
+    }
+  }
+} // CheckVector()
+
+
+void ArgmaxTest() {
+
+  std::vector<anab::FeatureVector<3>> const vectors {
+    std::array<float, 3>{ 0.0f, 1.0f, 2.0f },
+    std::array<float, 3>{ 1.0f, 3.0f, 3.0f }, // tie: the first one wins
+    std::array<float, 3>{ 5.0f, 5.0f, 5.0f },
+    std::array<float, 3>{ -1.0f, -3.0f, -1.0f }
+  };
+
+  std::vector<std::size_t> const expected { 2U, 1U, 0U, 0U };
+  BOOST_TEST(anab::argmax(vectors) == expected, boost::test_tools::per_element());
+
+  BOOST_TEST(anab::argmax(std::vector<anab::FeatureVector<3>>{}).empty());
+
+} // ArgmaxTest()
+
+
+void NormalizeTest() {
+
+  std::vector<anab::FeatureVector<3>> const vectors {
+    std::array<float, 3>{ 1.0f, 1.0f, 2.0f },
+    std::array<float, 3>{ 1.0f, -1.0f, 0.0f }, // null sum: unchanged
+    std::array<float, 3>{ 0.0f, 0.0f, 0.0f }   // null sum: unchanged
+  };
+
+  std::vector<anab::FeatureVector<3>> const normalized
+    = anab::normalize(vectors);
+  BOOST_TEST_REQUIRE(normalized.size() == vectors.size());
+  CheckVector(normalized[0], { 0.25f, 0.25f, 0.5f });
+  CheckVector(normalized[1], { 1.0f, -1.0f, 0.0f });
+  CheckVector(normalized[2], { 0.0f, 0.0f, 0.0f });
+
+} // NormalizeTest()
+
+
+void FloatBufferTest() {
+
+  // packed buffer (stride N)
+  float const packed[] = { 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f };
+  std::vector<anab::FeatureVector<3>> vectors
+    = anab::makeFeatureVectors<3>(packed, 2);
+  BOOST_TEST_REQUIRE(vectors.size() == 2U);
+  CheckVector(vectors[0], { 1.0f, 2.0f, 3.0f });
+  CheckVector(vectors[1], { 4.0f, 5.0f, 6.0f });
+
+  // padded buffer (stride larger than N), appended after the existing ones
+  float const padded[] = { 7.0f, 8.0f, 9.0f, -1.0f, 10.0f, 11.0f, 12.0f, -1.0f };
+  anab::appendFeatureVectors<3>(vectors, padded, 2, 4);
+  BOOST_TEST_REQUIRE(vectors.size() == 4U);
+  CheckVector(vectors[0], { 1.0f, 2.0f, 3.0f });
+  CheckVector(vectors[2], { 7.0f, 8.0f, 9.0f });
+  CheckVector(vectors[3], { 10.0f, 11.0f, 12.0f });
+
+  // nothing to append
+  anab::appendFeatureVectors<3>(vectors, padded, 0, 4);
+  BOOST_TEST(vectors.size() == 4U);
+
+  // stride smaller than N is rejected
+  BOOST_CHECK_THROW
+    (anab::appendFeatureVectors<3>(vectors, packed, 2, 2), cet::exception);
+  BOOST_CHECK_THROW
+    (anab::makeFeatureVectors<3>(packed, 2, 2), cet::exception);
+
+} // FloatBufferTest()
+
+
+void DoubleBufferTest() {
+
+  // packed buffer (stride N)
+  double const packed[] = { 0.5, -1.5, 0.1, 2.0 };
+  std::vector<anab::FeatureVector<2>> vectors
+    = anab::makeFeatureVectors<2>(packed, 2);
+  BOOST_TEST_REQUIRE(vectors.size() == 2U);
+  CheckVector(vectors[0], { 0.5f, -1.5f });
+  CheckVector(vectors[1], { static_cast<float>(0.1), 2.0f });
+
+  // padded buffer (stride larger than N), appended after the existing ones
+  double const padded[] = { 3.0, 4.0, -1.0, 5.0, 6.0, -1.0 };
+  anab::appendFeatureVectors<2>(vectors, padded, 2, 3);
+  BOOST_TEST_REQUIRE(vectors.size() == 4U);
+  CheckVector(vectors[0], { 0.5f, -1.5f });
+  CheckVector(vectors[2], { 3.0f, 4.0f });
+  CheckVector(vectors[3], { 5.0f, 6.0f });
+
+  // stride smaller than N is rejected
+  BOOST_CHECK_THROW
+    (anab::makeFeatureVectors<2>(padded, 2, 1), cet::exception);
+
+} // DoubleBufferTest()
+
+
+
+//------------------------------------------------------------------------------
+//--- registration of tests
+//
+
+BOOST_AUTO_TEST_CASE(Argmax) {
+  ArgmaxTest();
+}
+
+BOOST_AUTO_TEST_CASE(Normalize) {
+  NormalizeTest();
+}
+
+BOOST_AUTO_TEST_CASE(FloatBuffer) {
+  FloatBufferTest();
+}
+
+BOOST_AUTO_TEST_CASE(DoubleBuffer) {
+  DoubleBufferTest();
+}
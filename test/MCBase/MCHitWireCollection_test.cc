@@ -0,0 +1,203 @@
+/**
+ * @file    MCHitWireCollection_test.cc
+ * @brief   Test of the time ordering of sim::MCHitCollection and
+ *          sim::MCWireCollection
+ *
+ * This test fills sim::MCHitCollection and sim::MCWireCollection objects with
+ * many elements with equal time, and verifies that `push_back()` and
+ * `append()` followed by `finalize()` give the same order, that elements with
+ * equal time stay in order of insertion, and the intervals from
+ * `TimeRange()`.
+ *
+ * See http://www.boost.org/libs/test for the Boost test library home page.
+ */
+
+// C/C++ standard library
+#include <algorithm> // std::stable_sort()
+#include <random>
+#include <vector>
+
+
+// Boost libraries
+#define BOOST_TEST_MODULE ( mchitwirecollection_test )
+#include "boost/test/unit_test.hpp"
+
+// LArSoft libraries
+#include "lardataobj/MCBase/MCHitCollection.h"
+#include "lardataobj/MCBase/MCWireCollection.h"
+
+
+
+//------------------------------------------------------------------------------
+//--- Test code
+//
+
+/// Returns a hit with the specified peak time, identified by its track ID.
+sim::MCHit MakeHit(float peakTime, int id) {
+  sim::MCHit hit;
+  hit.SetTime(peakTime, 1.0f);
+  float const vtx[3] = { 0.0f, 0.0f, 0.0f };
+  hit.SetParticleInfo(vtx, 1.0f, id);
+  return hit;
+} // MakeHit()
+
+
+/// Returns a wire with the specified start TDC, identified by its waveform.
+sim::MCWire MakeWire(unsigned int startTDC, int id) {
+  return { startTDC, std::vector<double>{ double(id), 1.0 } };
+} // MakeWire()
+
+
+/// Returns the identifiers of the hits in the collection, in order.
+std::vector<int> HitIDs
+  (sim::MCHitCollection::const_iterator begin, sim::MCHitCollection::const_iterator end)
+{
+  std::vector<int> ids;
+  for (auto it = begin; it != end; ++it) ids.push_back(it->PartTrackId());
+  return ids;
+} // HitIDs()
+
+
+/// Returns the identifiers of the wires in the collection, in order.
+std::vector<int> WireIDs
+  (sim::MCWireCollection::const_iterator begin, sim::MCWireCollection::const_iterator end)
+{
+  std::vector<int> ids;
+  for (auto it = begin; it != end; ++it) ids.push_back(int(it->front()));
+  return ids;
+} // WireIDs()
+
+
+void MCHitCollectionTest() {
+
+  // equal times stay in the order they are added, also when inserted
+  sim::MCHitCollection hits { 3U };
+  hits.push_back(MakeHit(5.0f, 1));
+  hits.push_back(MakeHit(5.0f, 2));
+  hits.push_back(MakeHit(2.0f, 3));
+  hits.push_back(MakeHit(5.0f, 4));
+  hits.push_back(MakeHit(2.0f, 5));
+  hits.push_back(MakeHit(8.0f, 6));
+  hits.push_back(MakeHit(5.0f, 7));
+  BOOST_TEST(hits.Channel() == 3U);
+  BOOST_TEST(HitIDs(hits.begin(), hits.end())
+    == (std::vector<int>{ 3, 5, 1, 2, 4, 7, 6 }),
+    boost::test_tools::per_element());
+
+  // random hits, with many equal times
+  std::mt19937 engine(1U);
+  std::uniform_int_distribution<int> timeDist(0, 30);
+  std::vector<sim::MCHit> randomHits;
+  for (int i = 0; i < 500; ++i)
+    randomHits.push_back(MakeHit(timeDist(engine) * 0.5f, i));
+
+  sim::MCHitCollection pushed, appended;
+  for (sim::MCHit const& hit: randomHits) {
+    pushed.push_back(hit);
+    appended.append(hit);
+  }
+  appended.finalize();
+
+  std::vector<sim::MCHit> expected = randomHits;
+  std::stable_sort(expected.begin(), expected.end());
+  std::vector<int> const expectedIDs = HitIDs(expected.begin(), expected.end());
+  BOOST_TEST(HitIDs(pushed.begin(), pushed.end()) == expectedIDs,
+    boost::test_tools::per_element());
+  BOOST_TEST(HitIDs(appended.begin(), appended.end()) == expectedIDs,
+    boost::test_tools::per_element());
+
+  // finalizing again changes nothing
+  appended.finalize();
+  BOOST_TEST(HitIDs(appended.begin(), appended.end()) == expectedIDs,
+    boost::test_tools::per_element());
+
+  // time ranges are [ start, end [
+  for (float const start: { -1.0f, 0.0f, 2.5f, 3.0f, 7.25f, 15.0f, 16.0f }) {
+    for (float const end: { 0.0f, 2.5f, 3.0f, 10.0f, 15.0f, 15.5f }) {
+      BOOST_TEST_CONTEXT("time interval [ " << start << " ; " << end << " [") {
+        std::vector<int> expectedInRange;
+        for (sim::MCHit const& hit: expected) {
+          if ((hit.PeakTime() >= start) && (hit.PeakTime() < end))
+            expectedInRange.push_back(hit.PartTrackId());
+        }
+        auto const [ first, last ] = pushed.TimeRange(start, end);
+        BOOST_TEST(HitIDs(first, last) == expectedInRange,
+          boost::test_tools::per_element());
+      } // context
+    } // for end
+  } // for start
+
+} // MCHitCollectionTest()
+
+
+void MCWireCollectionTest() {
+
+  // equal start TDCs stay in the order they are added, also when inserted
+  sim::MCWireCollection wires { 4U };
+  wires.push_back(MakeWire(10U, 1));
+  wires.push_back(MakeWire(10U, 2));
+  wires.push_back(MakeWire(4U, 3));
+  wires.push_back(MakeWire(10U, 4));
+  wires.push_back(MakeWire(4U, 5));
+  BOOST_TEST(wires.Channel() == 4U);
+  BOOST_TEST(WireIDs(wires.begin(), wires.end())
+    == (std::vector<int>{ 3, 5, 1, 2, 4 }),
+    boost::test_tools::per_element());
+
+  // random wires, with many equal start TDCs
+  std::mt19937 engine(2U);
+  std::uniform_int_distribution<unsigned int> tdcDist(0, 40);
+  std::vector<sim::MCWire> randomWires;
+  for (int i = 0; i < 300; ++i)
+    randomWires.push_back(MakeWire(tdcDist(engine), i));
+
+  sim::MCWireCollection pushed, appended, moved;
+  for (sim::MCWire const& wire: randomWires) {
+    pushed.push_back(wire);
+    appended.append(wire);
+    moved.append(sim::MCWire{ wire });
+  }
+  appended.finalize();
+  moved.finalize();
+
+  std::vector<sim::MCWire> expected = randomWires;
+  std::stable_sort(expected.begin(), expected.end());
+  std::vector<int> const expectedIDs = WireIDs(expected.begin(), expected.end());
+  BOOST_TEST(WireIDs(pushed.begin(), pushed.end()) == expectedIDs,
+    boost::test_tools::per_element());
+  BOOST_TEST(WireIDs(appended.begin(), appended.end()) == expectedIDs,
+    boost::test_tools::per_element());
+  BOOST_TEST(WireIDs(moved.begin(), moved.end()) == expectedIDs,
+    boost::test_tools::per_element());
+
+  // time ranges are [ start, end [
+  for (unsigned int const start: { 0U, 1U, 10U, 20U, 40U, 41U }) {
+    for (unsigned int const end: { 0U, 10U, 11U, 40U, 41U, 100U }) {
+      BOOST_TEST_CONTEXT("TDC interval [ " << start << " ; " << end << " [") {
+        std::vector<int> expectedInRange;
+        for (sim::MCWire const& wire: expected) {
+          if ((wire.StartTDC() >= start) && (wire.StartTDC() < end))
+            expectedInRange.push_back(int(wire.front()));
+        }
+        auto const [ first, last ] = pushed.TimeRange(start, end);
+        BOOST_TEST(WireIDs(first, last) == expectedInRange,
+          boost::test_tools::per_element());
+      } // context
+    } // for end
+  } // for start
+
+} // MCWireCollectionTest()
+
+
+
+//------------------------------------------------------------------------------
+//--- registration of tests
+//
+
+BOOST_AUTO_TEST_CASE(MCHitCollection) {
+  MCHitCollectionTest();
+}
+
+BOOST_AUTO_TEST_CASE(MCWireCollection) {
+  MCWireCollectionTest();
+}
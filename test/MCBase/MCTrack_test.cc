@@ -0,0 +1,181 @@
+/**
+ * @file    MCTrack_test.cc
+ * @brief   Test of the dQdx matrix of sim::MCTrack and of sim::MCStepLite
+ *
+ * This test fills the dQdx matrix of sim::MCTrack from nested vectors and
+ * from flat values, and verifies its content through the nested vector
+ * accessor and the view. It also verifies the conversion between sim::MCStep
+ * and sim::MCStepLite, including the invalid values.
+ *
+ * See http://www.boost.org/libs/test for the Boost test library home page.
+ */
+
+// C/C++ standard library
+#include <vector>
+
+
+// Boost libraries
+#define BOOST_TEST_MODULE ( mctrack_test )
+#include "boost/test/unit_test.hpp"
+
+// LArSoft libraries
+#include "lardataobj/MCBase/MCTrack.h"
+#include "lardataobj/MCBase/MCStep.h"
+#include "lardataobj/MCBase/MCBaseException.h"
+#include "lardataobj/MCBase/MCLimits.h"
+
+
+
+//------------------------------------------------------------------------------
+//--- Test code
+//
+
+/// Checks the dQdx matrix of `track` against `expected`.
+void CheckdQdx
+  (sim::MCTrack const& track, std::vector<std::vector<double>> const& expected)
+{
+  // nested vector accessor
+  std::vector<std::vector<double>> const nested = track.dQdx();
+  BOOST_TEST_REQUIRE(nested.size() == expected.size());
+  for (std::size_t i = 0; i < expected.size(); ++i) {
+    BOOST_TEST_CONTEXT("row #" << i) {
+      BOOST_TEST(nested.at(i) == expected[i], boost::test_tools::per_element());
+    }
+  }
+
+  // view, with indices
+  sim::MCTrack::dQdxView_t const view = track.dQdxView();
+  BOOST_TEST(view.size() == expected.size());
+  BOOST_TEST(view.empty() == expected.empty());
+  for (std::size_t i = 0; i < expected.size(); ++i) {
+    BOOST_TEST_CONTEXT("row #" << i) {
+      BOOST_TEST(view[i].size() == expected[i].size());
+      for (std::size_t j = 0; j < expected[i].size(); ++j)
+        BOOST_TEST(view[i][j] == expected[i][j]);
+      BOOST_TEST(std::vector<double>(view[i]) == expected[i],
+        boost::test_tools::per_element());
+    }
+  }
+
+  // view, with iteration
+  std::size_t iRow = 0;
+  for (auto const& row: view) {
+    BOOST_TEST_REQUIRE(iRow < expected.size());
+    std::vector<double> values;
+    for (double value: row) values.push_back(value);
+    BOOST_TEST(values == expected[iRow], boost::test_tools::per_element());
+    ++iRow;
+  }
+  BOOST_TEST(iRow == expected.size());
+
+  // conversion of the view
+  std::vector<std::vector<double>> const converted = view;
+  BOOST_TEST_REQUIRE(converted.size() == expected.size());
+  for (std::size_t i = 0; i < expected.size(); ++i)
+    BOOST_TEST(converted[i] == expected[i], boost::test_tools::per_element());
+} // CheckdQdx()
+
+
+void MCTrackdQdxTest() {
+
+  sim::MCTrack track;
+  CheckdQdx(track, {});
+  BOOST_TEST(track.dQdxColumns() == 0U);
+
+  // nested rows: the short ones are padded with 0 (values exact in float)
+  track.dQdx(std::vector<std::vector<double>>{
+    { 1.0, 2.0, 3.0 },
+    { 4.5 },
+    {},
+    { 6.0, -7.25, 8.0 }
+  });
+  BOOST_TEST(track.dQdxColumns() == 3U);
+  BOOST_TEST(track.dQdxValues().size() == 12U);
+  CheckdQdx(track, {
+    { 1.0, 2.0, 3.0 },
+    { 4.5, 0.0, 0.0 },
+    { 0.0, 0.0, 0.0 },
+    { 6.0, -7.25, 8.0 }
+  });
+
+  // flat values, moved in
+  std::vector<float> values { 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f };
+  float const* const buffer = values.data();
+  track.dQdx(std::move(values), 2U);
+  BOOST_TEST(track.dQdxValues().data() == buffer);
+  CheckdQdx(track, { { 1.0, 2.0 }, { 3.0, 4.0 }, { 5.0, 6.0 } });
+
+  // partial rows are rejected, and the matrix is unchanged
+  BOOST_CHECK_THROW(
+    track.dQdx(std::vector<float>{ 1.0f, 2.0f, 3.0f, 4.0f, 5.0f }, 2U),
+    sim::MCBaseException
+    );
+  BOOST_CHECK_THROW
+    (track.dQdx(std::vector<float>{ 1.0f }, 0U), sim::MCBaseException);
+  CheckdQdx(track, { { 1.0, 2.0 }, { 3.0, 4.0 }, { 5.0, 6.0 } });
+
+  // no values, no rows
+  track.dQdx(std::vector<float>{}, 0U);
+  CheckdQdx(track, {});
+
+  // clearing
+  track.dQdx(std::vector<std::vector<double>>{ { 1.0 } });
+  track.Clear();
+  CheckdQdx(track, {});
+
+} // MCTrackdQdxTest()
+
+
+void MCStepLiteTest() {
+
+  // valid values: single precision on position and momentum
+  sim::MCStep const step
+    { TLorentzVector(1.5, -2.0, 3.25, 1.0e9 + 0.5), TLorentzVector(10.0, 20.0, -30.0, 50.0) };
+  sim::MCStepLite const lite { step };
+  BOOST_TEST(lite.X() == 1.5);
+  BOOST_TEST(lite.Y() == -2.0);
+  BOOST_TEST(lite.Z() == 3.25);
+  BOOST_TEST(lite.T() == 1.0e9 + 0.5); // double precision
+  BOOST_TEST(lite.Px() == 10.0);
+  BOOST_TEST(lite.Py() == 20.0);
+  BOOST_TEST(lite.Pz() == -30.0);
+  BOOST_TEST(lite.E() == 50.0);
+
+  sim::MCStep const back = lite.ToMCStep();
+  BOOST_TEST(back.X() == step.X());
+  BOOST_TEST(back.T() == step.T());
+  BOOST_TEST(back.E() == step.E());
+
+  // invalid values: kINVALID_DOUBLE <-> kINVALID_FLOAT
+  TLorentzVector const invalid { sim::kINVALID_DOUBLE, sim::kINVALID_DOUBLE,
+    sim::kINVALID_DOUBLE, sim::kINVALID_DOUBLE };
+  sim::MCStepLite const invalidLite { sim::MCStep{ invalid, invalid } };
+  BOOST_TEST(invalidLite.X() == sim::kINVALID_DOUBLE);
+  BOOST_TEST(invalidLite.Y() == sim::kINVALID_DOUBLE);
+  BOOST_TEST(invalidLite.Z() == sim::kINVALID_DOUBLE);
+  BOOST_TEST(invalidLite.T() == sim::kINVALID_DOUBLE);
+  BOOST_TEST(invalidLite.Px() == sim::kINVALID_DOUBLE);
+  BOOST_TEST(invalidLite.E() == sim::kINVALID_DOUBLE);
+  BOOST_TEST(invalidLite.ToMCStep().Pz() == sim::kINVALID_DOUBLE);
+
+  // default: all invalid
+  sim::MCStepLite const defaultLite;
+  BOOST_TEST(defaultLite.X() == sim::kINVALID_DOUBLE);
+  BOOST_TEST(defaultLite.T() == sim::kINVALID_DOUBLE);
+  BOOST_TEST(defaultLite.Py() == sim::kINVALID_DOUBLE);
+
+} // MCStepLiteTest()
+
+
+
+//------------------------------------------------------------------------------
+//--- registration of tests
+//
+
+BOOST_AUTO_TEST_CASE(MCTrackdQdx) {
+  MCTrackdQdxTest();
+}
+
+BOOST_AUTO_TEST_CASE(MCStepLite) {
+  MCStepLiteTest();
+}
@@ -0,0 +1,122 @@
+/**
+ * @file    SparseMCWire_test.cc
+ * @brief   Test of sim::SparseMCWire
+ *
+ * This test compacts sim::MCWire waveforms with and without threshold, and
+ * verifies the waveform view and the dense wire created back from them.
+ *
+ * See http://www.boost.org/libs/test for the Boost test library home page.
+ */
+
+// C/C++ standard library
+#include <cmath> // std::abs()
+#include <vector>
+
+
+// Boost libraries
+#define BOOST_TEST_MODULE ( sparsemcwire_test )
+#include "boost/test/unit_test.hpp"
+
+// LArSoft libraries
+#include "lardataobj/MCBase/SparseMCWire.h"
+#include "lardataobj/MCBase/MCWire.h"
+#include "lardataobj/MCBase/MCLimits.h"
+
+
+
+//------------------------------------------------------------------------------
+//--- Test code
+//
+
+/// Returns the waveform of `view` as a vector, iterating through it.
+std::vector<double> Iterate(sim::SparseMCWire::WaveformView const& view) {
+  std::vector<double> values;
+  for (double value: view) values.push_back(value);
+  return values;
+} // Iterate()
+
+
+/// Checks `sparse` against the dense waveform `expected` starting at `start`.
+void CheckWire(
+  sim::SparseMCWire const& sparse,
+  unsigned int start, std::vector<double> const& expected
+) {
+  BOOST_TEST(sparse.StartTDC() == start);
+  BOOST_TEST(sparse.Signal().size() == expected.size());
+
+  sim::SparseMCWire::WaveformView const waveform = sparse.Waveform();
+  BOOST_TEST(waveform.size() == expected.size());
+  BOOST_TEST(waveform.empty() == expected.empty());
+  for (std::size_t i = 0; i < expected.size(); ++i) {
+    BOOST_TEST_CONTEXT("sample #" << i) {
+      BOOST_TEST(waveform[i] == expected[i]);
+    }
+  }
+  BOOST_TEST(Iterate(waveform) == expected, boost::test_tools::per_element());
+
+  sim::MCWire const dense = sparse.MakeMCWire();
+  BOOST_TEST(dense.StartTDC() == start);
+  BOOST_TEST(std::vector<double>(dense) == expected,
+    boost::test_tools::per_element());
+} // CheckWire()
+
+
+void SparseMCWireTest() {
+
+  // values exactly represented in single precision
+  std::vector<double> const waveform {
+    0.0, 0.0, 1.5, 3.25, -4.0, 0.0, 0.0, 0.0, 2.0, -2.0,
+    0.0, 0.5, 0.0, 0.0, 10.0, 0.0
+  };
+  sim::MCWire const wire { 100U, waveform };
+
+  // threshold 0: only the zeros are not stored, the waveform is unchanged
+  sim::SparseMCWire const exact { wire };
+  CheckWire(exact, 100U, waveform);
+  BOOST_TEST(exact.Signal().n_ranges() == 4U);
+
+  // threshold 2: samples not above 2 in module become 0
+  std::vector<double> thresholded;
+  for (double value: waveform)
+    thresholded.push_back((std::abs(value) > 2.0)? value: 0.0);
+  sim::SparseMCWire const suppressed { wire, 2.0f };
+  CheckWire(suppressed, 100U, thresholded);
+  BOOST_TEST(suppressed.Signal().n_ranges() == 2U);
+
+  // threshold above all the samples: nothing stored, size preserved
+  sim::SparseMCWire const silent { wire, 20.0f };
+  CheckWire(silent, 100U, std::vector<double>(waveform.size(), 0.0));
+  BOOST_TEST(silent.Signal().n_ranges() == 0U);
+
+  // from a sparse vector
+  sim::SparseMCWire::Signal_t signal;
+  signal.resize(6);
+  signal.set_at(2, 1.25f);
+  signal.set_at(3, -0.5f);
+  sim::SparseMCWire const moved { 7U, std::move(signal) };
+  CheckWire(moved, 7U, { 0.0, 0.0, 1.25, -0.5, 0.0, 0.0 });
+
+  // empty waveform
+  CheckWire(sim::SparseMCWire{ sim::MCWire{ 3U, std::vector<double>{} } },
+    3U, {});
+
+  // default constructed
+  sim::SparseMCWire const empty;
+  BOOST_TEST(empty.StartTDC() == sim::kINVALID_UINT);
+  BOOST_TEST(empty.Waveform().empty());
+
+  // sorting by start TDC
+  BOOST_TEST((moved < exact));
+  BOOST_TEST(!(exact < suppressed));
+
+} // SparseMCWireTest()
+
+
+
+//------------------------------------------------------------------------------
+//--- registration of tests
+//
+
+BOOST_AUTO_TEST_CASE(SparseMCWire) {
+  SparseMCWireTest();
+}
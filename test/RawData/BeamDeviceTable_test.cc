@@ -0,0 +1,112 @@
+/**
+ * @file    BeamDeviceTable_test.cc
+ * @brief   Simple test on a raw::BeamDeviceTable object
+ *
+ * This test fills raw::BeamDeviceTable objects, directly and from a
+ * raw::BeamInfo, and verifies that the values it can access are the right
+ * ones.
+ *
+ * See http://www.boost.org/libs/test for the Boost test library home page.
+ */
+
+// C/C++ standard library
+#include <algorithm> // std::is_sorted()
+#include <vector>
+
+
+// Boost libraries
+#define BOOST_TEST_MODULE ( beamdevicetable_test )
+#include "boost/test/unit_test.hpp"
+
+// LArSoft libraries
+#include "lardataobj/RawData/BeamDeviceTable.h"
+#include "lardataobj/RawData/BeamInfo.h"
+
+
+
+//------------------------------------------------------------------------------
+//--- Test code
+//
+
+void CheckValues
+  (raw::BeamDeviceTable::Values_t values, std::vector<double> const& expected)
+{
+  BOOST_TEST(values.size() == expected.size());
+  BOOST_TEST(values.vector() == expected, boost::test_tools::per_element());
+} // CheckValues()
+
+
+void BeamDeviceTableFillTest() {
+
+  raw::BeamDeviceTable table;
+  BOOST_TEST(table.NDevices() == 0U);
+  BOOST_TEST(table.Get("E:TOR101").empty());
+
+  table.Set("E:TOR101", std::vector<double>{ 1.0, 2.0, 3.0 });
+
+  double* values = table.Allocate("E:TRTGTD", 2);
+  BOOST_TEST_REQUIRE(values);
+  values[0] = 4.0;
+  values[1] = 5.0;
+
+  std::vector<double> const single{ 6.0 };
+  table.Set("E:TORTGT", single.begin(), single.end());
+
+  // a device already present is not replaced
+  BOOST_TEST(table.Allocate("E:TOR101", 1) == nullptr);
+  table.Set("E:TOR101", std::vector<double>{ 7.0 });
+
+  BOOST_TEST(table.NDevices() == 3U);
+  BOOST_TEST
+    (std::is_sorted(table.DeviceKeys().begin(), table.DeviceKeys().end()));
+  BOOST_TEST(table.Values().size() == 6U);
+
+  constexpr raw::BeamDeviceTable::DeviceKey_t TRTGTD
+    = raw::BeamDeviceTable::DeviceKey("E:TRTGTD");
+  BOOST_TEST(table.HasDevice(TRTGTD));
+  BOOST_TEST(!table.HasDevice(raw::BeamDeviceTable::DeviceKey("E:TOR860")));
+
+  CheckValues(table.Get("E:TOR101"), { 1.0, 2.0, 3.0 });
+  CheckValues(table.Get(TRTGTD), { 4.0, 5.0 });
+  CheckValues(table.Get("E:TORTGT"), { 6.0 });
+  CheckValues(table.Get("E:TOR860"), {});
+
+  for (std::size_t i = 0; i < table.NDevices(); ++i) {
+    BOOST_TEST(table.DeviceKeys()[i]
+      == raw::BeamDeviceTable::DeviceKey(table.DeviceName(i)));
+    BOOST_TEST(table.ValuesAt(i).begin() == table.Get(table.DeviceName(i)).begin());
+  }
+
+} // BeamDeviceTableFillTest()
+
+
+void BeamDeviceTableFromBeamInfoTest() {
+
+  raw::BeamInfo info;
+  info.SetTOR101(1.5);
+  info.Set("E:M875BB", std::vector<double>{ 0.5, -0.5 });
+
+  raw::BeamDeviceTable const table(info);
+
+  BOOST_TEST(table.NDevices() == info.GetDataMap().size());
+  for (auto const& device: info.GetDataMap()) {
+    CheckValues(table.Get(device.first), device.second);
+    BOOST_TEST(info.Get(device.first) == device.second);
+  }
+  BOOST_TEST(info.Get("E:TOR860").empty());
+
+} // BeamDeviceTableFromBeamInfoTest()
+
+
+
+//------------------------------------------------------------------------------
+//--- registration of tests
+//
+
+BOOST_AUTO_TEST_CASE(BeamDeviceTableFill) {
+  BeamDeviceTableFillTest();
+}
+
+BOOST_AUTO_TEST_CASE(BeamDeviceTableFromBeamInfo) {
+  BeamDeviceTableFromBeamInfoTest();
+}
@@ -0,0 +1,139 @@
+/**
+ * @file    CompactWire_test.cc
+ * @brief   Simple test on a recob::CompactWire object
+ * @see     Wire_test.cc
+ *
+ * This test creates recob::CompactWire objects and verifies that the values it
+ * can access match the original ones within the quantization precision.
+ *
+ * See http://www.boost.org/libs/test for the Boost test library home page.
+ */
+
+// C/C++ standard library
+#include <cmath> // std::abs()
+
+
+// Boost libraries
+#define BOOST_TEST_MODULE ( compactwire_test )
+#include "boost/test/unit_test.hpp"
+
+// LArSoft libraries
+#include "larcoreobj/SimpleTypesAndConstants/RawTypes.h" // raw::ChannelID_t
+#include "larcoreobj/SimpleTypesAndConstants/geo_types.h" // geo::View_t
+#include "lardataobj/RecoBase/CompactWire.h"
+#include "lardataobj/RecoBase/Wire.h"
+
+
+
+//------------------------------------------------------------------------------
+//--- Test code
+//
+
+
+void CheckCompactWire(
+  recob::CompactWire const& wire,
+  recob::Wire::RegionsOfInterest_t const& sigROIlist,
+  raw::ChannelID_t channel,
+  geo::View_t view,
+  float tolerance
+) {
+
+  BOOST_TEST(wire.Channel() == channel);
+  BOOST_TEST(wire.View() == view);
+  BOOST_TEST(wire.NSignal() == sigROIlist.size());
+  BOOST_TEST(wire.ROIs().size() == sigROIlist.n_ranges());
+
+  // - region structure is preserved exactly
+  recob::Wire::RegionsOfInterest_t const wireROI = wire.SignalROI();
+  BOOST_TEST(wireROI.size() == sigROIlist.size());
+  BOOST_TEST(wireROI.n_ranges() == sigROIlist.n_ranges());
+  for (std::size_t i = 0; i < wireROI.n_ranges(); ++i) {
+    BOOST_TEST(wireROI.range(i).begin_index() == sigROIlist.range(i).begin_index());
+    BOOST_TEST(wireROI.range(i).end_index() == sigROIlist.range(i).end_index());
+  }
+
+  // - values within quantization precision
+  auto const& wire_signal = wire.Signal();
+  BOOST_TEST(wire_signal.size() == sigROIlist.size());
+  for (std::size_t tick = 0; tick < wire_signal.size(); ++tick) {
+    BOOST_TEST(std::abs(wire_signal[tick] - sigROIlist[tick]) <= tolerance);
+    BOOST_TEST(wireROI[tick] == wire_signal[tick]);
+  }
+
+  // - conversion back into a `recob::Wire`
+  recob::Wire const restored = wire.MakeWire();
+  BOOST_TEST(restored.Channel() == channel);
+  BOOST_TEST(restored.View() == view);
+  BOOST_TEST(restored.NSignal() == sigROIlist.size());
+  BOOST_TEST(restored.SignalROI().n_ranges() == sigROIlist.n_ranges());
+
+} // CheckCompactWire()
+
+
+void CompactWireTestDefaultConstructor() {
+
+  recob::CompactWire wire;
+  CheckCompactWire
+    (wire, recob::Wire::RegionsOfInterest_t{}, raw::InvalidChannelID, geo::kUnknown, 0.0f);
+
+} // CompactWireTestDefaultConstructor()
+
+
+void CompactWireTestQuantization() {
+
+  raw::ChannelID_t channel = 12;
+  geo::View_t view = geo::kV;
+
+  recob::Wire::RegionsOfInterest_t sigROIlist(30);
+  sigROIlist.add_range
+    (5, recob::Wire::RegionsOfInterest_t::vector_t({ 5.5, -6.25, 7. }));
+  sigROIlist.add_range
+    (11, recob::Wire::RegionsOfInterest_t::vector_t({ 110., 1.2, -13., 0.01 }));
+  sigROIlist.add_range
+    (20, recob::Wire::RegionsOfInterest_t::vector_t({ 0., 0. }));
+
+  recob::Wire const wire(sigROIlist, channel, view);
+
+  //
+  // per-region scale: precision is half a unit of the largest sample
+  //
+  recob::CompactWire const autoWire(wire);
+  CheckCompactWire(autoWire, sigROIlist, channel, view, 110.f / 32767.f);
+  BOOST_TEST(autoWire.ROIs()[0].Scale() == 7.f / 32767.f);
+  BOOST_TEST(autoWire.ROIs()[1].Scale() == 110.f / 32767.f);
+  // the largest sample is restored within half a quantization step
+  // (Boost tolerance on floating point numbers is relative)
+  float const halfStep = 0.5f * autoWire.ROIs()[1].Scale();
+  BOOST_TEST(autoWire.ROIs()[1][11] == 110.f,
+    boost::test_tools::tolerance(halfStep / 110.f));
+
+  //
+  // fixed quantization step
+  //
+  recob::CompactWire const stepWire(sigROIlist, channel, view, 0.25f);
+  CheckCompactWire(stepWire, sigROIlist, channel, view, 0.125f);
+  BOOST_TEST(stepWire.ROIs()[0][5] == 5.5f);
+  BOOST_TEST(stepWire.ROIs()[0][6] == -6.25f);
+  BOOST_TEST(stepWire.ROIs()[1].Samples()[0] == 440);
+
+  //
+  // saturation
+  //
+  recob::CompactWire const satWire(sigROIlist, channel, view, 0.001f);
+  BOOST_TEST(satWire.ROIs()[1].Samples()[0] == 32767);
+  BOOST_TEST(satWire.ROIs()[1].Samples()[2] == -13000);
+
+} // CompactWireTestQuantization()
+
+
+//------------------------------------------------------------------------------
+//--- registration of tests
+//
+
+BOOST_AUTO_TEST_CASE(CompactWireDefaultConstructor) {
+  CompactWireTestDefaultConstructor();
+}
+
+BOOST_AUTO_TEST_CASE(CompactWireQuantization) {
+  CompactWireTestQuantization();
+}
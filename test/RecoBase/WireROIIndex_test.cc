@@ -0,0 +1,144 @@
+/**
+ * @file    WireROIIndex_test.cc
+ * @brief   Test of the recob::WireROIIndex queries
+ * @see     lardataobj/RecoBase/WireROIIndex.h
+ *
+ * The results of the index queries are compared with the ones from a linear
+ * scan of all the regions of interest of all the wires.
+ *
+ * See http://www.boost.org/libs/test for the Boost test library home page.
+ */
+
+// C/C++ standard library
+#include <algorithm> // std::sort()
+#include <random>
+#include <vector>
+
+
+// Boost libraries
+#define BOOST_TEST_MODULE ( wireroiindex_test )
+#include "boost/test/unit_test.hpp"
+
+// LArSoft libraries
+#include "larcoreobj/SimpleTypesAndConstants/RawTypes.h" // raw::ChannelID_t
+#include "larcoreobj/SimpleTypesAndConstants/geo_types.h" // geo::View_t
+#include "lardataobj/RecoBase/WireROIIndex.h"
+#include "lardataobj/RecoBase/Wire.h"
+
+
+//------------------------------------------------------------------------------
+//--- Test code
+//
+
+using ROIRef_t = recob::WireROIIndex::ROIRef_t;
+using Tick_t = recob::WireROIIndex::Tick_t;
+
+
+/// Returns all the ROI overlapping [ t0, t1 [ with a linear scan.
+std::vector<ROIRef_t> LinearScan(
+  std::vector<recob::Wire> const& wires, Tick_t t0, Tick_t t1,
+  raw::ChannelID_t channel = raw::InvalidChannelID
+) {
+  std::vector<ROIRef_t> result;
+  if (t1 <= t0) return result; // empty window overlaps nothing
+  for (std::size_t iWire = 0; iWire < wires.size(); ++iWire) {
+    if ((channel != raw::InvalidChannelID) && (wires[iWire].Channel() != channel))
+      continue;
+    auto const& ranges = wires[iWire].SignalROI().get_ranges();
+    for (std::size_t iRange = 0; iRange < ranges.size(); ++iRange) {
+      if ((ranges[iRange].begin_index() < t1) && (ranges[iRange].end_index() > t0))
+        result.push_back({ iWire, iRange });
+    }
+  } // for
+  std::sort(result.begin(), result.end());
+  return result;
+} // LinearScan()
+
+
+/// Creates wires with random regions of interest (some of them long).
+std::vector<recob::Wire> MakeWires(unsigned int nWires, Tick_t nTicks) {
+  std::mt19937 rand(12345);
+  std::vector<recob::Wire> wires;
+  for (unsigned int iWire = 0; iWire < nWires; ++iWire) {
+    recob::Wire::RegionsOfInterest_t sigROIlist(nTicks);
+    Tick_t tick = rand() % 50;
+    while (tick < nTicks) {
+      Tick_t const length = (rand() % 20 == 0)? (rand() % 500 + 1): (rand() % 15 + 1);
+      sigROIlist.add_range
+        (tick, std::vector<float>(std::min(length, nTicks - tick), 1.0f));
+      tick += length + 1 + rand() % 300;
+    } // while
+    // some channels are present twice, and channel 0 is absent
+    raw::ChannelID_t const channel = (iWire % 7 == 3)? iWire - 1: iWire + 1;
+    wires.emplace_back(std::move(sigROIlist), channel, geo::kU);
+  } // for
+  return wires;
+} // MakeWires()
+
+
+void WireROIIndexTest() {
+
+  Tick_t const nTicks = 3000;
+  std::vector<recob::Wire> const wires = MakeWires(200, nTicks);
+  recob::WireROIIndex const index { wires };
+
+  std::size_t nROIs = 0;
+  for (recob::Wire const& wire: wires) nROIs += wire.SignalROI().n_ranges();
+  BOOST_TEST(index.NROIs() == nROIs);
+
+  std::mt19937 rand(54321);
+  for (int iQuery = 0; iQuery < 500; ++iQuery) {
+    Tick_t const t0 = rand() % (nTicks + 100);
+    Tick_t const t1 = t0 + rand() % ((iQuery % 10 == 0)? 2000: 50);
+
+    std::vector<ROIRef_t> const expected = LinearScan(wires, t0, t1);
+    std::vector<ROIRef_t> found = index.ROIsOverlapping(t0, t1);
+    for (std::size_t i = 1; i < found.size(); ++i) {
+      BOOST_TEST(index.GetROI(found[i-1]).begin_index()
+        <= index.GetROI(found[i]).begin_index());
+    }
+    std::sort(found.begin(), found.end());
+    BOOST_TEST((found == expected));
+
+    std::vector<raw::ChannelID_t> expectedChannels;
+    for (ROIRef_t const& ref: expected)
+      expectedChannels.push_back(wires[ref.wire].Channel());
+    std::sort(expectedChannels.begin(), expectedChannels.end());
+    expectedChannels.erase
+      (std::unique(expectedChannels.begin(), expectedChannels.end()), expectedChannels.end());
+    BOOST_TEST((index.ChannelsOverlapping(t0, t1) == expectedChannels));
+
+    raw::ChannelID_t const channel = rand() % 205;
+    std::vector<ROIRef_t> foundOnChannel
+      = index.ChannelROIsOverlapping(channel, t0, t1);
+    std::sort(foundOnChannel.begin(), foundOnChannel.end());
+    BOOST_TEST((foundOnChannel == LinearScan(wires, t0, t1, channel)));
+  } // for queries
+
+} // WireROIIndexTest()
+
+
+void WireROIIndexEmptyTest() {
+
+  std::vector<recob::Wire> const wires(3);
+  recob::WireROIIndex const index { wires };
+
+  BOOST_TEST(index.NROIs() == 0U);
+  BOOST_TEST(index.ROIsOverlapping(0, 1000).empty());
+  BOOST_TEST(index.ChannelsOverlapping(0, 1000).empty());
+  BOOST_TEST(index.ChannelROIsOverlapping(raw::InvalidChannelID, 0, 1000).empty());
+
+} // WireROIIndexEmptyTest()
+
+
+//------------------------------------------------------------------------------
+//--- registration of tests
+//
+
+BOOST_AUTO_TEST_CASE(WireROIIndexQueries) {
+  WireROIIndexTest();
+}
+
+BOOST_AUTO_TEST_CASE(WireROIIndexEmpty) {
+  WireROIIndexEmptyTest();
+}
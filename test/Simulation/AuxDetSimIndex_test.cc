@@ -0,0 +1,185 @@
+/**
+ * @file    AuxDetSimIndex_test.cc
+ * @brief   Test of sim::AuxDetSimChannelIndex and sim::AuxDetHitIndex
+ *
+ * This test indexes small hand-made collections of sim::AuxDetSimChannel and
+ * sim::AuxDetHit, and verifies the deposits and hits returned for each
+ * volume, time interval and track.
+ *
+ * See http://www.boost.org/libs/test for the Boost test library home page.
+ */
+
+// C/C++ standard library
+#include <limits>
+#include <vector>
+
+
+// Boost libraries
+#define BOOST_TEST_MODULE ( auxdetsimindex_test )
+#include "boost/test/unit_test.hpp"
+
+// LArSoft libraries
+#include "lardataobj/Simulation/AuxDetSimIndex.h"
+#include "lardataobj/Simulation/AuxDetSimChannel.h"
+#include "lardataobj/Simulation/AuxDetHit.h"
+
+
+
+//------------------------------------------------------------------------------
+//--- Test code
+//
+
+/// Returns a deposit with only track ID and entry time set.
+sim::AuxDetIDE MakeIDE(int trackID, float entryT) {
+  sim::AuxDetIDE ide;
+  ide.trackID = trackID;
+  ide.entryT = entryT;
+  return ide;
+} // MakeIDE()
+
+
+/// Returns a hit with only volume ID, track ID and entry time set.
+sim::AuxDetHit MakeHit(unsigned int ID, unsigned int trackID, float entryT) {
+  return { ID, trackID, 1.0f, 0.0f, 0.0f, 0.0f, entryT,
+    0.0f, 0.0f, 0.0f, entryT + 1.0f, 0.0f, 0.0f, 0.0f };
+} // MakeHit()
+
+
+/// Returns the references in `refs` encoded as `100 * channel + IDE`.
+std::vector<unsigned int> AsCodes(sim::AuxDetSimChannelIndex::IDERefs_t refs)
+{
+  std::vector<unsigned int> codes;
+  for (auto const& ref: refs) codes.push_back(100U * ref.channel + ref.ide);
+  return codes;
+} // AsCodes()
+
+
+/// Returns the hit positions in `refs`.
+std::vector<unsigned int> AsVector(sim::AuxDetHitIndex::HitRefs_t refs)
+  { return { refs.begin(), refs.end() }; }
+
+
+void AuxDetSimChannelIndexTest() {
+
+  using Refs_t = std::vector<unsigned int>; // see AsCodes()
+
+  std::vector<sim::AuxDetSimChannel> const channels {
+    { 1U, { MakeIDE(5, 30.0f), MakeIDE(-2, 10.0f), MakeIDE(5, 20.0f) }, 0U },
+    { 1U, { MakeIDE(7, 5.0f) }, 1U },
+    // same IDs as the first channel: deposits are merged with its ones
+    { 1U, { MakeIDE(-2, 15.0f), MakeIDE(7, 20.0f) }, 0U },
+    { 2U, std::vector<sim::AuxDetIDE>{}, 0U } // no deposits: not indexed
+  };
+
+  sim::AuxDetSimChannelIndex const index { channels };
+
+  BOOST_TEST(index.NSensitiveVolumes() == 2U);
+  BOOST_TEST(index.HasSensitiveVolume(1U, 0U));
+  BOOST_TEST(index.HasSensitiveVolume(1U, 1U));
+  BOOST_TEST(!index.HasSensitiveVolume(2U, 0U));
+  BOOST_TEST(!index.HasSensitiveVolume(0U, 1U));
+
+  // sorted by entry time; on equal time, in the original order
+  Refs_t const volume10 { 1U, 200U, 2U, 201U, 0U };
+  BOOST_TEST(AsCodes(index.IDEs(1U, 0U)) == volume10, boost::test_tools::per_element());
+  BOOST_TEST(AsCodes(index.IDEs(1U, 1U)) == (Refs_t{ 100U }),
+    boost::test_tools::per_element());
+  for (auto const& ref: index.IDEs(1U, 0U)) {
+    BOOST_TEST(index.GetChannel(ref).AuxDetID() == 1U);
+    BOOST_TEST(index.GetChannel(ref).AuxDetSensitiveID() == 0U);
+  }
+
+  // time intervals are [start, end)
+  BOOST_TEST(AsCodes(index.IDEs(1U, 0U, 15.0f, 30.0f))
+    == (Refs_t{ 200U, 2U, 201U }),
+    boost::test_tools::per_element());
+  BOOST_TEST(AsCodes(index.IDEs(1U, 0U, 20.0f, 30.5f))
+    == (Refs_t{ 2U, 201U, 0U }),
+    boost::test_tools::per_element());
+  BOOST_TEST(AsCodes(index.IDEs(1U, 0U, 0.0f, 100.0f)) == volume10,
+    boost::test_tools::per_element());
+  BOOST_TEST(index.IDEs(1U, 0U, 10.0f, 10.0f).empty());
+  BOOST_TEST(index.IDEs(1U, 0U, 30.5f, 40.0f).empty());
+  BOOST_TEST(index.IDEs(1U, 0U, 0.0f, 10.0f).empty());
+
+  // unknown volumes
+  BOOST_TEST(index.IDEs(2U, 0U).empty());
+  BOOST_TEST(index.IDEs(9U, 9U, 0.0f, 100.0f).empty());
+
+  // tracks, including negative IDs
+  BOOST_TEST(index.TrackIDs() == (std::vector<int>{ -2, 5, 7 }),
+    boost::test_tools::per_element());
+  BOOST_TEST(AsCodes(index.TrackIDEs(-2)) == (Refs_t{ 1U, 200U }),
+    boost::test_tools::per_element());
+  BOOST_TEST(AsCodes(index.TrackIDEs(5)) == (Refs_t{ 2U, 0U }),
+    boost::test_tools::per_element());
+  BOOST_TEST(AsCodes(index.TrackIDEs(7)) == (Refs_t{ 100U, 201U }),
+    boost::test_tools::per_element());
+  for (auto const& ref: index.TrackIDEs(-2))
+    BOOST_TEST(index.GetIDE(ref).trackID == -2);
+  BOOST_TEST(index.TrackIDEs(3).empty());
+  BOOST_TEST(index.TrackIDEs(-5).empty());
+
+} // AuxDetSimChannelIndexTest()
+
+
+void AuxDetHitIndexTest() {
+
+  // track ID -1 as stored in the unsigned track ID of sim::AuxDetHit
+  constexpr unsigned int negativeTrack = std::numeric_limits<unsigned int>::max();
+
+  sim::AuxDetHitCollection const hits {
+    MakeHit(3U, 1U, 8.0f),
+    MakeHit(1U, negativeTrack, 2.0f),
+    MakeHit(3U, 1U, 4.0f),
+    MakeHit(3U, 2U, 8.0f)
+  };
+
+  sim::AuxDetHitIndex const index { hits };
+
+  BOOST_TEST(index.IDs() == (std::vector<unsigned int>{ 1U, 3U }),
+    boost::test_tools::per_element());
+
+  // sorted by entry time; on equal time, in the original order
+  BOOST_TEST(AsVector(index.Hits(3U)) == (std::vector<unsigned int>{ 2U, 0U, 3U }),
+    boost::test_tools::per_element());
+  BOOST_TEST(AsVector(index.Hits(1U)) == (std::vector<unsigned int>{ 1U }),
+    boost::test_tools::per_element());
+  for (unsigned int ref: index.Hits(3U)) BOOST_TEST(index.GetHit(ref).GetID() == 3U);
+
+  // time intervals are [start, end)
+  BOOST_TEST(AsVector(index.Hits(3U, 4.0f, 8.0f)) == (std::vector<unsigned int>{ 2U }),
+    boost::test_tools::per_element());
+  BOOST_TEST(AsVector(index.Hits(3U, 5.0f, 9.0f)) == (std::vector<unsigned int>{ 0U, 3U }),
+    boost::test_tools::per_element());
+  BOOST_TEST(index.Hits(3U, 8.5f, 20.0f).empty());
+
+  // unknown volumes
+  BOOST_TEST(index.Hits(2U).empty());
+  BOOST_TEST(index.Hits(2U, 0.0f, 10.0f).empty());
+
+  // tracks
+  BOOST_TEST(index.TrackIDs()
+    == (std::vector<unsigned int>{ 1U, 2U, negativeTrack }),
+    boost::test_tools::per_element());
+  BOOST_TEST(AsVector(index.TrackHits(1U)) == (std::vector<unsigned int>{ 2U, 0U }),
+    boost::test_tools::per_element());
+  BOOST_TEST(AsVector(index.TrackHits(negativeTrack)) == (std::vector<unsigned int>{ 1U }),
+    boost::test_tools::per_element());
+  BOOST_TEST(index.TrackHits(7U).empty());
+
+} // AuxDetHitIndexTest()
+
+
+
+//------------------------------------------------------------------------------
+//--- registration of tests
+//
+
+BOOST_AUTO_TEST_CASE(AuxDetSimChannelIndex) {
+  AuxDetSimChannelIndexTest();
+}
+
+BOOST_AUTO_TEST_CASE(AuxDetHitIndex) {
+  AuxDetHitIndexTest();
+}
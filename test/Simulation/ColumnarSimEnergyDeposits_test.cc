@@ -0,0 +1,207 @@
+/**
+ * @file    ColumnarSimEnergyDeposits_test.cc
+ * @brief   Test of sim::ColumnarSimEnergyDeposits and of its voxel index
+ *
+ * This test converts random sim::SimEnergyDeposit collections, and verifies
+ * the columns and, after indexing them with different grids, the deposits of
+ * each cell, in their original order, and the ones out of the grid.
+ *
+ * See http://www.boost.org/libs/test for the Boost test library home page.
+ */
+
+// C/C++ standard library
+#include <cmath> // std::floor(), std::isnan()
+#include <limits> // std::numeric_limits<>
+#include <random>
+#include <vector>
+
+
+// Boost libraries
+#define BOOST_TEST_MODULE ( columnarsimenergydeposits_test )
+#include "boost/test/unit_test.hpp"
+
+// LArSoft libraries
+#include "lardataobj/Simulation/ColumnarSimEnergyDeposits.h"
+#include "lardataobj/Simulation/SimEnergyDeposit.h"
+
+
+
+//------------------------------------------------------------------------------
+//--- Test code
+//
+
+/// Returns random deposits, the track ID being the position in the collection.
+sim::SimEnergyDepositCollection MakeDeposits(unsigned int nDeposits, unsigned int seed)
+{
+  std::mt19937 engine(seed);
+  // middle of the steps on half-integral coordinates, away from cell borders
+  std::uniform_int_distribution<int> positionDist(-5, 54);
+  std::uniform_int_distribution<int> stepDist(-2, 2);
+  std::uniform_real_distribution<double> valueDist(0.0, 100.0);
+
+  double const nan = std::numeric_limits<double>::quiet_NaN();
+
+  sim::SimEnergyDepositCollection deposits;
+  for (unsigned int i = 0; i < nDeposits; ++i) {
+    geo::Point_t const middle {
+      positionDist(engine) + 0.5, positionDist(engine) + 0.5,
+      positionDist(engine) + 0.5
+    };
+    double const step = stepDist(engine) * 0.25;
+    geo::Point_t start { middle.X() - step, middle.Y() + step, middle.Z() };
+    geo::Point_t end { middle.X() + step, middle.Y() - step, middle.Z() };
+    if (i % 40 == 7) start = end = geo::Point_t{ nan, 1.0, 1.0 };
+    double const t0 = valueDist(engine);
+    deposits.emplace_back(
+      int(valueDist(engine)), int(valueDist(engine)), 0.25, valueDist(engine),
+      start, end, t0, t0 + 1.0, int(i), 11 + int(i % 3)
+      );
+  } // for
+  return deposits;
+} // MakeDeposits()
+
+
+/// Returns the ID of the cell of `grid` containing the point (none: NVoxels()).
+std::size_t ExpectedVoxel(
+  sim::ColumnarSimEnergyDeposits::VoxelGrid_t const& grid,
+  double x, double y, double z
+) {
+  double const pos[3] = { x, y, z };
+  unsigned int index[3];
+  for (int i = 0; i < 3; ++i) {
+    double const cell = std::floor((pos[i] - grid.lower[i]) / grid.size[i]);
+    if (!(cell >= 0.0) || !(cell < grid.n[i])) return grid.NVoxels();
+    index[i] = static_cast<unsigned int>(cell);
+  }
+  return grid.VoxelID(index[0], index[1], index[2]);
+} // ExpectedVoxel()
+
+
+/// Checks the voxel index of `columns` against the original `deposits`.
+void CheckVoxelIndex(
+  sim::ColumnarSimEnergyDeposits const& columns,
+  sim::SimEnergyDepositCollection const& deposits
+) {
+  auto const& grid = columns.VoxelGrid();
+  BOOST_TEST_REQUIRE(columns.HasVoxelIndex());
+  BOOST_TEST_REQUIRE(columns.size() == deposits.size());
+
+  // expected: the original positions in each cell, in increasing order
+  std::vector<std::vector<int>> expected(grid.NVoxels() + 1);
+  for (std::size_t i = 0; i < deposits.size(); ++i) {
+    sim::SimEnergyDeposit const& dep = deposits[i];
+    expected[ExpectedVoxel(grid, dep.MidPointX(), dep.MidPointY(), dep.MidPointZ())]
+      .push_back(int(i));
+  }
+
+  std::size_t nextStart = 0;
+  for (std::size_t voxelID = 0; voxelID <= grid.NVoxels(); ++voxelID) {
+    BOOST_TEST_CONTEXT("voxel #" << voxelID) {
+      auto const [ begin, end ] = (voxelID == grid.NVoxels())
+        ? columns.OutsideDeposits(): columns.VoxelDeposits(voxelID);
+      BOOST_TEST(begin == nextStart);
+      nextStart = end;
+      std::vector<int> trackIDs;
+      for (std::size_t i = begin; i < end; ++i) {
+        trackIDs.push_back(columns.TrackID()[i]);
+        BOOST_TEST(columns.OriginalIndex(i) == std::size_t(columns.TrackID()[i]));
+      }
+      BOOST_TEST(trackIDs == expected[voxelID], boost::test_tools::per_element());
+    } // context
+  } // for
+  BOOST_TEST(nextStart == columns.size());
+
+  // the cell with the specified indices is the one with its ID
+  unsigned int const ix = grid.n[0] - 1, iy = grid.n[1] / 2, iz = grid.n[2] - 1;
+  auto const [ begin, end ] = columns.VoxelDeposits(ix, iy, iz);
+  BOOST_TEST(begin == columns.VoxelDeposits(grid.VoxelID(ix, iy, iz)).first);
+  BOOST_TEST(end == columns.VoxelDeposits(grid.VoxelID(ix, iy, iz)).second);
+
+} // CheckVoxelIndex()
+
+
+/// Checks that all the columns of `columns` match the original `deposits`.
+void CheckColumns(
+  sim::ColumnarSimEnergyDeposits const& columns,
+  sim::SimEnergyDepositCollection const& deposits
+) {
+  BOOST_TEST_REQUIRE(columns.size() == deposits.size());
+  for (std::size_t i = 0; i < columns.size(); ++i) {
+    sim::SimEnergyDeposit const& dep = deposits[columns.OriginalIndex(i)];
+    BOOST_TEST_CONTEXT("deposit #" << i) {
+      if (std::isnan(dep.MidPointX())) BOOST_TEST(std::isnan(columns.X()[i]));
+      else BOOST_TEST(columns.X()[i] == float(dep.MidPointX()));
+      BOOST_TEST(columns.Y()[i] == float(dep.MidPointY()));
+      BOOST_TEST(columns.Z()[i] == float(dep.MidPointZ()));
+      BOOST_TEST(columns.T()[i] == dep.Time());
+      BOOST_TEST(columns.Energy()[i] == float(dep.Energy()));
+      BOOST_TEST(columns.NumElectrons()[i] == dep.NumElectrons());
+      BOOST_TEST(columns.NumPhotons()[i] == dep.NumPhotons());
+      BOOST_TEST(columns.ScintYieldRatio()[i] == float(dep.ScintYieldRatio()));
+      BOOST_TEST(columns.TrackID()[i] == dep.TrackID());
+      BOOST_TEST(columns.PdgCode()[i] == dep.PdgCode());
+    } // context
+  } // for
+} // CheckColumns()
+
+
+void ColumnarSimEnergyDepositsTest() {
+
+  sim::SimEnergyDepositCollection const deposits = MakeDeposits(400, 1U);
+
+  sim::ColumnarSimEnergyDeposits columns { deposits };
+  BOOST_TEST(columns.size() == deposits.size());
+  BOOST_TEST(!columns.empty());
+  BOOST_TEST(!columns.HasVoxelIndex());
+  CheckColumns(columns, deposits);
+  for (std::size_t i = 0; i < columns.size(); ++i)
+    BOOST_TEST(columns.OriginalIndex(i) == i);
+
+  // no index: all ranges are empty
+  BOOST_TEST(columns.VoxelDeposits(0).first == columns.VoxelDeposits(0).second);
+  BOOST_TEST(columns.OutsideDeposits().first == columns.OutsideDeposits().second);
+
+  // a grid smaller than the deposit volume
+  columns.BuildVoxelIndex({ { 0.f, 0.f, 0.f }, { 10.f, 20.f, 25.f }, { 4, 2, 2 } });
+  CheckVoxelIndex(columns, deposits);
+  CheckColumns(columns, deposits);
+
+  // a second index, on top of the first one, still keeps the original order
+  columns.BuildVoxelIndex({ { -5.f, 0.f, -5.f }, { 5.f, 40.f, 60.f }, { 8, 1, 1 } });
+  CheckVoxelIndex(columns, deposits);
+  CheckColumns(columns, deposits);
+
+  // and a third one
+  columns.BuildVoxelIndex({ { 20.f, 20.f, 20.f }, { 3.f, 7.f, 2.f }, { 3, 3, 5 } });
+  CheckVoxelIndex(columns, deposits);
+  CheckColumns(columns, deposits);
+
+} // ColumnarSimEnergyDepositsTest()
+
+
+void EmptyColumnarSimEnergyDepositsTest() {
+
+  sim::ColumnarSimEnergyDeposits columns { sim::SimEnergyDepositCollection{} };
+  BOOST_TEST(columns.empty());
+
+  columns.BuildVoxelIndex({ { 0.f, 0.f, 0.f }, { 1.f, 1.f, 1.f }, { 2, 2, 2 } });
+  BOOST_TEST(columns.HasVoxelIndex());
+  for (std::size_t voxelID = 0; voxelID < 8; ++voxelID)
+    BOOST_TEST(columns.VoxelDeposits(voxelID).second == 0U);
+  BOOST_TEST(columns.OutsideDeposits().second == 0U);
+
+} // EmptyColumnarSimEnergyDepositsTest()
+
+
+
+//------------------------------------------------------------------------------
+//--- registration of tests
+//
+
+BOOST_AUTO_TEST_CASE(ColumnarSimEnergyDeposits) {
+  ColumnarSimEnergyDepositsTest();
+}
+
+BOOST_AUTO_TEST_CASE(EmptyColumnarSimEnergyDeposits) {
+  EmptyColumnarSimEnergyDepositsTest();
+}
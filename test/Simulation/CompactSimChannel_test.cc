@@ -0,0 +1,131 @@
+/**
+ * @file    CompactSimChannel_test.cc
+ * @brief   Test of sim::CompactSimChannel
+ *
+ * This test compacts a sim::SimChannel with ticks close and far apart, and
+ * verifies the content read back through the view and through the copies.
+ *
+ * See http://www.boost.org/libs/test for the Boost test library home page.
+ */
+
+// C/C++ standard library
+#include <cmath> // std::abs()
+#include <vector>
+
+
+// Boost libraries
+#define BOOST_TEST_MODULE ( compactsimchannel_test )
+#include "boost/test/unit_test.hpp"
+
+// LArSoft libraries
+#include "lardataobj/Simulation/CompactSimChannel.h"
+#include "lardataobj/Simulation/SimChannel.h"
+
+
+
+//------------------------------------------------------------------------------
+//--- Test code
+//
+
+sim::SimChannel MakeChannel() {
+  sim::SimChannel channel(25);
+  // ticks from 0 (first delta 0) to the end of the range; gaps of 254 ticks
+  // are stored as deltas, gaps of 255 ticks and more as escapes
+  std::vector<unsigned int> const ticks
+    = { 0, 1, 255, 509, 510, 765, 20000, 20001, 65535 };
+  int trackID = 1;
+  for (unsigned int tdc: ticks) {
+    double const xyz[3] = { 0.5 * tdc, -1.0 * trackID, 2.0 };
+    channel.AddIonizationElectrons(trackID, tdc, 100.0 + tdc, xyz, 0.01);
+    channel.AddIonizationElectrons(-trackID, tdc, 50.0, xyz, 0.005);
+    ++trackID;
+  }
+  return channel;
+} // MakeChannel()
+
+
+void CheckIDE(sim::IDE const& ide, sim::IDE const& expected) {
+  BOOST_TEST(ide.trackID == expected.trackID);
+  BOOST_TEST(ide.numElectrons == expected.numElectrons);
+  BOOST_TEST(ide.energy == expected.energy);
+  BOOST_TEST(ide.x == expected.x);
+  BOOST_TEST(ide.y == expected.y);
+  BOOST_TEST(ide.z == expected.z);
+} // CheckIDE()
+
+
+void CompactSimChannelTest() {
+
+  sim::SimChannel const channel = MakeChannel();
+  auto const& expected = channel.TDCIDEMap();
+
+  sim::CompactSimChannel const compact(channel);
+  BOOST_TEST(compact.Channel() == channel.Channel());
+  BOOST_TEST(!compact.HasPackedPositions());
+  BOOST_TEST_REQUIRE(compact.NTDCs() == expected.size());
+
+  std::vector<sim::CompactSimChannel::StoredTDC_t> const TDCs = compact.TDCs();
+  BOOST_TEST_REQUIRE(TDCs.size() == expected.size());
+  for (std::size_t i = 0; i < TDCs.size(); ++i)
+    BOOST_TEST(TDCs[i] == expected[i].first);
+
+  // view
+  auto const view = compact.TDCIDEMap();
+  BOOST_TEST(view.size() == expected.size());
+  std::size_t iTDC = 0;
+  for (auto const& [ tdc, ides ]: view) {
+    BOOST_TEST_REQUIRE(iTDC < expected.size());
+    BOOST_TEST(tdc == expected[iTDC].first);
+    auto const& expectedIDEs = expected[iTDC].second;
+    BOOST_TEST_REQUIRE(ides.size() == expectedIDEs.size());
+    std::size_t iIDE = 0;
+    for (sim::IDE const ide: ides) CheckIDE(ide, expectedIDEs[iIDE++]);
+    BOOST_TEST(iIDE == expectedIDEs.size());
+    ++iTDC;
+  }
+  BOOST_TEST(iTDC == expected.size());
+
+  // copies
+  sim::SimChannel const restored = compact.MakeSimChannel();
+  BOOST_TEST(restored.Channel() == channel.Channel());
+  auto const& TDCIDEs = restored.TDCIDEMap();
+  BOOST_TEST_REQUIRE(TDCIDEs.size() == expected.size());
+  for (std::size_t i = 0; i < TDCIDEs.size(); ++i) {
+    BOOST_TEST(TDCIDEs[i].first == expected[i].first);
+    BOOST_TEST_REQUIRE(TDCIDEs[i].second.size() == expected[i].second.size());
+    for (std::size_t j = 0; j < TDCIDEs[i].second.size(); ++j)
+      CheckIDE(TDCIDEs[i].second[j], expected[i].second[j]);
+  }
+
+  // packed positions are within half a step per coordinate
+  // (x spans 32767.5 cm, y spans 8 cm, z is constant)
+  float const xTolerance = 0.5f * 32767.5f / 65535.f + 0.01f;
+  float const yTolerance = 0.5f * 8.f / 65535.f + 1e-6f;
+  sim::CompactSimChannel const packed(channel, true);
+  BOOST_TEST(packed.HasPackedPositions());
+  BOOST_TEST_REQUIRE(packed.NIDEs() == compact.NIDEs());
+  for (std::size_t i = 0; i < packed.NIDEs(); ++i) {
+    sim::IDE const ide = packed.IDE(i);
+    sim::IDE const expectedIDE = compact.IDE(i);
+    BOOST_TEST(ide.trackID == expectedIDE.trackID);
+    BOOST_TEST(std::abs(ide.x - expectedIDE.x) <= xTolerance);
+    BOOST_TEST(std::abs(ide.y - expectedIDE.y) <= yTolerance);
+    BOOST_TEST(ide.z == expectedIDE.z);
+  }
+
+  // empty channel
+  sim::CompactSimChannel const empty(sim::SimChannel(3));
+  BOOST_TEST(empty.TDCIDEMap().empty());
+  BOOST_TEST(empty.MakeSimChannel().TDCIDEMap().empty());
+
+} // CompactSimChannelTest()
+
+
+
+//------------------------------------------------------------------------------
+//--- registration of tests
+//
+
+BOOST_AUTO_TEST_CASE(CompactSimChannel) {
+  CompactSimChannelTest();
+}
@@ -0,0 +1,204 @@
+/**
+ * @file    DenseSimPhotonsLite_test.cc
+ * @brief   Test of sim::DenseSimPhotonsLite
+ *
+ * This test fills sim::DenseSimPhotonsLite objects with random photons, and
+ * verifies their content against a plain map, their storage against the gap
+ * limit, and the conversion from and to sim::SimPhotonsLite.
+ *
+ * See http://www.boost.org/libs/test for the Boost test library home page.
+ */
+
+// C/C++ standard library
+#include <limits>
+#include <map>
+#include <random>
+#include <vector>
+
+
+// Boost libraries
+#define BOOST_TEST_MODULE ( densesimphotonslite_test )
+#include "boost/test/unit_test.hpp"
+
+// LArSoft libraries
+#include "lardataobj/Simulation/DenseSimPhotonsLite.h"
+#include "lardataobj/Simulation/SimPhotons.h"
+
+
+
+//------------------------------------------------------------------------------
+//--- Test code
+//
+
+using Tick_t = sim::DenseSimPhotonsLite::Tick_t;
+using Count_t = sim::DenseSimPhotonsLite::Count_t;
+
+
+/// Checks the content and the layout of `photons` against `expected`.
+void CheckPhotons(
+  sim::DenseSimPhotonsLite const& photons,
+  std::map<Tick_t, Count_t> const& expected
+) {
+  // ticks with photons
+  std::size_t nTicks = 0;
+  long long nPhotons = 0;
+  auto iExpected = expected.begin();
+  for (auto const& [ tick, count ]: photons.DetectedPhotons()) {
+    BOOST_TEST_REQUIRE((iExpected != expected.end()));
+    BOOST_TEST(tick == iExpected->first);
+    BOOST_TEST(count == iExpected->second);
+    BOOST_TEST(photons.Photons(tick) == count);
+    nPhotons += count;
+    ++iExpected;
+    ++nTicks;
+  } // for
+  BOOST_TEST(nTicks == expected.size());
+  BOOST_TEST(photons.NPhotons() == nPhotons);
+
+  // blocks are sorted, separated by more than the largest gap, and the gaps
+  // within them are not larger than that
+  std::size_t nStored = 0;
+  for (std::size_t iBlock = 0; iBlock < photons.NBlocks(); ++iBlock) {
+    std::size_t const size = photons.BlockSize(iBlock);
+    Count_t const* counts = photons.BlockCounts(iBlock);
+    BOOST_TEST_REQUIRE(size > 0U);
+    BOOST_TEST(counts[0] != 0);
+    BOOST_TEST(counts[size - 1] != 0);
+    if (iBlock > 0) {
+      long long const prevEnd = photons.BlockFirstTick(iBlock - 1)
+        + static_cast<long long>(photons.BlockSize(iBlock - 1));
+      BOOST_TEST(photons.BlockFirstTick(iBlock) - prevEnd
+        > sim::DenseSimPhotonsLite::MaxGap);
+    }
+    std::size_t gap = 0;
+    for (std::size_t i = 0; i < size; ++i) {
+      gap = (counts[i] == 0)? gap + 1: 0;
+      BOOST_TEST(gap <= std::size_t(sim::DenseSimPhotonsLite::MaxGap));
+    }
+    nStored += size;
+  } // for
+  BOOST_TEST(nStored <= nTicks * (sim::DenseSimPhotonsLite::MaxGap + 1));
+
+} // CheckPhotons()
+
+
+void RandomFillTest(unsigned int seed) {
+
+  std::mt19937 engine(seed);
+  // photons mostly in a window, some far away
+  std::uniform_int_distribution<Tick_t> windowDist(-500, 3000);
+  std::uniform_int_distribution<Tick_t> farDist
+    (std::numeric_limits<Tick_t>::min(), std::numeric_limits<Tick_t>::max());
+  std::uniform_int_distribution<Count_t> countDist(1, 5);
+
+  sim::DenseSimPhotonsLite photons(8), other(8);
+  std::map<Tick_t, Count_t> expected, otherExpected;
+  for (int i = 0; i < 2000; ++i) {
+    Tick_t const tick = (i % 50 == 0)? farDist(engine): windowDist(engine);
+    Count_t const n = countDist(engine);
+    photons.AddPhotons(tick, n);
+    expected[tick] += n;
+    if (i % 3 == 0) {
+      Tick_t const otherTick = (i % 60 == 0)? farDist(engine): windowDist(engine);
+      other.AddPhotons(otherTick, n);
+      otherExpected[otherTick] += n;
+    }
+  } // for
+  CheckPhotons(photons, expected);
+  CheckPhotons(other, otherExpected);
+
+  // addition
+  sim::DenseSimPhotonsLite const sum = photons + other;
+  for (auto const& [ tick, count ]: otherExpected) expected[tick] += count;
+  CheckPhotons(sum, expected);
+
+  // conversion
+  sim::SimPhotonsLite const lite = sum.MakeSimPhotonsLite();
+  BOOST_TEST(lite.OpChannel == 8);
+  BOOST_TEST(lite.DetectedPhotons == expected);
+  CheckPhotons(sim::DenseSimPhotonsLite{ lite }, expected);
+
+} // RandomFillTest()
+
+
+void LatePhotonTest() {
+
+  // a single late photon adds a small block, instead of a huge histogram
+  sim::DenseSimPhotonsLite photons(1);
+  photons.AddPhotons(10);
+  photons.AddPhotons(12, 2);
+  photons.AddPhotons(1'000'000'000);
+  BOOST_TEST(photons.NBlocks() == 2U);
+  BOOST_TEST(photons.BlockSize(0) == 3U);
+  BOOST_TEST(photons.BlockSize(1) == 1U);
+  BOOST_TEST(photons.Photons(1'000'000'000) == 1);
+  BOOST_TEST(photons.Photons(11) == 0);
+  BOOST_TEST(photons.Photons(13) == 0);
+
+  // extreme ticks do not overflow
+  Tick_t const minTick = std::numeric_limits<Tick_t>::min();
+  Tick_t const maxTick = std::numeric_limits<Tick_t>::max();
+  photons.AddPhotons(maxTick, 3);
+  photons.AddPhotons(minTick, 4);
+  BOOST_TEST(photons.NBlocks() == 4U);
+  BOOST_TEST(photons.Photons(maxTick) == 3);
+  BOOST_TEST(photons.Photons(minTick) == 4);
+  BOOST_TEST(photons.NPhotons() == 11);
+
+  // a tick close to two blocks joins them
+  Tick_t constexpr MaxGap = sim::DenseSimPhotonsLite::MaxGap;
+  photons.AddPhotons(13 + MaxGap + 1); // just too far from the tick 12
+  BOOST_TEST(photons.NBlocks() == 5U);
+  photons.AddPhotons(13 + MaxGap / 2);
+  BOOST_TEST(photons.NBlocks() == 4U);
+
+  CheckPhotons(photons, {
+    { minTick, 4 }, { 10, 1 }, { 12, 2 },
+    { 13 + MaxGap / 2, 1 }, { 13 + MaxGap + 1, 1 },
+    { 1'000'000'000, 1 }, { maxTick, 3 }
+    });
+
+} // LatePhotonTest()
+
+
+void CoverTest() {
+
+  sim::DenseSimPhotonsLite photons(2);
+  photons.AddPhotons(0);
+  photons.AddPhotons(1000);
+  BOOST_TEST(photons.NBlocks() == 2U);
+
+  // an explicit range joins the blocks, and it is stored in full
+  photons.Cover(-10, 1500);
+  BOOST_TEST(photons.NBlocks() == 1U);
+  BOOST_TEST(photons.BlockFirstTick(0) == -10);
+  BOOST_TEST(photons.BlockSize(0) == 1510U);
+  BOOST_TEST(photons.Photons(0) == 1);
+  BOOST_TEST(photons.Photons(1000) == 1);
+
+  // adding within the range does not change the layout
+  photons.AddPhotons(1499, 2);
+  BOOST_TEST(photons.NBlocks() == 1U);
+  BOOST_TEST(photons.BlockSize(0) == 1510U);
+  BOOST_TEST(photons.NPhotons() == 4);
+
+} // CoverTest()
+
+
+
+//------------------------------------------------------------------------------
+//--- registration of tests
+//
+
+BOOST_AUTO_TEST_CASE(RandomFill) {
+  RandomFillTest(1U);
+  RandomFillTest(12345U);
+}
+
+BOOST_AUTO_TEST_CASE(LatePhoton) {
+  LatePhotonTest();
+}
+
+BOOST_AUTO_TEST_CASE(Cover) {
+  CoverTest();
+}
@@ -0,0 +1,173 @@
+/**
+ * @file    FlatSimPhotonsCollection_test.cc
+ * @brief   Test of sim::FlatSimPhotonsCollection
+ *
+ * This test builds sim::FlatSimPhotonsCollection objects from photons and
+ * channels in different orders, and verifies that the photons of each channel
+ * keep their original order, and the conversion back to
+ * sim::SimPhotonsCollection.
+ *
+ * See http://www.boost.org/libs/test for the Boost test library home page.
+ */
+
+// C/C++ standard library
+#include <stdexcept> // std::runtime_error
+#include <utility> // std::move()
+#include <vector>
+
+
+// Boost libraries
+#define BOOST_TEST_MODULE ( flatsimphotonscollection_test )
+#include "boost/test/unit_test.hpp"
+
+// LArSoft libraries
+#include "lardataobj/Simulation/FlatSimPhotonsCollection.h"
+#include "lardataobj/Simulation/SimPhotons.h"
+
+
+
+//------------------------------------------------------------------------------
+//--- Test code
+//
+
+/// Returns a photon identified by `code`, stored as its _z_ position.
+sim::OnePhoton MakePhoton(int code) {
+  sim::OnePhoton photon;
+  photon.Time = 0.5f * code;
+  photon.MotherTrackID = code;
+  photon.InitialPosition = geo::Point_t{ 0.0, 0.0, double(code) };
+  return photon;
+} // MakePhoton()
+
+
+/// Returns the codes (see `MakePhoton()`) of the photons in `photons`.
+template <typename Photons>
+std::vector<int> AsCodes(Photons const& photons) {
+  std::vector<int> codes;
+  for (sim::OnePhoton const& photon: photons)
+    codes.push_back(static_cast<int>(photon.InitialPosition.Z()));
+  return codes;
+} // AsCodes()
+
+
+void FlatSimPhotonsFromChannelsTest() {
+
+  // channels not sorted: photons are sorted by channel, each keeping its order
+  std::vector<int> const channels { 5, 2, 5, 9, 2, 2, 5 };
+  std::vector<sim::OnePhoton> photons;
+  for (int code: { 50, 20, 51, 90, 21, 22, 52 })
+    photons.push_back(MakePhoton(code));
+
+  sim::FlatSimPhotonsCollection const flat { channels, photons };
+  BOOST_TEST(flat.NChannels() == 3U);
+  BOOST_TEST(flat.NPhotons() == photons.size());
+  BOOST_TEST(flat.Channels() == (std::vector<int>{ 2, 5, 9 }),
+    boost::test_tools::per_element());
+  BOOST_TEST(AsCodes(flat.AllPhotons())
+    == (std::vector<int>{ 20, 21, 22, 50, 51, 52, 90 }),
+    boost::test_tools::per_element());
+  BOOST_TEST(AsCodes(flat.Photons(2)) == (std::vector<int>{ 20, 21, 22 }),
+    boost::test_tools::per_element());
+  BOOST_TEST(AsCodes(flat.Photons(5)) == (std::vector<int>{ 50, 51, 52 }),
+    boost::test_tools::per_element());
+  BOOST_TEST(AsCodes(flat.PhotonsAt(2)) == (std::vector<int>{ 90 }),
+    boost::test_tools::per_element());
+  BOOST_TEST(flat.HasChannel(9));
+  BOOST_TEST(!flat.HasChannel(3));
+  BOOST_TEST(flat.Photons(3).empty());
+  BOOST_TEST(flat.Photons(10).empty());
+
+  // channels already sorted: the photons are moved in as they are
+  std::vector<int> const sortedChannels { 1, 1, 4, 6, 6, 6 };
+  std::vector<sim::OnePhoton> sortedPhotons;
+  for (int code: { 10, 11, 40, 60, 61, 62 })
+    sortedPhotons.push_back(MakePhoton(code));
+  sim::OnePhoton const* const buffer = sortedPhotons.data();
+
+  sim::FlatSimPhotonsCollection const moved
+    { sortedChannels, std::move(sortedPhotons) };
+  BOOST_TEST(moved.AllPhotons().data() == buffer);
+  BOOST_TEST(moved.Channels() == (std::vector<int>{ 1, 4, 6 }),
+    boost::test_tools::per_element());
+  BOOST_TEST(AsCodes(moved.Photons(1)) == (std::vector<int>{ 10, 11 }),
+    boost::test_tools::per_element());
+  BOOST_TEST(AsCodes(moved.Photons(4)) == (std::vector<int>{ 40 }),
+    boost::test_tools::per_element());
+  BOOST_TEST(AsCodes(moved.Photons(6)) == (std::vector<int>{ 60, 61, 62 }),
+    boost::test_tools::per_element());
+
+  // no photons at all
+  sim::FlatSimPhotonsCollection const empty
+    { std::vector<int>{}, std::vector<sim::OnePhoton>{} };
+  BOOST_TEST(empty.NChannels() == 0U);
+  BOOST_TEST(empty.NPhotons() == 0U);
+  BOOST_TEST(empty.Photons(1).empty());
+
+  // one channel per photon is required
+  BOOST_CHECK_THROW(
+    (sim::FlatSimPhotonsCollection{ std::vector<int>{ 1, 2 }, photons }),
+    std::runtime_error
+    );
+
+} // FlatSimPhotonsFromChannelsTest()
+
+
+void FlatSimPhotonsFromSimPhotonsTest() {
+
+  // channel 3 appears twice: its photons are joined in order
+  std::vector<sim::SimPhotons> photons {
+    sim::SimPhotons{ 3 }, sim::SimPhotons{ 1 },
+    sim::SimPhotons{ 3 }, sim::SimPhotons{ 7 } // channel 7: no photons
+  };
+  for (int code: { 30, 31 }) photons[0].push_back(MakePhoton(code));
+  for (int code: { 10, 11, 12 }) photons[1].push_back(MakePhoton(code));
+  for (int code: { 32 }) photons[2].push_back(MakePhoton(code));
+
+  sim::FlatSimPhotonsCollection flat { photons };
+  BOOST_TEST(flat.Channels() == (std::vector<int>{ 1, 3, 7 }),
+    boost::test_tools::per_element());
+  BOOST_TEST(flat.NPhotons() == 6U);
+  BOOST_TEST(AsCodes(flat.Photons(1)) == (std::vector<int>{ 10, 11, 12 }),
+    boost::test_tools::per_element());
+  BOOST_TEST(AsCodes(flat.Photons(3)) == (std::vector<int>{ 30, 31, 32 }),
+    boost::test_tools::per_element());
+  BOOST_TEST(flat.HasChannel(7));
+  BOOST_TEST(flat.Photons(7).empty());
+
+  // conversion to sim::SimPhotonsCollection
+  flat.SetSDName("PhotonDetector");
+  sim::SimPhotonsCollection const collection = flat.MakeSimPhotonsCollection();
+  BOOST_TEST(collection.GetSDName() == "PhotonDetector");
+  BOOST_TEST_REQUIRE(collection.size() == 3U);
+  BOOST_TEST(collection.at(1).OpChannel() == 1);
+  BOOST_TEST(AsCodes(collection.at(1)) == (std::vector<int>{ 10, 11, 12 }),
+    boost::test_tools::per_element());
+  BOOST_TEST(collection.at(3).OpChannel() == 3);
+  BOOST_TEST(AsCodes(collection.at(3)) == (std::vector<int>{ 30, 31, 32 }),
+    boost::test_tools::per_element());
+  BOOST_TEST(collection.at(7).empty());
+
+  // ... and back
+  sim::FlatSimPhotonsCollection const roundTrip { collection };
+  BOOST_TEST(roundTrip.GetSDName() == "PhotonDetector");
+  BOOST_TEST(roundTrip.Channels() == flat.Channels(),
+    boost::test_tools::per_element());
+  BOOST_TEST(AsCodes(roundTrip.AllPhotons()) == AsCodes(flat.AllPhotons()),
+    boost::test_tools::per_element());
+  BOOST_TEST(roundTrip.Photons(7).empty());
+
+} // FlatSimPhotonsFromSimPhotonsTest()
+
+
+
+//------------------------------------------------------------------------------
+//--- registration of tests
+//
+
+BOOST_AUTO_TEST_CASE(FlatSimPhotonsFromChannels) {
+  FlatSimPhotonsFromChannelsTest();
+}
+
+BOOST_AUTO_TEST_CASE(FlatSimPhotonsFromSimPhotons) {
+  FlatSimPhotonsFromSimPhotonsTest();
+}
@@ -0,0 +1,260 @@
+/**
+ * @file    MergeSimCollections_test.cc
+ * @brief   Test of the merging of simulated channels and of their collections
+ * @see     lardataobj/Simulation/MergeSimCollections.h
+ *
+ * This test merges sim::AuxDetSimChannel, sim::SimChannel and
+ * sim::OpDetBacktrackerRecord objects and collections, and verifies the
+ * track ID offset, the rejection of different channels and the ordering of
+ * the results.
+ *
+ * See http://www.boost.org/libs/test for the Boost test library home page.
+ */
+
+// C/C++ standard library
+#include <algorithm> // std::is_sorted()
+#include <stdexcept> // std::runtime_error
+#include <utility> // std::pair
+#include <vector>
+
+
+// Boost libraries
+#define BOOST_TEST_MODULE ( mergesimcollections_test )
+#include "boost/test/unit_test.hpp"
+
+// LArSoft libraries
+#include "lardataobj/Simulation/MergeSimCollections.h"
+#include "lardataobj/Simulation/AuxDetSimChannel.h"
+#include "lardataobj/Simulation/OpDetBacktrackerRecord.h"
+#include "lardataobj/Simulation/SimChannel.h"
+
+
+
+//------------------------------------------------------------------------------
+//--- Test code
+//
+
+sim::AuxDetIDE MakeAuxDetIDE(int trackID, float energy) {
+  sim::AuxDetIDE ide;
+  ide.trackID = trackID;
+  ide.energyDeposited = energy;
+  return ide;
+} // MakeAuxDetIDE()
+
+
+void AddDeposit(sim::SimChannel& channel, int trackID, unsigned int tdc) {
+  double const xyz[3] = { 1.0, 2.0, 3.0 };
+  channel.AddIonizationElectrons(trackID, tdc, 100.0, xyz, 0.01);
+} // AddDeposit()
+
+
+void AddDeposit(sim::OpDetBacktrackerRecord& record, int trackID, double time) {
+  double const xyz[3] = { 1.0, 2.0, 3.0 };
+  record.AddScintillationPhotons(trackID, time, 10.0, xyz, 0.01);
+} // AddDeposit()
+
+
+/// Runs the tasks in reverse order (results must not depend on the order).
+struct ReverseForEach {
+  template <typename F>
+  void operator() (std::size_t n, F&& f) const
+    { for (std::size_t i = n; i > 0; --i) f(i - 1); }
+}; // ReverseForEach
+
+
+void AuxDetSimChannelMergeTest() {
+
+  sim::AuxDetSimChannel channel(1, { MakeAuxDetIDE(5, 1.f) }, 2);
+  sim::AuxDetSimChannel const other
+    (1, { MakeAuxDetIDE(3, 2.f), MakeAuxDetIDE(7, 3.f) }, 2);
+
+  // the deposits of the other channel are appended, with the offset
+  std::pair<int,int> const range = channel.MergeAuxDetSimChannel(other, 100);
+  BOOST_TEST(range.first == 103);
+  BOOST_TEST(range.second == 107);
+  auto const& IDEs = channel.AuxDetIDEs();
+  BOOST_TEST_REQUIRE(IDEs.size() == 3U);
+  BOOST_TEST(IDEs[0].trackID == 5);
+  BOOST_TEST(IDEs[1].trackID == 103);
+  BOOST_TEST(IDEs[1].energyDeposited == 2.f);
+  BOOST_TEST(IDEs[2].trackID == 107);
+  BOOST_TEST(IDEs[2].energyDeposited == 3.f);
+  BOOST_TEST(other.AuxDetIDEs().size() == 2U);
+
+  // channels differing in either ID are rejected
+  BOOST_CHECK_THROW(
+    channel.MergeAuxDetSimChannel(sim::AuxDetSimChannel(1, 3), 0),
+    std::runtime_error
+    );
+  BOOST_CHECK_THROW(
+    channel.MergeAuxDetSimChannel(sim::AuxDetSimChannel(2, 2), 0),
+    std::runtime_error
+    );
+  BOOST_TEST(channel.AuxDetIDEs().size() == 3U);
+
+} // AuxDetSimChannelMergeTest()
+
+
+void SimChannelMergeTest() {
+
+  sim::SimChannel channel(10);
+  AddDeposit(channel, 1, 10);
+  AddDeposit(channel, 2, 30);
+
+  sim::SimChannel other(10);
+  AddDeposit(other, 1, 5);
+  AddDeposit(other, 3, 10);
+  AddDeposit(other, 1, 40);
+
+  std::pair<int,int> const range = channel.MergeSimChannel(other, 50);
+  BOOST_TEST(range.first == 51);
+  BOOST_TEST(range.second == 53);
+
+  // ticks stay sorted; deposits on common ticks are appended with the offset
+  auto const& TDCIDEs = channel.TDCIDEMap();
+  BOOST_TEST_REQUIRE(TDCIDEs.size() == 4U);
+  BOOST_TEST(TDCIDEs[0].first == 5);
+  BOOST_TEST(TDCIDEs[1].first == 10);
+  BOOST_TEST(TDCIDEs[2].first == 30);
+  BOOST_TEST(TDCIDEs[3].first == 40);
+  BOOST_TEST_REQUIRE(TDCIDEs[1].second.size() == 2U);
+  BOOST_TEST(TDCIDEs[1].second[0].trackID == 1);
+  BOOST_TEST(TDCIDEs[1].second[1].trackID == 53);
+  BOOST_TEST(TDCIDEs[0].second.front().trackID == 51);
+  BOOST_TEST(TDCIDEs[2].second.front().trackID == 2);
+
+  BOOST_CHECK_THROW
+    (channel.MergeSimChannel(sim::SimChannel(11), 0), std::runtime_error);
+
+} // SimChannelMergeTest()
+
+
+void OpDetBacktrackerRecordMergeTest() {
+
+  sim::OpDetBacktrackerRecord record(4);
+  AddDeposit(record, 1, 100.0);
+  AddDeposit(record, 1, 300.0);
+
+  sim::OpDetBacktrackerRecord other(4);
+  AddDeposit(other, 2, 400.0);
+  AddDeposit(other, 2, 100.0);
+  AddDeposit(other, 3, 50.0);
+
+  std::pair<int,int> const range
+    = record.MergeOpDetBacktrackerRecord(other, 10);
+  BOOST_TEST(range.first == 12);
+  BOOST_TEST(range.second == 13);
+
+  auto const& SDPs = record.timePDclockSDPsMap();
+  BOOST_TEST_REQUIRE(SDPs.size() == 4U);
+  BOOST_TEST(SDPs[0].first == 50.0);
+  BOOST_TEST(SDPs[1].first == 100.0);
+  BOOST_TEST(SDPs[2].first == 300.0);
+  BOOST_TEST(SDPs[3].first == 400.0);
+  BOOST_TEST_REQUIRE(SDPs[1].second.size() == 2U);
+  BOOST_TEST(SDPs[1].second[0].trackID == 1);
+  BOOST_TEST(SDPs[1].second[1].trackID == 12);
+
+} // OpDetBacktrackerRecordMergeTest()
+
+
+template <typename ForEach>
+void MergeSimChannelsTest(ForEach forEach) {
+
+  std::vector<sim::SimChannel> dest;
+  for (raw::ChannelID_t channel: { 1U, 3U, 5U }) {
+    dest.emplace_back(channel);
+    AddDeposit(dest.back(), 1, 20);
+  }
+
+  std::vector<sim::SimChannel> src;
+  for (raw::ChannelID_t channel: { 4U, 1U, 6U, 0U, 1U }) {
+    src.emplace_back(channel);
+    AddDeposit(src.back(), static_cast<int>(channel) + 2, 10 + channel);
+  }
+
+  std::pair<int,int> const range
+    = sim::MergeSimChannels(dest, src, 1000, forEach);
+  BOOST_TEST(range.first == 1002);
+  BOOST_TEST(range.second == 1008);
+
+  // dest was sorted, and it is still sorted
+  BOOST_TEST_REQUIRE(dest.size() == 6U);
+  BOOST_TEST(std::is_sorted(dest.begin(), dest.end(),
+    [](auto const& a, auto const& b){ return a.Channel() < b.Channel(); }));
+  for (raw::ChannelID_t channel = 0; channel < 7; ++channel) {
+    if (channel == 2) continue;
+    BOOST_TEST(dest[channel - ((channel > 2)? 1: 0)].Channel() == channel);
+  }
+
+  // channel 1 received both source channels 1, in order
+  auto const& TDCIDEs = dest[1].TDCIDEMap();
+  BOOST_TEST_REQUIRE(TDCIDEs.size() == 2U);
+  BOOST_TEST(TDCIDEs[0].first == 11);
+  BOOST_TEST(TDCIDEs[1].first == 20);
+  BOOST_TEST_REQUIRE(TDCIDEs[0].second.size() == 2U);
+  BOOST_TEST(TDCIDEs[0].second[0].trackID == 1003);
+  BOOST_TEST(TDCIDEs[0].second[1].trackID == 1003);
+  BOOST_TEST(TDCIDEs[1].second.front().trackID == 1);
+
+  // a channel only in the source is copied with the offset
+  BOOST_TEST(dest[0].TDCIDEMap().front().second.front().trackID == 1002);
+
+} // MergeSimChannelsTest()
+
+
+void MergeAuxDetSimChannelsTest() {
+
+  std::vector<sim::AuxDetSimChannel> dest;
+  dest.emplace_back(1, std::vector<sim::AuxDetIDE>{ MakeAuxDetIDE(1, 1.f) }, 0);
+  dest.emplace_back(2, std::vector<sim::AuxDetIDE>{ MakeAuxDetIDE(2, 1.f) }, 1);
+
+  std::vector<sim::AuxDetSimChannel> src;
+  src.emplace_back(2, std::vector<sim::AuxDetIDE>{ MakeAuxDetIDE(3, 1.f) }, 0);
+  src.emplace_back(2, std::vector<sim::AuxDetIDE>{ MakeAuxDetIDE(4, 1.f) }, 1);
+
+  std::pair<int,int> const range = sim::MergeAuxDetSimChannels(dest, src, 10);
+  BOOST_TEST(range.first == 13);
+  BOOST_TEST(range.second == 14);
+
+  // the channel (2, 0) is new, and it is placed between the others
+  BOOST_TEST_REQUIRE(dest.size() == 3U);
+  BOOST_TEST(dest[0].AuxDetID() == 1U);
+  BOOST_TEST(dest[1].AuxDetID() == 2U);
+  BOOST_TEST(dest[1].AuxDetSensitiveID() == 0U);
+  BOOST_TEST(dest[2].AuxDetID() == 2U);
+  BOOST_TEST(dest[2].AuxDetSensitiveID() == 1U);
+  BOOST_TEST_REQUIRE(dest[1].AuxDetIDEs().size() == 1U);
+  BOOST_TEST(dest[1].AuxDetIDEs()[0].trackID == 13);
+  BOOST_TEST_REQUIRE(dest[2].AuxDetIDEs().size() == 2U);
+  BOOST_TEST(dest[2].AuxDetIDEs()[0].trackID == 2);
+  BOOST_TEST(dest[2].AuxDetIDEs()[1].trackID == 14);
+
+} // MergeAuxDetSimChannelsTest()
+
+
+
+//------------------------------------------------------------------------------
+//--- registration of tests
+//
+
+BOOST_AUTO_TEST_CASE(AuxDetSimChannelMerge) {
+  AuxDetSimChannelMergeTest();
+}
+
+BOOST_AUTO_TEST_CASE(SimChannelMerge) {
+  SimChannelMergeTest();
+}
+
+BOOST_AUTO_TEST_CASE(OpDetBacktrackerRecordMerge) {
+  OpDetBacktrackerRecordMergeTest();
+}
+
+BOOST_AUTO_TEST_CASE(MergeSimChannels) {
+  MergeSimChannelsTest(sim::SerialForEach{});
+  MergeSimChannelsTest(ReverseForEach{});
+}
+
+BOOST_AUTO_TEST_CASE(MergeAuxDetSimChannels) {
+  MergeAuxDetSimChannelsTest();
+}
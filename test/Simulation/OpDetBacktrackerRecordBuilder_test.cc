@@ -0,0 +1,248 @@
+/**
+ * @file    OpDetBacktrackerRecordBuilder_test.cc
+ * @brief   Test of sim::OpDetBacktrackerRecordBuilder against
+ *          sim::OpDetBacktrackerRecord
+ *
+ * This test adds the same random photon deposits to a
+ * sim::OpDetBacktrackerRecord one by one and through a
+ * sim::OpDetBacktrackerRecordBuilder, and verifies that the two records have
+ * exactly the same content, also when the builder extends an existing record
+ * with wider time bins.
+ *
+ * See http://www.boost.org/libs/test for the Boost test library home page.
+ */
+
+// C/C++ standard library
+#include <cmath> // std::round()
+#include <random>
+#include <set>
+#include <vector>
+
+
+// Boost libraries
+#define BOOST_TEST_MODULE ( opdetbacktrackerrecordbuilder_test )
+#include "boost/test/unit_test.hpp"
+
+// LArSoft libraries
+#include "lardataobj/Simulation/OpDetBacktrackerRecordBuilder.h"
+#include "lardataobj/Simulation/OpDetBacktrackerRecord.h"
+
+
+
+//------------------------------------------------------------------------------
+//--- Test code
+//
+
+/// A deposit, as passed to `AddScintillationPhotons()`.
+struct TestDeposit_t {
+  sim::OpDetBacktrackerRecord::TrackID_t trackID;
+  double time;
+  double numPhotons;
+  double xyz[3];
+  double energy;
+}; // TestDeposit_t
+
+
+/// Returns random deposits on a short time window, so that many are merged.
+std::vector<TestDeposit_t> MakeDeposits
+  (unsigned int nDeposits, unsigned int seed)
+{
+  std::mt19937 engine(seed);
+  std::uniform_int_distribution<int> trackDist(-3, 15);
+  std::uniform_real_distribution<double> timeDist(-20.0, 80.0);
+  std::uniform_real_distribution<double> photonDist(0.0, 50.0);
+  std::uniform_real_distribution<double> posDist(-100.0, 100.0);
+  std::uniform_real_distribution<double> energyDist(0.0, 0.1);
+
+  std::vector<TestDeposit_t> deposits;
+  deposits.reserve(nDeposits);
+  for (unsigned int i = 0; i < nDeposits; ++i) {
+    TestDeposit_t deposit;
+    deposit.trackID = trackDist(engine);
+    deposit.time = timeDist(engine);
+    deposit.numPhotons = photonDist(engine);
+    for (double& coord: deposit.xyz) coord = posDist(engine);
+    deposit.energy = energyDist(engine);
+    // some deposits are rejected
+    if (i % 101 == 0) deposit.numPhotons = 0.0;
+    if (i % 83 == 0) deposit.energy = 0.0;
+    deposits.push_back(deposit);
+  } // for
+  return deposits;
+} // MakeDeposits()
+
+
+/// Checks that the two records have exactly the same content.
+void CheckSameRecord(
+  sim::OpDetBacktrackerRecord const& record,
+  sim::OpDetBacktrackerRecord const& expected
+) {
+  BOOST_TEST(record.OpDetNum() == expected.OpDetNum());
+
+  auto const& timeSDPs = record.timePDclockSDPsMap();
+  auto const& expectedTimeSDPs = expected.timePDclockSDPsMap();
+  BOOST_TEST_REQUIRE(timeSDPs.size() == expectedTimeSDPs.size());
+  for (std::size_t iTime = 0; iTime < timeSDPs.size(); ++iTime) {
+    BOOST_TEST_CONTEXT("time entry #" << iTime) {
+      BOOST_TEST(timeSDPs[iTime].first == expectedTimeSDPs[iTime].first);
+      auto const& SDPs = timeSDPs[iTime].second;
+      auto const& expectedSDPs = expectedTimeSDPs[iTime].second;
+      BOOST_TEST_REQUIRE(SDPs.size() == expectedSDPs.size());
+      for (std::size_t iSDP = 0; iSDP < SDPs.size(); ++iSDP) {
+        BOOST_TEST(SDPs[iSDP].trackID == expectedSDPs[iSDP].trackID);
+        BOOST_TEST(SDPs[iSDP].numPhotons == expectedSDPs[iSDP].numPhotons);
+        BOOST_TEST(SDPs[iSDP].energy == expectedSDPs[iSDP].energy);
+        BOOST_TEST(SDPs[iSDP].x == expectedSDPs[iSDP].x);
+        BOOST_TEST(SDPs[iSDP].y == expectedSDPs[iSDP].y);
+        BOOST_TEST(SDPs[iSDP].z == expectedSDPs[iSDP].z);
+      } // for SDPs
+    } // context
+  } // for times
+} // CheckSameRecord()
+
+
+void BinnedTimeTest() {
+
+  sim::OpDetBacktrackerRecordBuilder const defaultBuilder(1);
+  BOOST_TEST(defaultBuilder.TimeBinWidth() == 1.0);
+  BOOST_TEST(defaultBuilder.BinnedTime(10.4) == 10.0);
+  BOOST_TEST(defaultBuilder.BinnedTime(10.6) == 11.0);
+  BOOST_TEST(defaultBuilder.BinnedTime(-2.7) == -3.0);
+
+  sim::OpDetBacktrackerRecordBuilder const wideBuilder(1, 2.0);
+  BOOST_TEST(wideBuilder.BinnedTime(2.9) == 2.0);
+  BOOST_TEST(wideBuilder.BinnedTime(3.1) == 4.0);
+  BOOST_TEST(wideBuilder.BinnedTime(7.0) == 8.0);
+
+  sim::OpDetBacktrackerRecordBuilder const noBinBuilder(1, 0.0);
+  BOOST_TEST(noBinBuilder.BinnedTime(3.1) == 3.1);
+
+} // BinnedTimeTest()
+
+
+void OpDetBacktrackerRecordBuilderRandomTest(unsigned int seed) {
+
+  // `AddScintillationPhotons()` stores the times rounded to the closest
+  // integer, and it finds the existing entries reliably only for integer
+  // times: the expected record is filled with the rounded times
+  constexpr int opDet = 12;
+  std::vector<TestDeposit_t> const deposits = MakeDeposits(5000, seed);
+
+  sim::OpDetBacktrackerRecord expected(opDet);
+  for (TestDeposit_t const& deposit: deposits) {
+    expected.AddScintillationPhotons(deposit.trackID, std::round(deposit.time),
+      deposit.numPhotons, deposit.xyz, deposit.energy);
+  }
+
+  sim::OpDetBacktrackerRecordBuilder builder(opDet);
+  builder.Reserve(deposits.size());
+  for (TestDeposit_t const& deposit: deposits) {
+    builder.AddScintillationPhotons(deposit.trackID, deposit.time,
+      deposit.numPhotons, deposit.xyz, deposit.energy);
+  }
+  sim::OpDetBacktrackerRecord const record = builder.Build();
+
+  CheckSameRecord(record, expected);
+
+  // the builder is left empty
+  BOOST_TEST(builder.NDeposits() == 0U);
+  BOOST_TEST(builder.OpDetNum() == opDet);
+  BOOST_TEST(builder.Build().timePDclockSDPsMap().empty());
+
+} // OpDetBacktrackerRecordBuilderRandomTest()
+
+
+void SeededBuilderTest(unsigned int seed) {
+
+  // the builder extends a record with 2 ns bins; the record has entries both
+  // at bin centers (even times) and between them (odd times), and only the
+  // former are extended
+  constexpr int opDet = 3;
+  constexpr double binWidth = 2.0;
+  std::vector<TestDeposit_t> const seedDeposits = MakeDeposits(500, seed);
+  std::vector<TestDeposit_t> const deposits = MakeDeposits(3000, seed + 1);
+
+  sim::OpDetBacktrackerRecord seedRecord(opDet);
+  for (TestDeposit_t const& deposit: seedDeposits) {
+    seedRecord.AddScintillationPhotons(deposit.trackID, std::round(deposit.time),
+      deposit.numPhotons, deposit.xyz, deposit.energy);
+  }
+
+  sim::OpDetBacktrackerRecord expected = seedRecord;
+  for (TestDeposit_t const& deposit: deposits) {
+    double const binnedTime
+      = std::round(deposit.time / binWidth) * binWidth;
+    expected.AddScintillationPhotons(deposit.trackID, binnedTime,
+      deposit.numPhotons, deposit.xyz, deposit.energy);
+  }
+
+  sim::OpDetBacktrackerRecordBuilder builder(seedRecord, binWidth);
+  BOOST_TEST(builder.TimeBinWidth() == binWidth);
+  for (TestDeposit_t const& deposit: deposits) {
+    builder.AddScintillationPhotons(deposit.trackID, deposit.time,
+      deposit.numPhotons, deposit.xyz, deposit.energy);
+  }
+  sim::OpDetBacktrackerRecord const record = builder.Build();
+
+  CheckSameRecord(record, expected);
+
+  // the odd entries are still there, and all the new ones are even
+  std::set<double> seedTimes;
+  for (auto const& timeSDPs: seedRecord.timePDclockSDPsMap())
+    seedTimes.insert(timeSDPs.first);
+  bool hasOdd = false;
+  for (auto const& timeSDPs: record.timePDclockSDPsMap()) {
+    double const time = timeSDPs.first;
+    bool const isOdd = (std::round(time / binWidth) * binWidth != time);
+    if (isOdd) BOOST_TEST(seedTimes.count(time) == 1U);
+    hasOdd |= isOdd;
+  }
+  BOOST_TEST(hasOdd);
+
+} // SeededBuilderTest()
+
+
+void NoBinningTest() {
+
+  // without binning, each distinct time has its own entry
+  std::vector<TestDeposit_t> const deposits = MakeDeposits(200, 5U);
+
+  sim::OpDetBacktrackerRecordBuilder builder(7, 0.0);
+  std::set<double> times;
+  for (TestDeposit_t const& deposit: deposits) {
+    builder.AddScintillationPhotons(deposit.trackID, deposit.time,
+      deposit.numPhotons, deposit.xyz, deposit.energy);
+    if ((deposit.numPhotons > 0.0) && (deposit.energy > 0.0))
+      times.insert(deposit.time);
+  }
+  sim::OpDetBacktrackerRecord const record = builder.Build();
+
+  auto const& timeSDPs = record.timePDclockSDPsMap();
+  BOOST_TEST_REQUIRE(timeSDPs.size() == times.size());
+  auto iTime = times.begin();
+  for (auto const& timeSDP: timeSDPs) BOOST_TEST(timeSDP.first == *(iTime++));
+
+} // NoBinningTest()
+
+
+
+//------------------------------------------------------------------------------
+//--- registration of tests
+//
+
+BOOST_AUTO_TEST_CASE(BinnedTime) {
+  BinnedTimeTest();
+}
+
+BOOST_AUTO_TEST_CASE(OpDetBacktrackerRecordBuilderRandom) {
+  OpDetBacktrackerRecordBuilderRandomTest(1U);
+  OpDetBacktrackerRecordBuilderRandomTest(161803U);
+}
+
+BOOST_AUTO_TEST_CASE(SeededBuilder) {
+  SeededBuilderTest(42U);
+}
+
+BOOST_AUTO_TEST_CASE(NoBinning) {
+  NoBinningTest();
+}
@@ -0,0 +1,171 @@
+/**
+ * @file    SimChannelBuilder_test.cc
+ * @brief   Test of sim::SimChannelBuilder against sim::SimChannel
+ *
+ * This test adds the same random energy deposits to a sim::SimChannel one by
+ * one and through a sim::SimChannelBuilder, and verifies that the two
+ * channels have exactly the same content.
+ *
+ * See http://www.boost.org/libs/test for the Boost test library home page.
+ */
+
+// C/C++ standard library
+#include <random>
+#include <vector>
+
+
+// Boost libraries
+#define BOOST_TEST_MODULE ( simchannelbuilder_test )
+#include "boost/test/unit_test.hpp"
+
+// LArSoft libraries
+#include "lardataobj/Simulation/SimChannelBuilder.h"
+#include "lardataobj/Simulation/SimChannel.h"
+
+
+
+//------------------------------------------------------------------------------
+//--- Test code
+//
+
+/// A deposit, as passed to `AddIonizationElectrons()`.
+struct TestDeposit_t {
+  sim::SimChannel::TrackID_t trackID;
+  sim::SimChannel::TDC_t tdc;
+  double numElectrons;
+  double xyz[3];
+  double energy;
+}; // TestDeposit_t
+
+
+/// Returns random deposits on few ticks and tracks, so that many are merged.
+std::vector<TestDeposit_t> MakeDeposits
+  (unsigned int nDeposits, unsigned int seed)
+{
+  std::mt19937 engine(seed);
+  std::uniform_int_distribution<int> trackDist(-5, 20);
+  std::uniform_int_distribution<unsigned int> tdcDist(100, 160);
+  std::uniform_real_distribution<double> electronDist(0.0, 1000.0);
+  std::uniform_real_distribution<double> posDist(-100.0, 100.0);
+  std::uniform_real_distribution<double> energyDist(0.0, 0.1);
+
+  std::vector<TestDeposit_t> deposits;
+  deposits.reserve(nDeposits);
+  for (unsigned int i = 0; i < nDeposits; ++i) {
+    TestDeposit_t deposit;
+    deposit.trackID = trackDist(engine);
+    deposit.tdc = tdcDist(engine);
+    deposit.numElectrons = electronDist(engine);
+    for (double& coord: deposit.xyz) coord = posDist(engine);
+    deposit.energy = energyDist(engine);
+    // some deposits are rejected
+    if (i % 97 == 0) deposit.numElectrons = 0.0;
+    if (i % 89 == 0) deposit.energy = 0.0;
+    deposits.push_back(deposit);
+  } // for
+  return deposits;
+} // MakeDeposits()
+
+
+/// Checks that the two channels have exactly the same content.
+void CheckSameChannel
+  (sim::SimChannel const& channel, sim::SimChannel const& expected)
+{
+  BOOST_TEST(channel.Channel() == expected.Channel());
+
+  auto const& TDCIDEs = channel.TDCIDEMap();
+  auto const& expectedTDCIDEs = expected.TDCIDEMap();
+  BOOST_TEST_REQUIRE(TDCIDEs.size() == expectedTDCIDEs.size());
+  for (std::size_t iTDC = 0; iTDC < TDCIDEs.size(); ++iTDC) {
+    BOOST_TEST_CONTEXT("TDC entry #" << iTDC) {
+      BOOST_TEST(TDCIDEs[iTDC].first == expectedTDCIDEs[iTDC].first);
+      auto const& IDEs = TDCIDEs[iTDC].second;
+      auto const& expectedIDEs = expectedTDCIDEs[iTDC].second;
+      BOOST_TEST_REQUIRE(IDEs.size() == expectedIDEs.size());
+      for (std::size_t iIDE = 0; iIDE < IDEs.size(); ++iIDE) {
+        BOOST_TEST(IDEs[iIDE].trackID == expectedIDEs[iIDE].trackID);
+        BOOST_TEST(IDEs[iIDE].numElectrons == expectedIDEs[iIDE].numElectrons);
+        BOOST_TEST(IDEs[iIDE].energy == expectedIDEs[iIDE].energy);
+        BOOST_TEST(IDEs[iIDE].x == expectedIDEs[iIDE].x);
+        BOOST_TEST(IDEs[iIDE].y == expectedIDEs[iIDE].y);
+        BOOST_TEST(IDEs[iIDE].z == expectedIDEs[iIDE].z);
+      } // for IDEs
+    } // context
+  } // for TDCs
+} // CheckSameChannel()
+
+
+void SimChannelBuilderRandomTest(unsigned int seed) {
+
+  constexpr raw::ChannelID_t channelID = 1234;
+  std::vector<TestDeposit_t> const deposits = MakeDeposits(5000, seed);
+
+  sim::SimChannel expected(channelID);
+  for (TestDeposit_t const& deposit: deposits) {
+    expected.AddIonizationElectrons(deposit.trackID, deposit.tdc,
+      deposit.numElectrons, deposit.xyz, deposit.energy);
+  }
+
+  sim::SimChannelBuilder builder(channelID);
+  builder.Reserve(deposits.size());
+  for (TestDeposit_t const& deposit: deposits) {
+    builder.AddIonizationElectrons(deposit.trackID, deposit.tdc,
+      deposit.numElectrons, deposit.xyz, deposit.energy);
+  }
+  sim::SimChannel const channel = builder.Build();
+
+  CheckSameChannel(channel, expected);
+
+  // the builder is left empty
+  BOOST_TEST(builder.NDeposits() == 0U);
+  BOOST_TEST(builder.Channel() == channelID);
+  BOOST_TEST(builder.Build().TDCIDEMap().empty());
+
+} // SimChannelBuilderRandomTest()
+
+
+void SimChannelBuilderExtendTest(unsigned int seed) {
+
+  // deposits are added in two steps, the second one to a filled channel
+  constexpr raw::ChannelID_t channelID = 42;
+  std::vector<TestDeposit_t> const deposits = MakeDeposits(2000, seed);
+  std::size_t const half = deposits.size() / 2;
+
+  sim::SimChannel expected(channelID);
+  for (TestDeposit_t const& deposit: deposits) {
+    expected.AddIonizationElectrons(deposit.trackID, deposit.tdc,
+      deposit.numElectrons, deposit.xyz, deposit.energy);
+  }
+
+  sim::SimChannel firstHalf(channelID);
+  for (std::size_t i = 0; i < half; ++i) {
+    TestDeposit_t const& deposit = deposits[i];
+    firstHalf.AddIonizationElectrons(deposit.trackID, deposit.tdc,
+      deposit.numElectrons, deposit.xyz, deposit.energy);
+  }
+
+  sim::SimChannelBuilder builder(firstHalf);
+  for (std::size_t i = half; i < deposits.size(); ++i) {
+    TestDeposit_t const& deposit = deposits[i];
+    builder.AddIonizationElectrons(deposit.trackID, deposit.tdc,
+      deposit.numElectrons, deposit.xyz, deposit.energy);
+  }
+
+  CheckSameChannel(builder.Build(), expected);
+
+} // SimChannelBuilderExtendTest()
+
+
+
+//------------------------------------------------------------------------------
+//--- registration of tests
+//
+
+BOOST_AUTO_TEST_CASE(SimChannelBuilderRandom) {
+  SimChannelBuilderRandomTest(1U);
+  SimChannelBuilderRandomTest(271828U);
+}
+
+BOOST_AUTO_TEST_CASE(SimChannelBuilderExtend) {
+  SimChannelBuilderExtendTest(314159U);
+}
@@ -0,0 +1,153 @@
+/**
+ * @file    SimChannelFill_test.cc
+ * @brief   Test of the per-tick extraction of charge and energy of
+ *          sim::SimChannel
+ *
+ * This test fills sim::SimChannel objects with random deposits, and compares
+ * every tick filled by `FillCharges()`, `FillEnergies()`, `FillChargeMatrix()`
+ * and `FillEnergyMatrix()` with `Charge()` and `Energy()`, on windows
+ * extending before and after the ticks with deposits.
+ *
+ * See http://www.boost.org/libs/test for the Boost test library home page.
+ */
+
+// C/C++ standard library
+#include <random>
+#include <vector>
+
+
+// Boost libraries
+#define BOOST_TEST_MODULE ( simchannelfill_test )
+#include "boost/test/unit_test.hpp"
+
+// LArSoft libraries
+#include "lardataobj/Simulation/SimChannel.h"
+
+
+
+//------------------------------------------------------------------------------
+//--- Test code
+//
+
+/// Returns a channel with random deposits in the ticks [ minTDC, maxTDC ].
+sim::SimChannel MakeChannel(
+  raw::ChannelID_t channelID, unsigned int nDeposits,
+  unsigned int minTDC, unsigned int maxTDC, unsigned int seed
+) {
+  std::mt19937 engine(seed);
+  std::uniform_int_distribution<int> trackDist(1, 10);
+  std::uniform_int_distribution<unsigned int> tdcDist(minTDC, maxTDC);
+  std::uniform_real_distribution<double> valueDist(0.5, 1000.0);
+
+  sim::SimChannel channel(channelID);
+  double const xyz[3] = { 1.0, 2.0, 3.0 };
+  for (unsigned int i = 0; i < nDeposits; ++i) {
+    channel.AddIonizationElectrons
+      (trackDist(engine), tdcDist(engine), valueDist(engine), xyz, valueDist(engine));
+  }
+  return channel;
+} // MakeChannel()
+
+
+/// Checks `nTicks` values from `charges` and `energies` against `channel`.
+void CheckTicks(
+  sim::SimChannel const& channel,
+  double const* charges, double const* energies,
+  std::size_t nTicks, sim::SimChannel::TDC_t startTDC
+) {
+  for (std::size_t i = 0; i < nTicks; ++i) {
+    sim::SimChannel::TDC_t const tdc = startTDC + i;
+    BOOST_TEST_CONTEXT("channel " << channel.Channel() << " TDC " << tdc) {
+      BOOST_TEST(charges[i] == channel.Charge(tdc));
+      BOOST_TEST(energies[i] == channel.Energy(tdc));
+    }
+  } // for
+} // CheckTicks()
+
+
+void SimChannelFillTest() {
+
+  sim::SimChannel const channel = MakeChannel(5, 400, 100, 180, 1U);
+
+  struct Window_t { std::size_t nTicks; sim::SimChannel::TDC_t startTDC; };
+  for (Window_t const window: {
+    Window_t{ 300U,   0U }, // includes all the deposits, and more
+    Window_t{  50U, 120U }, // within the deposits
+    Window_t{  40U,  80U }, // starting before the deposits
+    Window_t{  40U, 160U }, // ending after the deposits
+    Window_t{  20U,  50U }, // all before the deposits
+    Window_t{  20U, 500U }, // all after the deposits
+    Window_t{   1U, 140U }, // single tick
+    Window_t{   0U, 140U }  // no tick
+  }) {
+    BOOST_TEST_CONTEXT
+      ("window of " << window.nTicks << " ticks from " << window.startTDC)
+    {
+      // dirty buffers, one element longer than needed
+      std::vector<double> charges(window.nTicks + 1, -1.0);
+      std::vector<double> energies(window.nTicks + 1, -1.0);
+      channel.FillCharges(charges.data(), window.nTicks, window.startTDC);
+      channel.FillEnergies(energies.data(), window.nTicks, window.startTDC);
+      CheckTicks(channel, charges.data(), energies.data(),
+        window.nTicks, window.startTDC);
+      BOOST_TEST(charges.back() == -1.0); // not written
+      BOOST_TEST(energies.back() == -1.0);
+    } // context
+  } // for
+
+  // default start: tick 0
+  std::vector<double> charges(200, -1.0), energies(200, -1.0);
+  channel.FillCharges(charges.data(), charges.size());
+  channel.FillEnergies(energies.data(), energies.size());
+  CheckTicks(channel, charges.data(), energies.data(), charges.size(), 0U);
+
+  // empty channel
+  sim::SimChannel const empty(6);
+  charges.assign(20, -1.0);
+  energies.assign(20, -1.0);
+  empty.FillCharges(charges.data(), charges.size(), 10U);
+  empty.FillEnergies(energies.data(), energies.size(), 10U);
+  for (std::size_t i = 0; i < charges.size(); ++i) {
+    BOOST_TEST(charges[i] == 0.0);
+    BOOST_TEST(energies[i] == 0.0);
+  }
+
+} // SimChannelFillTest()
+
+
+void SimChannelMatrixTest() {
+
+  std::vector<sim::SimChannel> const channels {
+    MakeChannel(1, 200, 10, 50, 2U),
+    sim::SimChannel(2), // empty
+    MakeChannel(3, 100, 40, 90, 3U),
+    MakeChannel(4, 300, 0, 120, 4U)
+  };
+
+  constexpr std::size_t nTicks = 80U;
+  constexpr sim::SimChannel::TDC_t startTDC = 20U;
+  std::vector<double> charges(channels.size() * nTicks, -1.0);
+  std::vector<double> energies(channels.size() * nTicks, -1.0);
+  sim::FillChargeMatrix(channels, charges.data(), nTicks, startTDC);
+  sim::FillEnergyMatrix(channels, energies.data(), nTicks, startTDC);
+
+  for (std::size_t i = 0; i < channels.size(); ++i) {
+    CheckTicks(channels[i], charges.data() + i * nTicks,
+      energies.data() + i * nTicks, nTicks, startTDC);
+  }
+
+} // SimChannelMatrixTest()
+
+
+
+//------------------------------------------------------------------------------
+//--- registration of tests
+//
+
+BOOST_AUTO_TEST_CASE(SimChannelFill) {
+  SimChannelFillTest();
+}
+
+BOOST_AUTO_TEST_CASE(SimChannelMatrix) {
+  SimChannelMatrixTest();
+}
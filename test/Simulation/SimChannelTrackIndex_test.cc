@@ -0,0 +1,155 @@
+/**
+ * @file    SimChannelTrackIndex_test.cc
+ * @brief   Test of sim::SimChannelTrackIndex
+ *
+ * This test indexes random sim::SimChannel collections, in one go and in
+ * blocks of channels, and verifies the deposits of each track against a plain
+ * scan of the channels.
+ *
+ * See http://www.boost.org/libs/test for the Boost test library home page.
+ */
+
+// C/C++ standard library
+#include <algorithm> // std::min(), std::reverse()
+#include <map>
+#include <random>
+#include <stdexcept> // std::runtime_error
+#include <utility> // std::move()
+#include <vector>
+
+
+// Boost libraries
+#define BOOST_TEST_MODULE ( simchanneltrackindex_test )
+#include "boost/test/unit_test.hpp"
+
+// LArSoft libraries
+#include "lardataobj/Simulation/SimChannelTrackIndex.h"
+#include "lardataobj/Simulation/SimChannel.h"
+
+
+
+//------------------------------------------------------------------------------
+//--- Test code
+//
+
+using IDERef_t = sim::SimChannelTrackIndex::IDERef_t;
+using TrackID_t = sim::SimChannelTrackIndex::TrackID_t;
+
+
+/// Returns channels with random deposits; channel IDs are not sorted.
+std::vector<sim::SimChannel> MakeChannels
+  (unsigned int nChannels, unsigned int seed)
+{
+  std::mt19937 engine(seed);
+  std::uniform_int_distribution<int> nDepositDist(0, 40);
+  std::uniform_int_distribution<int> trackDist(-10, 50);
+  std::uniform_int_distribution<unsigned int> tdcDist(0, 30);
+  std::uniform_real_distribution<double> electronDist(1.0, 1000.0);
+
+  std::vector<sim::SimChannel> channels;
+  for (unsigned int i = 0; i < nChannels; ++i) {
+    sim::SimChannel channel((i * 7919U) % 1000U);
+    int const nDeposits = nDepositDist(engine);
+    for (int j = 0; j < nDeposits; ++j) {
+      double const xyz[3] = { 1.0, 2.0, 3.0 };
+      double const electrons = electronDist(engine);
+      channel.AddIonizationElectrons
+        (trackDist(engine), tdcDist(engine), electrons, xyz, electrons / 4e4);
+    }
+    channels.push_back(std::move(channel));
+  } // for
+  return channels;
+} // MakeChannels()
+
+
+/// Returns the deposits of each track, by channel, TDC and IDE position.
+std::map<TrackID_t, std::vector<IDERef_t>> ScanChannels
+  (std::vector<sim::SimChannel> const& channels)
+{
+  std::map<TrackID_t, std::vector<IDERef_t>> refs;
+  for (unsigned int iChannel = 0; iChannel < channels.size(); ++iChannel) {
+    auto const& TDCIDEs = channels[iChannel].TDCIDEMap();
+    for (unsigned int iTDC = 0; iTDC < TDCIDEs.size(); ++iTDC) {
+      auto const& IDEs = TDCIDEs[iTDC].second;
+      for (unsigned int iIDE = 0; iIDE < IDEs.size(); ++iIDE)
+        refs[IDEs[iIDE].trackID].push_back({ iChannel, iTDC, iIDE });
+    }
+  } // for
+  return refs;
+} // ScanChannels()
+
+
+void CheckIndex(
+  sim::SimChannelTrackIndex const& index,
+  std::map<TrackID_t, std::vector<IDERef_t>> const& expected
+) {
+  BOOST_TEST_REQUIRE(index.NTracks() == expected.size());
+  auto iTrackID = index.TrackIDs().begin();
+  for (auto const& [ trackID, expectedRefs ]: expected) {
+    BOOST_TEST_CONTEXT("track ID " << trackID) {
+      BOOST_TEST(*(iTrackID++) == trackID);
+      BOOST_TEST(index.HasTrack(trackID));
+      auto const refs = index.IDEs(trackID);
+      BOOST_TEST_REQUIRE(refs.size() == expectedRefs.size());
+      for (std::size_t i = 0; i < refs.size(); ++i) {
+        BOOST_TEST(refs[i].channel == expectedRefs[i].channel);
+        BOOST_TEST(refs[i].tdc == expectedRefs[i].tdc);
+        BOOST_TEST(refs[i].ide == expectedRefs[i].ide);
+        BOOST_TEST(index.GetIDE(refs[i]).trackID == trackID);
+      }
+    } // context
+  } // for
+  BOOST_TEST(!index.HasTrack(1000));
+  BOOST_TEST(index.IDEs(1000).empty());
+} // CheckIndex()
+
+
+void SimChannelTrackIndexTest(unsigned int seed) {
+
+  std::vector<sim::SimChannel> const channels = MakeChannels(300, seed);
+  auto const expected = ScanChannels(channels);
+
+  CheckIndex(sim::SimChannelTrackIndex{ channels }, expected);
+
+  // joined from blocks, including empty ones
+  for (std::size_t blockSize: { 1U, 7U, 64U, 1000U }) {
+    BOOST_TEST_CONTEXT("blocks of " << blockSize << " channels") {
+      std::vector<sim::SimChannelTrackIndex::Partial_t> partials;
+      partials.push_back
+        (sim::SimChannelTrackIndex::IndexChannels(channels, 0, 0));
+      for (std::size_t begin = 0; begin < channels.size(); begin += blockSize) {
+        std::size_t const end = std::min(begin + blockSize, channels.size());
+        partials.push_back
+          (sim::SimChannelTrackIndex::IndexChannels(channels, begin, end));
+      }
+      CheckIndex(sim::SimChannelTrackIndex{ channels, partials }, expected);
+
+      // blocks out of order are rejected
+      if (partials.size() > 2) {
+        std::reverse(partials.begin(), partials.end());
+        BOOST_CHECK_THROW(
+          (sim::SimChannelTrackIndex{ channels, partials }),
+          std::runtime_error
+          );
+      }
+    } // context
+  } // for
+
+  // blocks not covering all the channels are rejected
+  BOOST_CHECK_THROW((sim::SimChannelTrackIndex{ channels,
+    { sim::SimChannelTrackIndex::IndexChannels(channels, 0, 10) } }),
+    std::runtime_error
+    );
+
+} // SimChannelTrackIndexTest()
+
+
+
+//------------------------------------------------------------------------------
+//--- registration of tests
+//
+
+BOOST_AUTO_TEST_CASE(SimChannelTrackIndexRandom) {
+  SimChannelTrackIndexTest(1U);
+  SimChannelTrackIndexTest(2718U);
+}
@@ -0,0 +1,207 @@
+/**
+ * @file    SimDriftedElectronClusterBatch_test.cc
+ * @brief   Test of sim::SimDriftedElectronClusterBatch
+ *
+ * This test verifies the conversion of sim::SimDriftedElectronCluster
+ * collections to and from sim::SimDriftedElectronClusterBatch, and the drift
+ * time, widths and electrons of the clusters from
+ * `sim::SimDriftedElectronClusterBatch::DriftDeposits()` against values
+ * computed by hand.
+ *
+ * See http://www.boost.org/libs/test for the Boost test library home page.
+ */
+
+// C/C++ standard library
+#include <cmath> // std::log()
+#include <vector>
+
+
+// Boost libraries
+#define BOOST_TEST_MODULE ( simdriftedelectronclusterbatch_test )
+#include "boost/test/unit_test.hpp"
+
+// LArSoft libraries
+#include "lardataobj/Simulation/SimDriftedElectronClusterBatch.h"
+#include "lardataobj/Simulation/ColumnarSimEnergyDeposits.h"
+#include "lardataobj/Simulation/SimEnergyDeposit.h"
+#include "lardataobj/Simulation/SimDriftedElectronCluster.h"
+
+
+
+//------------------------------------------------------------------------------
+//--- Test code
+//
+
+/// Returns a point-like deposit at the specified position and time.
+sim::SimEnergyDeposit MakeDeposit
+  (int nElectrons, double x, double y, double z, double t, int trackID)
+{
+  geo::Point_t const pos { x, y, z };
+  return { 0, nElectrons, 0.0, 2.5, pos, pos, t, t, trackID, 11 };
+} // MakeDeposit()
+
+
+struct ExpectedCluster_t {
+  int nElectrons;
+  double time;
+  double finalX;
+  double widthX;
+  double widthYZ;
+}; // ExpectedCluster_t
+
+
+/// Checks the clusters in `batch` from `deposits` against `expected` ones.
+void CheckDrift(
+  sim::SimDriftedElectronClusterBatch const& batch,
+  sim::SimEnergyDepositCollection const& deposits,
+  std::vector<ExpectedCluster_t> const& expected
+) {
+  BOOST_TEST_REQUIRE(batch.size() == deposits.size());
+  BOOST_TEST_REQUIRE(expected.size() == deposits.size());
+  for (std::size_t i = 0; i < batch.size(); ++i) {
+    sim::SimEnergyDeposit const& dep = deposits[i];
+    ExpectedCluster_t const& exp = expected[i];
+    BOOST_TEST_CONTEXT("cluster #" << i) {
+      BOOST_TEST(batch.NumElectrons()[i] == exp.nElectrons);
+      BOOST_TEST(batch.Time()[i] == exp.time, boost::test_tools::tolerance(1e-9));
+      BOOST_TEST(batch.FinalX()[i] == exp.finalX);
+      BOOST_TEST(batch.WidthX()[i] == exp.widthX, boost::test_tools::tolerance(1e-6));
+      BOOST_TEST(batch.WidthY()[i] == exp.widthYZ, boost::test_tools::tolerance(1e-6));
+      BOOST_TEST(batch.WidthZ()[i] == exp.widthYZ, boost::test_tools::tolerance(1e-6));
+      // no drift on y and z
+      BOOST_TEST(batch.InitialX()[i] == dep.MidPointX());
+      BOOST_TEST(batch.InitialY()[i] == dep.MidPointY());
+      BOOST_TEST(batch.InitialZ()[i] == dep.MidPointZ());
+      BOOST_TEST(batch.FinalY()[i] == dep.MidPointY());
+      BOOST_TEST(batch.FinalZ()[i] == dep.MidPointZ());
+      BOOST_TEST(batch.Energy()[i] == dep.Energy());
+      BOOST_TEST(batch.TrackID()[i] == dep.TrackID());
+    } // context
+  } // for
+} // CheckDrift()
+
+
+void DriftDepositsTest() {
+
+  sim::SimEnergyDepositCollection const deposits {
+    MakeDeposit(1000,  50.0, 1.0, 2.0, 10.0, 1), // 50 cm from the anode at 100
+    MakeDeposit(1000,  98.0, 3.0, 4.0,  0.0, 2), //  2 cm from the anode at 100
+    MakeDeposit( 800, 100.0, 5.0, 6.0, 20.0, 3), // on the anode at 100
+    MakeDeposit( 600, 120.0, 7.0, 8.0, 30.0, 4)  // behind the anode at 100
+  };
+  sim::ColumnarSimEnergyDeposits const columns { deposits };
+
+  // drift at 0.1 cm/ns; 2 D t is 16 cm^2 (x) and 9 cm^2 (y, z) after 500 ns
+  sim::SimDriftedElectronClusterBatch::DriftParameters_t params {
+    100.0,  // anodeX
+    +1,     // driftDirection
+    0.1,    // driftVelocity
+    0.016,  // longDiffusion
+    0.009   // transDiffusion
+  };
+
+  // no lifetime: no loss of electrons
+  CheckDrift(
+    sim::SimDriftedElectronClusterBatch::DriftDeposits(columns, params),
+    deposits,
+    {
+      { 1000, 510.0, 100.0, 4.0, 3.0 },
+      { 1000,  20.0, 100.0, 0.8, 0.6 }, // 2 D t = 0.64 and 0.36 cm^2
+      {  800,  20.0, 100.0, 0.0, 0.0 },
+      {    0,  30.0, 100.0, 0.0, 0.0 }
+    }
+    );
+
+  // lifetime: half of the electrons are lost in 500 ns
+  params.lifetime = 500.0 / std::log(2.0);
+  CheckDrift(
+    sim::SimDriftedElectronClusterBatch::DriftDeposits(columns, params),
+    deposits,
+    {
+      { 500, 510.0, 100.0, 4.0, 3.0 },
+      { 973,  20.0, 100.0, 0.8, 0.6 }, // 1000 x 2^(-20/500) = 972.655
+      { 800,  20.0, 100.0, 0.0, 0.0 },
+      {   0,  30.0, 100.0, 0.0, 0.0 }
+    }
+    );
+
+  // anode at smaller x: only the deposit beyond it drifts
+  params.anodeX = 118.0;
+  params.driftDirection = -1;
+  params.lifetime = 0.0;
+  CheckDrift(
+    sim::SimDriftedElectronClusterBatch::DriftDeposits(columns, params),
+    deposits,
+    {
+      {    0,  10.0, 118.0, 0.0, 0.0 },
+      {    0,   0.0, 118.0, 0.0, 0.0 },
+      {    0,  20.0, 118.0, 0.0, 0.0 },
+      {  600,  50.0, 118.0, 0.8, 0.6 } // 2 cm: 20 ns
+    }
+    );
+
+  // no deposits, no clusters
+  BOOST_TEST(sim::SimDriftedElectronClusterBatch::DriftDeposits
+    (sim::ColumnarSimEnergyDeposits{}, params).empty());
+
+} // DriftDepositsTest()
+
+
+void ClusterConversionTest() {
+
+  std::vector<sim::SimDriftedElectronCluster> const clusters {
+    { 100, 1500.25, { 1.0, 2.0, 3.0 }, { 0.0, 2.0, 3.0 },
+      { 0.5, 0.25, 0.25 }, 1.5f, 7 },
+    { 200, 3.0e6, { -4.0, 5.5, -6.0 }, { 0.0, 5.5, -6.0 },
+      { 0.125, 0.75, 0.75 }, 0.25f, -3 },
+    { 0, 0.0, { 0.0, 0.0, 0.0 }, { 0.0, 0.0, 0.0 },
+      { 0.0, 0.0, 0.0 }, 0.0f, 0 }
+  };
+
+  sim::SimDriftedElectronClusterBatch batch { clusters };
+  BOOST_TEST_REQUIRE(batch.size() == clusters.size());
+
+  std::vector<sim::SimDriftedElectronCluster> const converted
+    = batch.MakeClusters();
+  BOOST_TEST_REQUIRE(converted.size() == clusters.size());
+  for (std::size_t i = 0; i < clusters.size(); ++i) {
+    sim::SimDriftedElectronCluster const& cluster = clusters[i];
+    sim::SimDriftedElectronCluster const single = batch.Cluster(i);
+    BOOST_TEST_CONTEXT("cluster #" << i) {
+      for (sim::SimDriftedElectronCluster const& c: { single, converted[i] }) {
+        BOOST_TEST(c.NumberOfElectrons() == cluster.NumberOfElectrons());
+        BOOST_TEST(c.Time() == cluster.Time());
+        BOOST_TEST((c.InitialPosition() == cluster.InitialPosition()));
+        BOOST_TEST((c.FinalPosition() == cluster.FinalPosition()));
+        BOOST_TEST((c.ClusterWidth() == cluster.ClusterWidth()));
+        BOOST_TEST(c.Energy() == cluster.Energy());
+        BOOST_TEST(c.TrackID() == cluster.TrackID());
+      } // for
+    } // context
+  } // for
+
+  // appending and resizing
+  batch.Add(clusters[1]);
+  BOOST_TEST(batch.size() == 4U);
+  BOOST_TEST(batch.Cluster(3).Time() == clusters[1].Time());
+  batch.Resize(5);
+  BOOST_TEST(batch.NumElectrons()[4] == 0);
+  BOOST_TEST(batch.WidthZ()[4] == 0.0f);
+  batch.Resize(1);
+  BOOST_TEST(batch.MakeClusters().size() == 1U);
+
+} // ClusterConversionTest()
+
+
+
+//------------------------------------------------------------------------------
+//--- registration of tests
+//
+
+BOOST_AUTO_TEST_CASE(DriftDeposits) {
+  DriftDepositsTest();
+}
+
+BOOST_AUTO_TEST_CASE(ClusterConversion) {
+  ClusterConversionTest();
+}
@@ -0,0 +1,124 @@
+/**
+ * @file    SimEnergyDeposit_test.cc
+ * @brief   Test of the storage of positions and times of sim::SimEnergyDeposit
+ *
+ * This test creates sim::SimEnergyDeposit objects with random steps, and
+ * verifies that the positions, stored in single precision, and the end time,
+ * stored as a single precision offset from the start time, are returned within
+ * the expected precision.
+ *
+ * See http://www.boost.org/libs/test for the Boost test library home page.
+ */
+
+// C/C++ standard library
+#include <cmath> // std::abs(), std::sqrt()
+#include <random>
+
+
+// Boost libraries
+#define BOOST_TEST_MODULE ( simenergydeposit_test )
+#include "boost/test/unit_test.hpp"
+
+// LArSoft libraries
+#include "lardataobj/Simulation/SimEnergyDeposit.h"
+
+
+
+//------------------------------------------------------------------------------
+//--- Test code
+//
+
+void SimEnergyDepositStorageTest(unsigned int seed) {
+
+  std::mt19937 engine(seed);
+  std::uniform_real_distribution<double> positionDist(-1000.0, 1000.0);
+  std::uniform_real_distribution<double> stepDist(-0.5, 0.5);
+  std::uniform_real_distribution<double> durationDist(0.0, 2.0);
+
+  // single precision on positions up to 10 m
+  double const positionTolerance = 1e-4; // cm
+  // precision on the end time is relative to the duration, not to the time
+  double const timeTolerance = 1e-6; // ns
+
+  for (double const startTime: { 0.0, 12.5, 1.0e6 + 0.125, 3.0e9 + 0.5 }) {
+    for (int i = 0; i < 100; ++i) {
+      geo::Point_t const start
+        { positionDist(engine), positionDist(engine), positionDist(engine) };
+      geo::Point_t const end {
+        start.X() + stepDist(engine),
+        start.Y() + stepDist(engine),
+        start.Z() + stepDist(engine)
+      };
+      double const endTime = startTime + durationDist(engine);
+
+      sim::SimEnergyDeposit const dep
+        { 100, 200, 0.25, 1.5, start, end, startTime, endTime, 5, 13 };
+
+      BOOST_TEST_CONTEXT("deposit #" << i << " at t=" << startTime) {
+        BOOST_TEST(std::abs(dep.Start().X() - start.X()) < positionTolerance);
+        BOOST_TEST(std::abs(dep.Start().Y() - start.Y()) < positionTolerance);
+        BOOST_TEST(std::abs(dep.Start().Z() - start.Z()) < positionTolerance);
+        BOOST_TEST(std::abs(dep.End().X() - end.X()) < positionTolerance);
+        BOOST_TEST(std::abs(dep.End().Y() - end.Y()) < positionTolerance);
+        BOOST_TEST(std::abs(dep.End().Z() - end.Z()) < positionTolerance);
+        BOOST_TEST(dep.StartX() == dep.Start().X());
+        BOOST_TEST(dep.EndZ() == dep.End().Z());
+
+        BOOST_TEST(std::abs(dep.MidPoint().X() - (start.X() + end.X()) / 2.0)
+          < positionTolerance);
+        BOOST_TEST(std::abs(dep.MidPoint().Y() - (start.Y() + end.Y()) / 2.0)
+          < positionTolerance);
+        BOOST_TEST(std::abs(dep.MidPoint().Z() - (start.Z() + end.Z()) / 2.0)
+          < positionTolerance);
+
+        double const dx = end.X() - start.X();
+        double const dy = end.Y() - start.Y();
+        double const dz = end.Z() - start.Z();
+        BOOST_TEST(std::abs(dep.StepLength() - std::sqrt(dx*dx + dy*dy + dz*dz))
+          < 2.0 * positionTolerance);
+
+        // start time is stored in double precision
+        BOOST_TEST(dep.StartT() == startTime);
+        BOOST_TEST(dep.T0() == startTime);
+        BOOST_TEST(std::abs(dep.EndT() - endTime) < timeTolerance);
+        BOOST_TEST(std::abs(dep.T1() - endTime) < timeTolerance);
+        BOOST_TEST(std::abs(dep.Time() - (startTime + endTime) / 2.0)
+          < timeTolerance);
+
+        BOOST_TEST(dep.NumPhotons() == 100);
+        BOOST_TEST(dep.NumElectrons() == 200);
+        BOOST_TEST(dep.Energy() == 1.5);
+        BOOST_TEST(dep.TrackID() == 5);
+        BOOST_TEST(dep.PdgCode() == 13);
+      } // context
+    } // for deposits
+  } // for start times
+
+} // SimEnergyDepositStorageTest()
+
+
+void SimEnergyDepositDefaultTest() {
+
+  sim::SimEnergyDeposit const dep;
+  BOOST_TEST(dep.Start().X() == 0.0);
+  BOOST_TEST(dep.End().Z() == 0.0);
+  BOOST_TEST(dep.StartT() == 0.0);
+  BOOST_TEST(dep.EndT() == 0.0);
+  BOOST_TEST(dep.StepLength() == 0.0);
+
+} // SimEnergyDepositDefaultTest()
+
+
+
+//------------------------------------------------------------------------------
+//--- registration of tests
+//
+
+BOOST_AUTO_TEST_CASE(SimEnergyDepositStorage) {
+  SimEnergyDepositStorageTest(1U);
+  SimEnergyDepositStorageTest(314U);
+}
+
+BOOST_AUTO_TEST_CASE(SimEnergyDepositDefault) {
+  SimEnergyDepositDefaultTest();
+}
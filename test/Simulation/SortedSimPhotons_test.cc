@@ -0,0 +1,212 @@
+/**
+ * @file    SortedSimPhotons_test.cc
+ * @brief   Test of sim::SortedSimPhotons and of the appending of sim::SimPhotons
+ *
+ * This test fills sim::SortedSimPhotons objects with random photons, many of
+ * them with equal time, and verifies their columns after sorting against a
+ * stable sort of the photons, their time queries, and the conversion back to
+ * sim::SimPhotons. It also verifies that `sim::SimPhotons::operator+=` and
+ * `sim::SimPhotons::Merge()` append the photons in order.
+ *
+ * See http://www.boost.org/libs/test for the Boost test library home page.
+ */
+
+// C/C++ standard library
+#include <algorithm> // std::stable_sort(), std::count_if()
+#include <random>
+#include <stdexcept> // std::runtime_error
+#include <vector>
+
+
+// Boost libraries
+#define BOOST_TEST_MODULE ( sortedsimphotons_test )
+#include "boost/test/unit_test.hpp"
+
+// LArSoft libraries
+#include "lardataobj/Simulation/SortedSimPhotons.h"
+#include "lardataobj/Simulation/SimPhotons.h"
+
+
+
+//------------------------------------------------------------------------------
+//--- Test code
+//
+
+/// Returns random photons; times are in few distinct values, positions unique.
+sim::SimPhotons MakePhotons(int channel, unsigned int nPhotons, unsigned int seed)
+{
+  std::mt19937 engine(seed);
+  std::uniform_int_distribution<int> timeDist(0, 20);
+  std::uniform_int_distribution<int> trackDist(1, 3);
+  std::uniform_real_distribution<float> energyDist(2e-9f, 4e-9f);
+  std::uniform_real_distribution<double> positionDist(-100.0, 100.0);
+
+  sim::SimPhotons photons { channel };
+  for (unsigned int i = 0; i < nPhotons; ++i) {
+    sim::OnePhoton photon;
+    photon.Time = timeDist(engine) * 2.5f; // exact in single precision
+    photon.MotherTrackID = trackDist(engine);
+    photon.Energy = energyDist(engine);
+    photon.InitialPosition
+      = geo::Point_t{ positionDist(engine), positionDist(engine), 1000.0 + i };
+    photons.push_back(photon);
+  }
+  return photons;
+} // MakePhotons()
+
+
+/// Checks that `sorted` has the same photons as `expected`, in the same order.
+void CheckPhotons
+  (sim::SortedSimPhotons const& sorted, std::vector<sim::OnePhoton> const& expected)
+{
+  BOOST_TEST_REQUIRE(sorted.size() == expected.size());
+  BOOST_TEST_REQUIRE(sorted.Times().size() == expected.size());
+  BOOST_TEST_REQUIRE(sorted.Energies().size() == expected.size());
+  BOOST_TEST_REQUIRE(sorted.MotherTrackIDs().size() == expected.size());
+  for (std::size_t i = 0; i < expected.size(); ++i) {
+    sim::OnePhoton const& photon = expected[i];
+    BOOST_TEST_CONTEXT("photon #" << i) {
+      BOOST_TEST(sorted.Times()[i] == photon.Time);
+      BOOST_TEST(sorted.Energies()[i] == photon.Energy);
+      BOOST_TEST(sorted.MotherTrackIDs()[i] == photon.MotherTrackID);
+      BOOST_TEST(sorted.Time(i) == photon.Time);
+      BOOST_TEST(sorted.Energy(i) == photon.Energy);
+      BOOST_TEST(sorted.MotherTrackID(i) == photon.MotherTrackID);
+      // double precision positions are stored without loss
+      BOOST_TEST(sorted.InitialPosition(i).X() == photon.InitialPosition.X());
+      BOOST_TEST(sorted.InitialPosition(i).Y() == photon.InitialPosition.Y());
+      BOOST_TEST(sorted.InitialPosition(i).Z() == photon.InitialPosition.Z());
+    }
+  } // for
+} // CheckPhotons()
+
+
+void SortedSimPhotonsTest() {
+
+  sim::SimPhotons const photons = MakePhotons(4, 500, 1U);
+
+  // photons are sorted by time, then track ID, in order of addition if equal
+  std::vector<sim::OnePhoton> expected(photons.begin(), photons.end());
+  std::stable_sort(expected.begin(), expected.end(),
+    [](sim::OnePhoton const& a, sim::OnePhoton const& b)
+      {
+        if (a.Time != b.Time) return a.Time < b.Time;
+        return a.MotherTrackID < b.MotherTrackID;
+      }
+    );
+
+  sim::SortedSimPhotons const sorted { photons };
+  BOOST_TEST(sorted.OpChannel() == 4);
+  BOOST_TEST(sorted.IsSorted());
+  CheckPhotons(sorted, expected);
+
+  // same when adding in pieces and sorting at the end
+  sim::SortedSimPhotons added { 4 };
+  BOOST_TEST(added.empty());
+  added.Add(photons.front());
+  BOOST_TEST(!added.IsSorted());
+  added.Add(sim::SimPhotons{ 4 }); // nothing
+  sim::SimPhotons rest { 4 };
+  rest.insert(rest.end(), photons.begin() + 1, photons.end());
+  added.Add(rest);
+  BOOST_CHECK_THROW(added.TimeRange(0.0f, 10.0f), std::runtime_error);
+  added.Sort();
+  BOOST_TEST(added.IsSorted());
+  CheckPhotons(added, expected);
+
+  // sorting again changes nothing
+  added.Sort();
+  CheckPhotons(added, expected);
+
+  // time queries on [ start, end [
+  for (float const start: { -1.0f, 0.0f, 2.5f, 7.5f, 10.0f, 49.0f, 50.0f, 60.0f }) {
+    for (float const end: { 0.0f, 5.0f, 7.5f, 12.5f, 50.0f, 51.0f }) {
+      BOOST_TEST_CONTEXT("time interval [ " << start << " ; " << end << " [") {
+        auto const inInterval = [start, end](sim::OnePhoton const& photon)
+          { return (photon.Time >= start) && (photon.Time < end); };
+        std::size_t const expectedCount
+          = std::count_if(expected.begin(), expected.end(), inInterval);
+        BOOST_TEST(sorted.CountInTime(start, end) == expectedCount);
+        if (expectedCount == 0) continue;
+        auto const [ first, last ] = sorted.TimeRange(start, end);
+        BOOST_TEST(last - first == expectedCount);
+        BOOST_TEST(inInterval(expected[first]));
+        BOOST_TEST(inInterval(expected[last - 1]));
+        if (first > 0) BOOST_TEST(!inInterval(expected[first - 1]));
+        if (last < expected.size()) BOOST_TEST(!inInterval(expected[last]));
+      } // context
+    } // for end
+  } // for start
+
+  // conversion back, in sorted order
+  sim::SimPhotons const converted = sorted.MakeSimPhotons();
+  BOOST_TEST(converted.OpChannel() == 4);
+  BOOST_TEST_REQUIRE(converted.size() == expected.size());
+  for (std::size_t i = 0; i < expected.size(); ++i) {
+    BOOST_TEST(converted[i].Time == expected[i].Time);
+    BOOST_TEST(converted[i].Energy == expected[i].Energy);
+    BOOST_TEST(converted[i].MotherTrackID == expected[i].MotherTrackID);
+    BOOST_TEST(converted[i].InitialPosition.Z() == expected[i].InitialPosition.Z());
+    BOOST_TEST(sorted.Photon(i).InitialPosition.X() == expected[i].InitialPosition.X());
+  }
+
+} // SortedSimPhotonsTest()
+
+
+void SimPhotonsAppendTest() {
+
+  std::vector<sim::SimPhotons> const pieces {
+    MakePhotons(2, 30, 2U),
+    sim::SimPhotons{ 2 }, // empty
+    MakePhotons(2, 1, 3U),
+    MakePhotons(2, 50, 4U)
+  };
+
+  // expected: all the photons, in order of piece and then of photon
+  std::vector<double> expected;
+  for (sim::SimPhotons const& piece: pieces)
+    for (sim::OnePhoton const& photon: piece)
+      expected.push_back(photon.InitialPosition.Z());
+  auto const positions = [](sim::SimPhotons const& photons)
+    {
+      std::vector<double> z;
+      for (sim::OnePhoton const& photon: photons)
+        z.push_back(photon.InitialPosition.Z());
+      return z;
+    };
+
+  sim::SimPhotons appended { 2 };
+  for (sim::SimPhotons const& piece: pieces) appended += piece;
+  BOOST_TEST(appended.OpChannel() == 2);
+  BOOST_TEST(positions(appended) == expected, boost::test_tools::per_element());
+
+  sim::SimPhotons merged { 2 };
+  merged.Merge(pieces.begin(), pieces.end());
+  BOOST_TEST(positions(merged) == expected, boost::test_tools::per_element());
+
+  // merging after existing photons, and merging nothing
+  sim::SimPhotons mergedAfter = pieces.front();
+  mergedAfter.Merge(pieces.begin() + 1, pieces.end());
+  mergedAfter.Merge(pieces.end(), pieces.end());
+  BOOST_TEST(positions(mergedAfter) == expected, boost::test_tools::per_element());
+
+  sim::SimPhotons const sum = pieces[0] + pieces[3];
+  BOOST_TEST_REQUIRE(sum.size() == pieces[0].size() + pieces[3].size());
+  BOOST_TEST(sum.front().InitialPosition.Z() == pieces[0].front().InitialPosition.Z());
+  BOOST_TEST(sum.back().InitialPosition.Z() == pieces[3].back().InitialPosition.Z());
+
+} // SimPhotonsAppendTest()
+
+
+
+//------------------------------------------------------------------------------
+//--- registration of tests
+//
+
+BOOST_AUTO_TEST_CASE(SortedSimPhotons) {
+  SortedSimPhotonsTest();
+}
+
+BOOST_AUTO_TEST_CASE(SimPhotonsAppend) {
+  SimPhotonsAppendTest();
+}
@@ -0,0 +1,258 @@
+/**
+ * @file    TrackIDEAccumulation_test.cc
+ * @brief   Test of the per-track accumulation of sim::SimChannel and
+ *          sim::OpDetBacktrackerRecord deposits
+ *
+ * This test fills sim::SimChannel and sim::OpDetBacktrackerRecord objects with
+ * random deposits, and compares the per-track sums of all the overloads of
+ * `TrackIDsAndEnergies()`, `TrackIDEs()` and `TrackSDPs()` in random time
+ * windows with a plain accumulation in a `std::map`. The overloads filling a
+ * container are called with containers left dirty by previous calls.
+ *
+ * See http://www.boost.org/libs/test for the Boost test library home page.
+ */
+
+// C/C++ standard library
+#include <algorithm> // std::min()
+#include <map>
+#include <random>
+#include <vector>
+
+
+// Boost libraries
+#define BOOST_TEST_MODULE ( trackideaccumulation_test )
+#include "boost/test/unit_test.hpp"
+
+// LArSoft libraries
+#include "lardataobj/Simulation/SimChannel.h"
+#include "lardataobj/Simulation/OpDetBacktrackerRecord.h"
+#include "lardataobj/Simulation/sim.h" // sim::NoParticleId
+
+
+
+//------------------------------------------------------------------------------
+//--- Test code
+//
+
+/// Accumulates the deposits in the inclusive window, as `std::map` by track.
+template <typename Deposit, typename Entries, typename Time, typename Merge>
+std::vector<Deposit> MapAccumulate
+  (Entries const& entries, Time start, Time end, Merge merge)
+{
+  std::vector<Deposit> result;
+  if (start > end) return result;
+  std::map<int, Deposit> byTrack;
+  for (auto const& [ time, deposits ]: entries) {
+    if ((time < start) || (time > end)) continue;
+    for (Deposit const& deposit: deposits) {
+      auto const it = byTrack.find(deposit.trackID);
+      if (it == byTrack.end()) byTrack[deposit.trackID] = deposit;
+      else merge(it->second, deposit);
+    }
+  } // for
+  for (auto const& entry: byTrack) result.push_back(entry.second);
+  return result;
+} // MapAccumulate()
+
+
+/// Reference for `sim::SimChannel::TrackIDsAndEnergies()`.
+std::vector<sim::IDE> ReferenceIDEs
+  (sim::SimChannel const& channel, unsigned int start, unsigned int end)
+{
+  return MapAccumulate<sim::IDE>(channel.TDCIDEMap(), start, end,
+    [](sim::IDE& sum, sim::IDE const& ide){
+      double const nel1 = sum.numElectrons;
+      double const nel2 = ide.numElectrons;
+      double const weight = nel1 + nel2;
+      sum.x = (ide.x*nel2 + sum.x*nel1)/weight;
+      sum.y = (ide.y*nel2 + sum.y*nel1)/weight;
+      sum.z = (ide.z*nel2 + sum.z*nel1)/weight;
+      sum.energy = double(sum.energy) + double(ide.energy);
+      sum.numElectrons = weight;
+    });
+} // ReferenceIDEs()
+
+
+/// Reference for `sim::OpDetBacktrackerRecord::TrackIDsAndEnergies()`.
+std::vector<sim::SDP> ReferenceSDPs
+  (sim::OpDetBacktrackerRecord const& record, double start, double end)
+{
+  return MapAccumulate<sim::SDP>(record.timePDclockSDPsMap(), start, end,
+    [](sim::SDP& sum, sim::SDP const& sdp){
+      double const nPh1 = sum.numPhotons;
+      double const nPh2 = sdp.numPhotons;
+      double const weight = nPh1 + nPh2;
+      sum.x = (sdp.x*nPh2 + sum.x*nPh1)/weight;
+      sum.y = (sdp.y*nPh2 + sum.y*nPh1)/weight;
+      sum.z = (sdp.z*nPh2 + sum.z*nPh1)/weight;
+      sum.numPhotons = weight;
+    });
+} // ReferenceSDPs()
+
+
+void CheckIDEs
+  (std::vector<sim::IDE> const& ides, std::vector<sim::IDE> const& expected)
+{
+  BOOST_TEST_REQUIRE(ides.size() == expected.size());
+  for (std::size_t i = 0; i < ides.size(); ++i) {
+    BOOST_TEST_CONTEXT("IDE #" << i) {
+      BOOST_TEST(ides[i].trackID == expected[i].trackID);
+      BOOST_TEST(ides[i].numElectrons == expected[i].numElectrons);
+      BOOST_TEST(ides[i].energy == expected[i].energy);
+      BOOST_TEST(ides[i].x == expected[i].x);
+      BOOST_TEST(ides[i].y == expected[i].y);
+      BOOST_TEST(ides[i].z == expected[i].z);
+    }
+  }
+} // CheckIDEs()
+
+
+void CheckSDPs
+  (std::vector<sim::SDP> const& sdps, std::vector<sim::SDP> const& expected)
+{
+  BOOST_TEST_REQUIRE(sdps.size() == expected.size());
+  for (std::size_t i = 0; i < sdps.size(); ++i) {
+    BOOST_TEST_CONTEXT("SDP #" << i) {
+      BOOST_TEST(sdps[i].trackID == expected[i].trackID);
+      BOOST_TEST(sdps[i].numPhotons == expected[i].numPhotons);
+      BOOST_TEST(sdps[i].energy == expected[i].energy);
+      BOOST_TEST(sdps[i].x == expected[i].x);
+      BOOST_TEST(sdps[i].y == expected[i].y);
+      BOOST_TEST(sdps[i].z == expected[i].z);
+    }
+  }
+} // CheckSDPs()
+
+
+/// Checks the per-track fractions of `amount` against the ones from `deposits`.
+template <typename TrackDeposit, typename Deposit, typename Amount>
+void CheckTrackDeposits(
+  std::vector<TrackDeposit> const& trackDeposits,
+  std::vector<Deposit> const& deposits, Amount amount
+) {
+  double total = 0.;
+  for (Deposit const& deposit: deposits) total += amount(deposit);
+  if (total < 1.e-5) total = 1.;
+
+  std::size_t i = 0;
+  for (Deposit const& deposit: deposits) {
+    if (deposit.trackID == sim::NoParticleId) continue;
+    BOOST_TEST_REQUIRE(i < trackDeposits.size());
+    BOOST_TEST(trackDeposits[i].trackID == deposit.trackID);
+    BOOST_TEST(trackDeposits[i].energyFrac == float(amount(deposit) / total));
+    ++i;
+  } // for
+  BOOST_TEST(trackDeposits.size() == i);
+} // CheckTrackDeposits()
+
+
+void SimChannelAccumulationTest(unsigned int seed) {
+
+  std::mt19937 engine(seed);
+  std::uniform_int_distribution<int> trackDist(-5, 30);
+  std::uniform_int_distribution<unsigned int> tdcDist(0, 60);
+  std::uniform_real_distribution<double> valueDist(0.5, 1000.0);
+
+  sim::SimChannel channel(7);
+  for (int i = 0; i < 500; ++i) {
+    double const xyz[3]
+      = { valueDist(engine), valueDist(engine), valueDist(engine) };
+    int const trackID = (i % 50 == 0)? sim::NoParticleId: trackDist(engine);
+    channel.AddIonizationElectrons
+      (trackID, tdcDist(engine), valueDist(engine), xyz, valueDist(engine));
+  }
+
+  // containers reused through all the calls, starting dirty
+  std::vector<sim::IDE> ides(20, sim::IDE{ 99, 1.f, 2.f, 3.f, 4.f, 5.f });
+  std::vector<sim::IDE> work(3);
+  std::vector<sim::TrackIDE> trackIDEs(5, sim::TrackIDE{ 99, 1.f, 2.f, 3.f });
+
+  for (int iWindow = 0; iWindow < 50; ++iWindow) {
+    unsigned int const start = tdcDist(engine);
+    unsigned int const end = (iWindow % 10 == 9)
+      ? ((start > 0)? start - 1: 0) // bogus or single-tick window
+      : std::min(start + tdcDist(engine) / 2, 70U);
+    BOOST_TEST_CONTEXT("window [ " << start << " ; " << end << " ]") {
+      std::vector<sim::IDE> const expected = ReferenceIDEs(channel, start, end);
+
+      CheckIDEs(channel.TrackIDsAndEnergies(start, end), expected);
+      std::vector<sim::IDE> const& filled
+        = channel.TrackIDsAndEnergies(start, end, ides);
+      BOOST_TEST(&filled == &ides);
+      CheckIDEs(ides, expected);
+
+      auto const energy = [](sim::IDE const& ide){ return double(ide.energy); };
+      CheckTrackDeposits(channel.TrackIDEs(start, end), expected, energy);
+      std::vector<sim::TrackIDE> const& filledTracks
+        = channel.TrackIDEs(start, end, trackIDEs, work);
+      BOOST_TEST(&filledTracks == &trackIDEs);
+      CheckTrackDeposits(trackIDEs, expected, energy);
+    } // context
+  } // for windows
+
+} // SimChannelAccumulationTest()
+
+
+void OpDetBacktrackerRecordAccumulationTest(unsigned int seed) {
+
+  std::mt19937 engine(seed);
+  std::uniform_int_distribution<int> trackDist(-5, 30);
+  std::uniform_int_distribution<int> timeDist(0, 60);
+  std::uniform_real_distribution<double> valueDist(0.5, 1000.0);
+
+  sim::OpDetBacktrackerRecord record(3);
+  for (int i = 0; i < 500; ++i) {
+    double const xyz[3]
+      = { valueDist(engine), valueDist(engine), valueDist(engine) };
+    int const trackID = (i % 50 == 0)? sim::NoParticleId: trackDist(engine);
+    // integral times, which AddScintillationPhotons() matches exactly
+    record.AddScintillationPhotons
+      (trackID, timeDist(engine), valueDist(engine), xyz, valueDist(engine));
+  }
+
+  // containers reused through all the calls, starting dirty
+  std::vector<sim::SDP> sdps(20, sim::SDP{ 99, 1.f, 2.f, 3.f, 4.f, 5.f });
+  std::vector<sim::SDP> work(3);
+  std::vector<sim::TrackSDP> trackSDPs(5, sim::TrackSDP{ 99, 1.f, 2.f });
+
+  for (int iWindow = 0; iWindow < 50; ++iWindow) {
+    double const start = timeDist(engine) - 0.5;
+    double const end = (iWindow % 10 == 9)
+      ? start - 1.0 // bogus window
+      : start + timeDist(engine) / 2;
+    BOOST_TEST_CONTEXT("window [ " << start << " ; " << end << " ]") {
+      std::vector<sim::SDP> const expected = ReferenceSDPs(record, start, end);
+
+      CheckSDPs(record.TrackIDsAndEnergies(start, end), expected);
+      std::vector<sim::SDP> const& filled
+        = record.TrackIDsAndEnergies(start, end, sdps);
+      BOOST_TEST(&filled == &sdps);
+      CheckSDPs(sdps, expected);
+
+      auto const numPhotons
+        = [](sim::SDP const& sdp){ return double(sdp.numPhotons); };
+      CheckTrackDeposits(record.TrackSDPs(start, end), expected, numPhotons);
+      std::vector<sim::TrackSDP> const& filledTracks
+        = record.TrackSDPs(start, end, trackSDPs, work);
+      BOOST_TEST(&filledTracks == &trackSDPs);
+      CheckTrackDeposits(trackSDPs, expected, numPhotons);
+    } // context
+  } // for windows
+
+} // OpDetBacktrackerRecordAccumulationTest()
+
+
+
+//------------------------------------------------------------------------------
+//--- registration of tests
+//
+
+BOOST_AUTO_TEST_CASE(SimChannelAccumulation) {
+  SimChannelAccumulationTest(1U);
+  SimChannelAccumulationTest(314U);
+}
+
+BOOST_AUTO_TEST_CASE(OpDetBacktrackerRecordAccumulation) {
+  OpDetBacktrackerRecordAccumulationTest(1U);
+  OpDetBacktrackerRecordAccumulationTest(314U);
+}
@@ -0,0 +1,82 @@
+/**
+ * @file    IteratorRange_test.cc
+ * @brief   Tests util::IteratorRange on pointers and forward iterators
+ *
+ * See http://www.boost.org/libs/test for the Boost test library home page.
+ */
+
+// C/C++ standard library
+#include <forward_list>
+#include <iterator> // std::next()
+#include <vector>
+
+
+// Boost libraries
+#define BOOST_TEST_MODULE ( iteratorrange_test )
+#include "boost/test/unit_test.hpp"
+
+// LArSoft libraries
+#include "lardataobj/Utilities/IteratorRange.h"
+
+
+
+//------------------------------------------------------------------------------
+//--- Test code
+//
+
+void PointerRangeTest() {
+
+  std::vector<int> const data { 1, 2, 3, 4, 5 };
+
+  util::IteratorRange<int const*> const empty;
+  BOOST_TEST(empty.empty());
+  BOOST_TEST(empty.size() == 0U);
+  BOOST_TEST(empty.begin() == nullptr);
+
+  util::IteratorRange<int const*> const range
+    { data.data() + 1, data.data() + 4 };
+  BOOST_TEST(!range.empty());
+  BOOST_TEST(range.size() == 3U);
+  BOOST_TEST(range[0] == 2);
+  BOOST_TEST(range[2] == 4);
+  BOOST_TEST(&range[1] == data.data() + 2); // no copy
+
+  std::vector<int> const copy(range.begin(), range.end());
+  BOOST_TEST(copy == (std::vector<int>{ 2, 3, 4 }),
+    boost::test_tools::per_element());
+
+} // PointerRangeTest()
+
+
+void ForwardRangeTest() {
+
+  std::forward_list<int> const data { 1, 2, 3, 4, 5 };
+
+  util::IteratorRange<std::forward_list<int>::const_iterator> const range
+    { std::next(data.begin()), data.end() };
+  BOOST_TEST(!range.empty());
+  BOOST_TEST(range.size() == 4U);
+
+  int expected = 2;
+  for (int value: range) BOOST_TEST(value == expected++);
+
+  util::IteratorRange<std::forward_list<int>::const_iterator> const none
+    { data.end(), data.end() };
+  BOOST_TEST(none.empty());
+  BOOST_TEST(none.size() == 0U);
+
+} // ForwardRangeTest()
+
+
+
+//------------------------------------------------------------------------------
+//--- registration of tests
+//
+
+BOOST_AUTO_TEST_CASE(PointerRange) {
+  PointerRangeTest();
+}
+
+BOOST_AUTO_TEST_CASE(ForwardRange) {
+  ForwardRangeTest();
+}
@@ -16,6 +16,9 @@
 
 // C/C++ standard libraries
 #include <stdexcept> // std::out_of_range
+#if __has_include(<memory_resource>)
+#  include <memory_resource> // std::pmr::monotonic_buffer_resource
+#endif
 
 
 //------------------------------------------------------------------------------
@@ -405,6 +408,50 @@ void TestLazyVector_sizeConstructed() {
 } // TestLazyVector_sizeConstructed()
 
 
+//------------------------------------------------------------------------------
+#if __has_include(<memory_resource>)
+void TestLazyVector_memoryResource() {
+
+  /// Memory resource keeping track of how much was allocated through it.
+  class CountingResource: public std::pmr::memory_resource {
+    std::pmr::memory_resource* upstream = std::pmr::new_delete_resource();
+      public:
+    std::size_t allocated = 0U;
+    std::size_t deallocated = 0U;
+      private:
+    void* do_allocate(std::size_t bytes, std::size_t align) override
+      { allocated += bytes; return upstream->allocate(bytes, align); }
+    void do_deallocate(void* p, std::size_t bytes, std::size_t align) override
+      { deallocated += bytes; upstream->deallocate(p, bytes, align); }
+    bool do_is_equal(std::pmr::memory_resource const& other) const noexcept override
+      { return this == &other; }
+  }; // CountingResource
+
+  CountingResource resource;
+  {
+    util::pmr::LazyVector<double> v(6U, -1.0, &resource);
+    BOOST_TEST(v.get_allocator().resource() == &resource);
+    BOOST_TEST(v.data_size() == 0U);
+    BOOST_TEST(resource.allocated == 0U);
+
+    v[2] = 2.0;
+    v[4] = 4.0;
+    BOOST_TEST(v.data_size() == 3U);
+    BOOST_TEST(v.at(3U) == -1.0);
+    BOOST_TEST(v.at(4U) == 4.0);
+    BOOST_TEST(resource.allocated >= 3U * sizeof(double));
+
+    util::pmr::LazyVector<double> w(4U, &resource);
+    w[1] = 1.0;
+    BOOST_TEST(w.at(0U) == w.data_defvalue());
+    BOOST_TEST(w.at(1U) == 1.0);
+  }
+  BOOST_TEST(resource.deallocated == resource.allocated);
+
+} // TestLazyVector_memoryResource()
+#endif // __has_include(<memory_resource>)
+
+
 //------------------------------------------------------------------------------
 void TestLazyVector_documentation_class() {
 
@@ -503,6 +550,9 @@ BOOST_AUTO_TEST_CASE(LazyVectorTestCase) {
   //
   TestLazyVector_defaultConstructed();
   TestLazyVector_sizeConstructed();
+#if __has_include(<memory_resource>)
+  TestLazyVector_memoryResource();
+#endif
 
   //
   // documentation tests
@@ -21,6 +21,10 @@
 #include <utility> // std::make_pair()
 #include <sstream>
 #include <stdexcept> // std::out_of_range
+#include <vector>
+#if __has_include(<memory_resource>)
+#  include <memory_resource> // std::pmr::monotonic_buffer_resource
+#endif
 
 // LArSoft (larcore) libraries
 #include "lardataobj/Utilities/sparse_vector.h"
@@ -1005,6 +1009,113 @@ namespace actions {
   }; // Optimize<>
 
 
+  /// Checks cursor look-ups against the direct ones (does not change data).
+  template <typename T>
+  class CursorLookup: public BaseAction<T> {
+      public:
+    using Base_t = BaseAction<T>;
+    using typename Base_t::TestClass_t;
+    using typename Base_t::Data_t;
+    using typename Base_t::Vector_t;
+    using typename Base_t::SparseVector_t;
+
+      protected:
+    virtual void doDescribe(TestClass_t&, std::ostream& out) const override
+      { out << "look up all elements with a cursor"; }
+
+    virtual void actionOnSparseVector(SparseVector_t& v) const override
+      {
+        if (v.empty()) return;
+        auto cursor = v.make_cursor();
+        std::size_t const n = v.size();
+        // forward, backward, then jumping back and forth
+        std::vector<std::size_t> indices;
+        for (std::size_t i = 0; i < n; ++i) indices.push_back(i);
+        for (std::size_t i = n; i-- > 0;) indices.push_back(i);
+        for (std::size_t i = 0; i < n; ++i)
+          indices.push_back((i % 2 == 0)? i / 2: n - 1 - i / 2);
+
+        for (std::size_t i: indices) {
+          bool const bVoid = v.get_ranges().empty()? true: v.is_void(i);
+          bool const cVoid = v.get_ranges().empty()? true: cursor.is_void(i);
+          bool bad = (cursor[i] != v[i]) || (bVoid != cVoid);
+          if (!v.get_ranges().empty())
+            bad |= (cursor.find_range_iterator(i) != v.find_range_iterator(i));
+          if (!bad) continue;
+          std::cout << "   cursor look-up mismatch at position " << i
+            << std::endl;
+          // make the failure visible to the test manager
+          v.set_at(i, v[i] + Data_t(1));
+          return;
+        } // for
+      }
+
+  }; // CursorLookup<>
+
+
+  /// Rebuilds the vector from its dense content, keeping values above threshold.
+  template <typename T>
+  class FromDense: public BaseAction<T> {
+      public:
+    using Base_t = BaseAction<T>;
+    using typename Base_t::TestClass_t;
+    using typename Base_t::Data_t;
+    using typename Base_t::Vector_t;
+    using typename Base_t::SparseVector_t;
+
+    Data_t threshold;
+    std::size_t padding;
+    bool useMask; ///< whether to use `from_dense_mask()` instead
+
+    FromDense(Data_t thr, std::size_t pad = 0, bool mask = false)
+      : threshold(thr), padding(pad), useMask(mask) {}
+
+      protected:
+    virtual void doDescribe(TestClass_t&, std::ostream& out) const override
+      {
+        out << "rebuild from dense data " << (useMask? "with a mask ": "")
+          << "above " << threshold << " with padding " << padding;
+      }
+
+    /// Returns which elements are above threshold.
+    std::vector<char> selection(Vector_t const& v) const
+      {
+        std::vector<char> selected(v.size());
+        for (std::size_t i = 0; i < v.size(); ++i)
+          selected[i] = !SparseVector_t::is_zero(v[i], threshold);
+        return selected;
+      }
+
+    virtual void actionOnVector(Vector_t& v) const override
+      {
+        std::vector<char> const selected = selection(v);
+        std::vector<char> kept(v.size(), 0);
+        for (std::size_t i = 0; i < v.size(); ++i) {
+          if (!selected[i]) continue;
+          std::size_t const first = (i > padding)? i - padding: 0;
+          std::size_t const last = std::min(i + padding + 1, v.size());
+          std::fill(kept.begin() + first, kept.begin() + last, 1);
+        } // for
+        for (std::size_t i = 0; i < v.size(); ++i) if (!kept[i]) v[i] = 0;
+      }
+
+    virtual void actionOnSparseVector(SparseVector_t& v) const override
+      {
+        Vector_t const dense(v.begin(), v.end());
+        if (useMask) {
+          std::vector<char> const selected = selection(dense);
+          v = SparseVector_t::from_dense_mask
+            (dense.begin(), dense.end(), selected.begin(), padding);
+        }
+        else {
+          v = SparseVector_t::from_dense
+            (dense.begin(), dense.end(), threshold, padding);
+        }
+      }
+
+  }; // FromDense<>
+
+
   template <typename T>
   class FailTest: public BaseAction<T> {
       public:
@@ -1097,6 +1208,60 @@ ITER actions::BaseAction<T>::findVoidStart
 } // actions::BaseAction::findVoidStart()
 
 
+//------------------------------------------------------------------------------
+
+/// Exercises a sparse vector drawing its memory from a memory resource.
+template <typename T>
+unsigned int MemoryResourceTest(std::ostream& out = std::cout) {
+#if __has_include(<memory_resource>)
+
+  std::pmr::monotonic_buffer_resource arena;
+  std::pmr::memory_resource* const resource = &arena;
+
+  lar::pmr::sparse_vector<T> sv(20, resource);
+  sv.add_range(2, { T(2), T(3), T(4) });
+  sv.set_at(8, T(8));
+  sv.add_range(6, { T(6), T(7) }); // merges with the element at 8
+  sv.set_at(10, T(10));
+  sv.unset_at(3);                  // splits the first range
+  sv.make_void(std::next(sv.begin(), 9), std::next(sv.begin(), 11));
+  std::vector<T> expected
+    = { 0, 0, 2, 0, 4, 0, 6, 7, 8, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 };
+
+  // copy with an explicit allocator
+  lar::pmr::sparse_vector<T> const copy(sv, resource);
+
+  unsigned int nErrors = 0;
+  if (!std::equal(sv.begin(), sv.end(), expected.begin(), expected.end())) {
+    out << "Memory resource test: unexpected content ";
+    PrintVector(sv, out) << std::endl;
+    ++nErrors;
+  }
+  if (!std::equal(copy.begin(), copy.end(), sv.begin(), sv.end())) {
+    out << "Memory resource test: unexpected content of the copy ";
+    PrintVector(copy, out) << std::endl;
+    ++nErrors;
+  }
+  for (auto const& range: sv.get_ranges()) {
+    if (range.data().get_allocator().resource() == resource) continue;
+    out << "Memory resource test: range at " << range.begin_index()
+      << " does not use the memory resource" << std::endl;
+    ++nErrors;
+  } // for
+  if (copy.get_allocator().resource() != resource) {
+    out << "Memory resource test: copy does not use the memory resource"
+      << std::endl;
+    ++nErrors;
+  }
+
+  return nErrors;
+#else // no <memory_resource>
+  out << "Memory resources not supported: test skipped." << std::endl;
+  return 0;
+#endif // __has_include(<memory_resource>)
+} // MemoryResourceTest()
+
+
 //------------------------------------------------------------------------------
 
 /// A simple test suite
@@ -1157,6 +1322,8 @@ int main() {
 
   Test(actions::Erase<Data_t>(21, 23));
 
+  Test(actions::CursorLookup<Data_t>());
+
   Test(actions::PrintSparseVector<Data_t>());
 
   for (size_t i = 0; i < Test.current_vector_size(); ++i)
@@ -1201,6 +1368,8 @@ int main() {
 
   Test(actions::PrintNonVoid<Data_t>());
 
+  Test(actions::CursorLookup<Data_t>());
+
   Test(actions::Optimize<Data_t>(-1));
 
   // at this point:
@@ -1282,11 +1451,38 @@ int main() {
 
   Test(actions::Truncate<Data_t>(2));
 
+  // many short ranges, so that the cursor has room to gallop
+  Test(actions::Resize<Data_t>(80));
+  for (size_t i = 3; i < 80; i += 5)
+    Test(actions::Insert<Data_t>(i, { Data_t(i), Data_t(i + 1) }));
+
+  Test(actions::CursorLookup<Data_t>());
+
+  // bulk construction from dense data
+  Test(actions::Assign<Data_t>({
+     0,  0,  3,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  1,
+     2, -4,  5,  1,  0,  1, -1,  0,  0,  0,  0,  0,  0,  0,  0,  0,  6,  0,
+     0,  0,  0,  0,  0,  0, -7
+    }));
+  Test(actions::FromDense<Data_t>(10));
+  Test(actions::Assign<Data_t>({
+     0,  0,  3,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  1,
+     2, -4,  5,  1,  0,  1, -1,  0,  0,  0,  0,  0,  0,  0,  0,  0,  6,  0,
+     0,  0,  0,  0,  0,  0, -7
+    }));
+  Test(actions::FromDense<Data_t>(0));
+  Test(actions::FromDense<Data_t>(1, 2));
+  Test(actions::FromDense<Data_t>(2, 3, true));
+  Test(actions::CursorLookup<Data_t>());
+  Test(actions::FromDense<Data_t>(3, 100));
+
 #ifdef SPARSE_VECTOR_TEST_FAIL
   // enable this to verify that the error detection works
   Test(actions::FailTest<Data_t>());
   Test.recover();
 #endif // SPARSE_VECTOR_TEST_FAIL
 
-  return Test.summary();
+  return Test.summary() + MemoryResourceTest<Data_t>();
 } // main()